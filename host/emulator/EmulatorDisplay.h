@@ -0,0 +1,44 @@
+#pragma once
+#include <HB9IIU_Platform.h>
+#include "TftEmulator.h"
+
+// The core's Display on the emulator, call for call the same as TftDisplay
+// (src/HB9IIU_ArduinoPlatform.h) so the cost counters match the firmware
+class EmulatorDisplay : public Display
+{
+public:
+  explicit EmulatorDisplay(TftEmulator &tft) : tft_(tft) {}
+
+  void startWrite() override { tft_.startWrite(); }
+  void endWrite() override { tft_.endWrite(); }
+
+  void pushImage(int32_t x, int32_t y, int32_t w, int32_t h, const uint16_t *data) override
+  {
+    tft_.pushImage(x, y, w, h, data);
+  }
+
+  void drawFastHLine(int32_t x, int32_t y, int32_t w, uint16_t color) override
+  {
+    tft_.drawFastHLine(x, y, w, color);
+  }
+
+  void fillRect(int32_t x, int32_t y, int32_t w, int32_t h, uint16_t color) override
+  {
+    tft_.fillRect(x, y, w, h, color);
+  }
+
+  void drawRect(int32_t x, int32_t y, int32_t w, int32_t h, uint16_t color) override
+  {
+    tft_.drawRect(x, y, w, h, color);
+  }
+
+  void drawString(const char *text, int32_t x, int32_t y, uint16_t fg, uint16_t bg) override
+  {
+    tft_.setTextDatum(TL_DATUM);
+    tft_.setTextColor(fg, bg);
+    tft_.drawString(text, x, y);
+  }
+
+private:
+  TftEmulator &tft_;
+};
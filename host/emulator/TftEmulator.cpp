@@ -0,0 +1,605 @@
+#include "TftEmulator.h"
+#include <stdio.h>
+
+#ifndef PROGMEM
+#define PROGMEM
+#endif
+
+// TFT_eSPI's GLCD font (5x7 in a 6x8 cell, one byte per column)
+namespace glcd
+{
+#include <Fonts/glcdfont.c>
+}
+
+// Panel commands (same values on the ST7796 and the ILI9488)
+static const uint8_t TFT_CASET = 0x2A;
+static const uint8_t TFT_PASET = 0x2B;
+static const uint8_t TFT_RAMWR = 0x2C;
+
+SpiCost &SpiCost::operator+=(const SpiCost &other)
+{
+  commands += other.commands;
+  windows += other.windows;
+  commandBytes += other.commandBytes;
+  pixelBytes += other.pixelBytes;
+  transactions += other.transactions;
+  addressSaved += other.addressSaved;
+  return *this;
+}
+
+SpiCost SpiCost::operator-(const SpiCost &other) const
+{
+  SpiCost d;
+  d.commands = commands - other.commands;
+  d.windows = windows - other.windows;
+  d.commandBytes = commandBytes - other.commandBytes;
+  d.pixelBytes = pixelBytes - other.pixelBytes;
+  d.transactions = transactions - other.transactions;
+  d.addressSaved = addressSaved - other.addressSaved;
+  return d;
+}
+
+TftEmulator::TftEmulator(PixelFormat format)
+    : format_(format),
+      fb_(WIDTH * HEIGHT, 0),
+      csLow_(false),
+      locked_(false),
+      winX0_(0), winY0_(0), winX1_(WIDTH - 1), winY1_(HEIGHT - 1),
+      curX_(0), curY_(0),
+      addrCol_(0xFFFF), addrRow_(0xFFFF),
+      ctlX0_(-1), ctlX1_(-1), ctlY0_(-1), ctlY1_(-1),
+      textDatum_(TL_DATUM),
+      textFg_(0xFFFF), textBg_(0xFFFF)
+{
+}
+
+// ===================== Bus =====================
+// CS goes low on the first transfer and stays low until endWrite()
+void TftEmulator::beginTransfer()
+{
+  if (!csLow_)
+  {
+    csLow_ = true;
+    cost_.transactions++;
+  }
+}
+
+void TftEmulator::endTransfer()
+{
+  if (!locked_)
+    csLow_ = false;
+}
+
+void TftEmulator::startWrite()
+{
+  beginTransfer();
+  locked_ = true;
+}
+
+void TftEmulator::endWrite()
+{
+  locked_ = false;
+  endTransfer();
+}
+
+void TftEmulator::command(uint32_t parameterBytes)
+{
+  cost_.commands++;
+  cost_.commandBytes += 1 + parameterBytes;
+}
+
+void TftEmulator::pixels(uint32_t count)
+{
+  cost_.pixelBytes += (uint64_t)count * (format_ == PixelFormat::Rgb666 ? 3 : 2);
+}
+
+// ===================== Window =====================
+void TftEmulator::setWindow(int32_t x0, int32_t y0, int32_t x1, int32_t y1)
+{
+  if (x0 != ctlX0_ || x1 != ctlX1_)
+  {
+    command(4); // CASET x0, x1
+    ctlX0_ = x0;
+    ctlX1_ = x1;
+  }
+  else
+    cost_.addressSaved += 5;
+
+  if (y0 != ctlY0_ || y1 != ctlY1_)
+  {
+    command(4); // PASET y0, y1
+    ctlY0_ = y0;
+    ctlY1_ = y1;
+  }
+  else
+    cost_.addressSaved += 5;
+
+  command(0); // RAMWR
+  cost_.windows++;
+
+  addrCol_ = x0 == x1 ? (uint32_t)x0 : 0xFFFF;
+  addrRow_ = y0 == y1 ? (uint32_t)y0 : 0xFFFF;
+
+  winX0_ = x0;
+  winY0_ = y0;
+  winX1_ = x1;
+  winY1_ = y1;
+  curX_ = x0;
+  curY_ = y0;
+}
+
+void TftEmulator::invalidateWindow()
+{
+  ctlX0_ = ctlX1_ = ctlY0_ = ctlY1_ = -1;
+  addrCol_ = 0xFFFF;
+  addrRow_ = 0xFFFF;
+}
+
+void TftEmulator::writeWindowPixel(uint16_t color)
+{
+  if (curX_ >= 0 && curX_ < WIDTH && curY_ >= 0 && curY_ < HEIGHT)
+    fb_[curY_ * WIDTH + curX_] = color;
+  if (++curX_ > winX1_)
+  {
+    curX_ = winX0_;
+    if (++curY_ > winY1_)
+      curY_ = winY0_;
+  }
+}
+
+void TftEmulator::pushColor(uint16_t color, uint32_t len)
+{
+  pixels(len);
+  while (len--)
+    writeWindowPixel(color);
+}
+
+// ===================== Primitives =====================
+void TftEmulator::fillScreen(uint32_t color)
+{
+  fillRect(0, 0, WIDTH, HEIGHT, color);
+}
+
+void TftEmulator::pushImage(int32_t x, int32_t y, int32_t w, int32_t h, const uint16_t *data)
+{
+  // PI_CLIP
+  int32_t dx = 0, dy = 0, dw = w, dh = h;
+  if (x < 0)
+  {
+    dw += x;
+    dx = -x;
+    x = 0;
+  }
+  if (y < 0)
+  {
+    dh += y;
+    dy = -y;
+    y = 0;
+  }
+  if (x + dw > WIDTH)
+    dw = WIDTH - x;
+  if (y + dh > HEIGHT)
+    dh = HEIGHT - y;
+  if (dw < 1 || dh < 1)
+    return;
+
+  beginTransfer();
+  setWindow(x, y, x + dw - 1, y + dh - 1);
+  pixels(dw * dh);
+  for (int32_t i = 0; i < dh; i++)
+    for (int32_t j = 0; j < dw; j++)
+      writeWindowPixel(data[(dy + i) * w + dx + j]);
+  endTransfer();
+}
+
+void TftEmulator::drawPixel(int32_t x, int32_t y, uint32_t color)
+{
+  if (x < 0 || y < 0 || x >= WIDTH || y >= HEIGHT)
+    return;
+
+  beginTransfer();
+  if (addrCol_ != (uint32_t)x)
+  {
+    command(4); // CASET x, x
+    addrCol_ = x;
+    ctlX0_ = ctlX1_ = x;
+  }
+  if (addrRow_ != (uint32_t)y)
+  {
+    command(4); // PASET y, y
+    addrRow_ = y;
+    ctlY0_ = ctlY1_ = y;
+  }
+  command(0); // RAMWR
+  pixels(1);
+  fb_[y * WIDTH + x] = (uint16_t)color;
+  endTransfer();
+}
+
+void TftEmulator::drawFastHLine(int32_t x, int32_t y, int32_t w, uint32_t color)
+{
+  if (y < 0 || x >= WIDTH || y >= HEIGHT)
+    return;
+  if (x < 0)
+  {
+    w += x;
+    x = 0;
+  }
+  if (x + w > WIDTH)
+    w = WIDTH - x;
+  if (w < 1)
+    return;
+
+  beginTransfer();
+  setWindow(x, y, x + w - 1, y);
+  pushColor((uint16_t)color, w);
+  endTransfer();
+}
+
+void TftEmulator::drawFastVLine(int32_t x, int32_t y, int32_t h, uint32_t color)
+{
+  if (x < 0 || x >= WIDTH || y >= HEIGHT)
+    return;
+  if (y < 0)
+  {
+    h += y;
+    y = 0;
+  }
+  if (y + h > HEIGHT)
+    h = HEIGHT - y;
+  if (h < 1)
+    return;
+
+  beginTransfer();
+  setWindow(x, y, x, y + h - 1);
+  pushColor((uint16_t)color, h);
+  endTransfer();
+}
+
+void TftEmulator::fillRect(int32_t x, int32_t y, int32_t w, int32_t h, uint32_t color)
+{
+  if (x >= WIDTH || y >= HEIGHT)
+    return;
+  if (x < 0)
+  {
+    w += x;
+    x = 0;
+  }
+  if (y < 0)
+  {
+    h += y;
+    y = 0;
+  }
+  if (x + w > WIDTH)
+    w = WIDTH - x;
+  if (y + h > HEIGHT)
+    h = HEIGHT - y;
+  if (w < 1 || h < 1)
+    return;
+
+  beginTransfer();
+  setWindow(x, y, x + w - 1, y + h - 1);
+  pushColor((uint16_t)color, w * h);
+  endTransfer();
+}
+
+void TftEmulator::drawRect(int32_t x, int32_t y, int32_t w, int32_t h, uint32_t color)
+{
+  beginTransfer();
+  const bool wasLocked = locked_;
+  locked_ = true; // one transaction for the four lines
+
+  drawFastHLine(x, y, w, color);
+  drawFastHLine(x, y + h - 1, w, color);
+  // Avoid drawing corner pixels twice
+  drawFastVLine(x, y + 1, h - 2, color);
+  drawFastVLine(x + w - 1, y + 1, h - 2, color);
+
+  locked_ = wasLocked;
+  endTransfer();
+}
+
+void TftEmulator::drawSpans(tft_span_t *spans, uint32_t n, uint32_t color)
+{
+  if (!n)
+    return;
+
+  for (uint32_t i = 1; i < n; i++)
+  {
+    tft_span_t s = spans[i];
+    uint32_t j = i;
+    while (j > 0 && (spans[j - 1].y > s.y || (spans[j - 1].y == s.y && spans[j - 1].x > s.x)))
+    {
+      spans[j] = spans[j - 1];
+      j--;
+    }
+    spans[j] = s;
+  }
+
+  beginTransfer();
+
+  int32_t lastX0 = -1, lastX1 = -1, lastY = -2;
+  int32_t pageY = -1;
+  for (uint32_t i = 0; i < n; i++)
+  {
+    int32_t x = spans[i].x, y = spans[i].y, w = spans[i].w;
+    if (y < 0 || x >= WIDTH || y >= HEIGHT)
+      continue;
+    if (x < 0)
+    {
+      w += x;
+      x = 0;
+    }
+    if (x + w > WIDTH)
+      w = WIDTH - x;
+    if (w < 1)
+      continue;
+
+    const int32_t x1 = x + w - 1;
+    const bool sameCols = x == lastX0 && x1 == lastX1;
+    if (!sameCols || y != lastY + 1)
+    {
+      if (!sameCols)
+        command(4); // CASET x, x1
+      if (y != pageY)
+      {
+        command(4); // PASET y, last row
+        pageY = y;
+      }
+      command(0); // RAMWR
+      cost_.windows++;
+    }
+
+    pixels(w);
+    for (int32_t k = 0; k < w; k++)
+      fb_[y * WIDTH + x + k] = (uint16_t)color;
+
+    lastX0 = x;
+    lastX1 = x1;
+    lastY = y;
+  }
+
+  invalidateWindow();
+  endTransfer();
+}
+
+void TftEmulator::pushMask(int32_t x, int32_t y, int32_t w, int32_t h, const uint8_t *mask, int32_t stride,
+                           uint16_t fg, const uint16_t *bg, int32_t bgStride)
+{
+  maskBlit(x, y, w, h, mask, stride, fg, bg, bgStride, 0);
+}
+
+void TftEmulator::pushMask(int32_t x, int32_t y, int32_t w, int32_t h, const uint8_t *mask, int32_t stride,
+                           uint16_t fg, uint16_t bgColor)
+{
+  maskBlit(x, y, w, h, mask, stride, fg, nullptr, 0, bgColor);
+}
+
+void TftEmulator::maskBlit(int32_t x, int32_t y, int32_t w, int32_t h, const uint8_t *mask, int32_t stride,
+                           uint16_t fg, const uint16_t *bg, int32_t bgStride, uint16_t bgColor)
+{
+  // PI_CLIP
+  int32_t dx = 0, dy = 0, dw = w, dh = h;
+  if (x < 0)
+  {
+    dw += x;
+    dx = -x;
+    x = 0;
+  }
+  if (y < 0)
+  {
+    dh += y;
+    dy = -y;
+    y = 0;
+  }
+  if (x + dw > WIDTH)
+    dw = WIDTH - x;
+  if (y + dh > HEIGHT)
+    dh = HEIGHT - y;
+  if (dw < 1 || dh < 1)
+    return;
+
+  beginTransfer();
+  setWindow(x, y, x + dw - 1, y + dh - 1);
+  pixels(dw * dh);
+  for (int32_t i = dy; i < dy + dh; i++)
+  {
+    for (int32_t j = dx; j < dx + dw; j++)
+    {
+      if (mask[i * stride + (j >> 3)] & (0x80 >> (j & 7)))
+        writeWindowPixel(fg);
+      else
+        writeWindowPixel(bg ? bg[i * bgStride + j] : bgColor);
+    }
+  }
+  endTransfer();
+}
+
+// ===================== Text (GLCD font, size 1) =====================
+void TftEmulator::setTextColor(uint16_t fg, uint16_t bg)
+{
+  textFg_ = fg;
+  textBg_ = bg;
+}
+
+void TftEmulator::drawChar(int32_t x, int32_t y, uint16_t c, uint32_t color, uint32_t bg)
+{
+  if (x >= WIDTH || y >= HEIGHT || x + 5 < 0 || y + 7 < 0)
+    return;
+  if (c > 255)
+    return;
+  if (c > 175)
+    c++; // not cp437
+
+  const bool fillbg = (bg != color);
+  const bool clip = x < 0 || x + 6 >= WIDTH || y < 0 || y + 8 >= HEIGHT;
+
+  if (fillbg && format_ == PixelFormat::Rgb666 && !clip)
+  {
+    // SPI_18BIT_DRIVER keeps the one 6x8 block
+    beginTransfer();
+    setWindow(x, y, x + 5, y + 7);
+    pixels(6 * 8);
+    for (int j = 0; j < 8; j++)
+    {
+      for (int k = 0; k < 5; k++)
+        writeWindowPixel((glcd::font[c * 5 + k] >> j) & 1 ? (uint16_t)color : (uint16_t)bg);
+      writeWindowPixel((uint16_t)bg);
+    }
+    endTransfer();
+    return;
+  }
+
+  if (fillbg && format_ == PixelFormat::Rgb565)
+  {
+    // the cell as a mask of rows
+    uint8_t rows[8] = {0};
+    for (int i = 0; i < 5; i++)
+      for (int j = 0; j < 8; j++)
+        if ((glcd::font[c * 5 + i] >> j) & 1)
+          rows[j] |= 0x80 >> i;
+    pushMask(x, y, 6, 8, rows, 1, (uint16_t)color, (uint16_t)bg);
+    return;
+  }
+
+  beginTransfer();
+  const bool wasLocked = locked_;
+  locked_ = true;
+
+  for (int i = 0; i < 6; i++)
+  {
+    uint8_t line = (i == 5) ? 0 : glcd::font[c * 5 + i];
+    for (int j = 0; j < 8; j++)
+    {
+      if (line & 1)
+      {
+        if (fillbg)
+          fillRect(x + i, y + j, 1, 1, color);
+        else
+          drawPixel(x + i, y + j, color);
+      }
+      else if (fillbg)
+      {
+        fillRect(x + i, y + j, 1, 1, bg);
+      }
+      line >>= 1;
+    }
+  }
+
+  locked_ = wasLocked;
+  endTransfer();
+}
+
+int16_t TftEmulator::drawString(const char *text, int32_t x, int32_t y)
+{
+  int16_t sumX = 0;
+  while (*text)
+  {
+    drawChar(x + sumX, y, (uint8_t)*text++, textFg_, textBg_);
+    sumX += 6;
+  }
+  return sumX;
+}
+
+// ===================== PNG =====================
+// Uncompressed ("stored") deflate: no zlib needed, ~450 KB per frame
+
+static uint32_t crc32Update(uint32_t crc, const uint8_t *data, size_t len)
+{
+  static uint32_t table[256];
+  if (!table[1])
+  {
+    for (uint32_t n = 0; n < 256; n++)
+    {
+      uint32_t c = n;
+      for (int k = 0; k < 8; k++)
+        c = (c & 1) ? 0xEDB88320u ^ (c >> 1) : c >> 1;
+      table[n] = c;
+    }
+  }
+  crc = ~crc;
+  while (len--)
+    crc = table[(crc ^ *data++) & 0xFF] ^ (crc >> 8);
+  return ~crc;
+}
+
+static void putBE32(std::vector<uint8_t> &out, uint32_t v)
+{
+  out.push_back((uint8_t)(v >> 24));
+  out.push_back((uint8_t)(v >> 16));
+  out.push_back((uint8_t)(v >> 8));
+  out.push_back((uint8_t)v);
+}
+
+static void writeChunk(FILE *f, const char *type, const std::vector<uint8_t> &data)
+{
+  std::vector<uint8_t> chunk;
+  putBE32(chunk, (uint32_t)data.size());
+  chunk.insert(chunk.end(), type, type + 4);
+  chunk.insert(chunk.end(), data.begin(), data.end());
+  const uint32_t crc = crc32Update(0, &chunk[4], chunk.size() - 4);
+  putBE32(chunk, crc);
+  fwrite(&chunk[0], 1, chunk.size(), f);
+}
+
+bool TftEmulator::writePng(const char *path) const
+{
+  // raw scanlines: filter byte 0, then RGB8
+  std::vector<uint8_t> raw;
+  raw.reserve(HEIGHT * (1 + WIDTH * 3));
+  for (int32_t y = 0; y < HEIGHT; y++)
+  {
+    raw.push_back(0);
+    for (int32_t x = 0; x < WIDTH; x++)
+    {
+      const uint16_t c = fb_[y * WIDTH + x];
+      const uint8_t r = (c >> 11) & 0x1F, g = (c >> 5) & 0x3F, b = c & 0x1F;
+      raw.push_back((uint8_t)((r << 3) | (r >> 2)));
+      raw.push_back((uint8_t)((g << 2) | (g >> 4)));
+      raw.push_back((uint8_t)((b << 3) | (b >> 2)));
+    }
+  }
+
+  // zlib stream of stored blocks
+  std::vector<uint8_t> z;
+  z.push_back(0x78);
+  z.push_back(0x01);
+  size_t pos = 0;
+  do
+  {
+    const size_t n = raw.size() - pos < 65535 ? raw.size() - pos : 65535;
+    z.push_back(pos + n == raw.size() ? 1 : 0); // BFINAL, BTYPE=00
+    z.push_back((uint8_t)n);
+    z.push_back((uint8_t)(n >> 8));
+    z.push_back((uint8_t)~n);
+    z.push_back((uint8_t)(~n >> 8));
+    z.insert(z.end(), raw.begin() + pos, raw.begin() + pos + n);
+    pos += n;
+  } while (pos < raw.size());
+  uint32_t a = 1, b = 0;
+  for (size_t i = 0; i < raw.size(); i++)
+  {
+    a = (a + raw[i]) % 65521;
+    b = (b + a) % 65521;
+  }
+  putBE32(z, (b << 16) | a);
+
+  std::vector<uint8_t> ihdr;
+  putBE32(ihdr, WIDTH);
+  putBE32(ihdr, HEIGHT);
+  ihdr.push_back(8); // bit depth
+  ihdr.push_back(2); // truecolor
+  ihdr.push_back(0);
+  ihdr.push_back(0);
+  ihdr.push_back(0);
+
+  FILE *f = fopen(path, "wb");
+  if (!f)
+    return false;
+  static const uint8_t signature[8] = {0x89, 'P', 'N', 'G', '\r', '\n', 0x1A, '\n'};
+  fwrite(signature, 1, sizeof(signature), f);
+  writeChunk(f, "IHDR", ihdr);
+  writeChunk(f, "IDAT", z);
+  writeChunk(f, "IEND", std::vector<uint8_t>());
+  return fclose(f) == 0;
+}
@@ -0,0 +1,135 @@
+#pragma once
+#include <stdint.h>
+#include <vector>
+
+// A headless stand-in for the part of TFT_eSPI the firmware uses. It draws
+// into a 480x320 RGB565 framebuffer and counts what the ESP32 build of
+// TFT_eSPI (TFT_eSPI.cpp, generic SPI path) would send on the wire for the
+// same calls:
+// - setWindow() is CASET + 4 bytes, PASET + 4 bytes, RAMWR, leaving out
+//   CASET / PASET when the controller already has those columns / rows
+// - drawPixel() only re-sends CASET / PASET when the column / row changed
+// - drawSpans() sends CASET / PASET only when the columns / first row change,
+//   and nothing at all for the next row with the same columns
+// - pushMask() expands a 1-bit mask over a background into one window
+// - drawChar() of the GLCD font is a 6x8 pushMask() when the background
+//   differs from the text color, and one drawPixel() per set pixel otherwise;
+//   on 18-bit panels a filled cell is one 6x8 block, or one fillRect() per
+//   pixel when it touches an edge
+// - pixels are 2 bytes on 16-bit panels (ST7796) and 3 on 18-bit panels
+//   (ILI9488, SPI_18BIT_DRIVER)
+
+#ifndef TL_DATUM
+#define TL_DATUM 0
+#endif
+
+// SPI_FREQUENCY of the platformio.ini environments
+static const uint32_t SPI_HZ_ST7796 = 55000000;  // cyd4_st7796
+static const uint32_t SPI_HZ_ILI9488 = 27000000; // ext_ili9488_*
+
+// Same as TFT_eSPI.h
+typedef struct
+{
+  int32_t x;
+  int32_t y;
+  int32_t w;
+} tft_span_t;
+
+enum class PixelFormat : uint8_t
+{
+  Rgb565, // 16-bit: ST7796
+  Rgb666, // 18-bit: ILI9488
+};
+
+struct SpiCost
+{
+  uint64_t commands = 0;     // bytes sent with DC low
+  uint64_t windows = 0;      // address windows opened (RAMWR restarting at a corner)
+  uint64_t commandBytes = 0; // commands and their parameters
+  uint64_t pixelBytes = 0;
+  uint64_t transactions = 0; // CS assertions
+  uint64_t addressSaved = 0; // CASET / PASET bytes setWindow() didn't resend (not in bytes())
+
+  uint64_t bytes() const { return commandBytes + pixelBytes; }
+
+  // Time the bytes take on the wire at `spiHz`, ignoring the gaps between
+  // transfers
+  double wireMicros(uint32_t spiHz) const { return bytes() * 8.0 * 1e6 / spiHz; }
+
+  SpiCost &operator+=(const SpiCost &other);
+  SpiCost operator-(const SpiCost &other) const;
+};
+
+class TftEmulator
+{
+public:
+  static const int32_t WIDTH = 480;
+  static const int32_t HEIGHT = 320;
+
+  explicit TftEmulator(PixelFormat format = PixelFormat::Rgb666);
+
+  int32_t width() const { return WIDTH; }
+  int32_t height() const { return HEIGHT; }
+  PixelFormat pixelFormat() const { return format_; }
+
+  // ===== TFT_eSPI subset =====
+  void startWrite();
+  void endWrite();
+
+  void setWindow(int32_t x0, int32_t y0, int32_t x1, int32_t y1);
+  void invalidateWindow();
+  void pushColor(uint16_t color, uint32_t len); // into the current window
+
+  void fillScreen(uint32_t color);
+  void pushImage(int32_t x, int32_t y, int32_t w, int32_t h, const uint16_t *data);
+  void drawPixel(int32_t x, int32_t y, uint32_t color);
+  void drawFastHLine(int32_t x, int32_t y, int32_t w, uint32_t color);
+  void drawFastVLine(int32_t x, int32_t y, int32_t h, uint32_t color);
+  void fillRect(int32_t x, int32_t y, int32_t w, int32_t h, uint32_t color);
+  void drawRect(int32_t x, int32_t y, int32_t w, int32_t h, uint32_t color);
+  void drawSpans(tft_span_t *spans, uint32_t n, uint32_t color);
+  void pushMask(int32_t x, int32_t y, int32_t w, int32_t h, const uint8_t *mask, int32_t stride,
+                uint16_t fg, const uint16_t *bg, int32_t bgStride);
+  void pushMask(int32_t x, int32_t y, int32_t w, int32_t h, const uint8_t *mask, int32_t stride,
+                uint16_t fg, uint16_t bgColor);
+
+  void setTextDatum(uint8_t datum) { textDatum_ = datum; } // only TL_DATUM is drawn
+  void setTextColor(uint16_t fg, uint16_t bg);
+  void drawChar(int32_t x, int32_t y, uint16_t c, uint32_t color, uint32_t bg);
+  int16_t drawString(const char *text, int32_t x, int32_t y);
+
+  // ===== Framebuffer =====
+  const uint16_t *framebuffer() const { return &fb_[0]; }
+  uint16_t readPixel(int32_t x, int32_t y) const { return fb_[y * WIDTH + x]; }
+
+  // Writes the framebuffer as a 24-bit PNG; false on I/O error
+  bool writePng(const char *path) const;
+
+  // ===== Cost =====
+  const SpiCost &cost() const { return cost_; }
+  void resetCost() { cost_ = SpiCost(); }
+
+private:
+  void beginTransfer();
+  void endTransfer();
+  void command(uint32_t parameterBytes);
+  void pixels(uint32_t count);
+  void writeWindowPixel(uint16_t color);
+  void maskBlit(int32_t x, int32_t y, int32_t w, int32_t h, const uint8_t *mask, int32_t stride,
+                uint16_t fg, const uint16_t *bg, int32_t bgStride, uint16_t bgColor);
+
+  PixelFormat format_;
+  std::vector<uint16_t> fb_;
+  SpiCost cost_;
+
+  bool csLow_;  // a transaction is open
+  bool locked_; // between startWrite() and endWrite()
+  int32_t winX0_, winY0_, winX1_, winY1_;
+  int32_t curX_, curY_;        // next pixel of the window
+  uint32_t addrCol_, addrRow_; // drawPixel()'s cache, 0xFFFF = unknown
+  int32_t ctlX0_, ctlX1_;      // columns held by the controller, -1 = unknown
+  int32_t ctlY0_, ctlY1_;      // rows held by the controller
+
+  uint8_t textDatum_;
+  uint16_t textFg_, textBg_;
+};
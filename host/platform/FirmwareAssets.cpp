@@ -0,0 +1,16 @@
+#include "FirmwareAssets.h"
+#include <Config.h>
+#include <background565.h>
+#include <plane32_360.h>
+
+RenderAssets firmwareAssets()
+{
+  RenderAssets assets = {bg565, plane32_masks, plane32_offset, plane32_stride};
+  return assets;
+}
+
+MapView firmwareMapView()
+{
+  MapView view = {HOME_LAT, HOME_LON, MAP_ZOOM, MAP_PX0, MAP_PY0};
+  return view;
+}
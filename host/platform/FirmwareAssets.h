@@ -0,0 +1,8 @@
+#pragma once
+#include <HB9IIU_Geo.h>
+#include <HB9IIU_Renderer.h>
+
+// The map, plane sprites and map view compiled into the firmware (src/),
+// so host runs draw and cost exactly what the device does
+RenderAssets firmwareAssets();
+MapView firmwareMapView();
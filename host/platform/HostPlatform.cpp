@@ -0,0 +1,79 @@
+#include "HostPlatform.h"
+#include <chrono>
+#include <fstream>
+#include <sstream>
+
+// ===================== Clocks =====================
+uint64_t steadyMicros()
+{
+  using namespace std::chrono;
+  return (uint64_t)duration_cast<microseconds>(steady_clock::now().time_since_epoch()).count();
+}
+
+SystemClock::SystemClock() : startUs_(steadyMicros()) {}
+
+uint32_t SystemClock::millis()
+{
+  return (uint32_t)((steadyMicros() - startUs_) / 1000);
+}
+
+// ===================== Display =====================
+void NullDisplay::pushImage(int32_t, int32_t, int32_t w, int32_t h, const uint16_t *)
+{
+  counters_.pushImage++;
+  counters_.pixels += (unsigned long)(w * h);
+}
+
+void NullDisplay::drawFastHLine(int32_t, int32_t, int32_t w, uint16_t)
+{
+  counters_.drawFastHLine++;
+  counters_.pixels += (unsigned long)w;
+}
+
+void NullDisplay::fillRect(int32_t, int32_t, int32_t w, int32_t h, uint16_t)
+{
+  counters_.fillRect++;
+  counters_.pixels += (unsigned long)(w * h);
+}
+
+void NullDisplay::drawRect(int32_t, int32_t, int32_t w, int32_t h, uint16_t)
+{
+  counters_.drawRect++;
+  counters_.pixels += (unsigned long)(2 * (w + h));
+}
+
+void NullDisplay::drawString(const char *, int32_t, int32_t, uint16_t, uint16_t)
+{
+  counters_.drawString++;
+}
+
+// ===================== Network =====================
+int FileFeed::get()
+{
+  std::ifstream in(path_.c_str(), std::ios::binary);
+  if (!in)
+    return 404;
+  std::ostringstream content;
+  content << in.rdbuf();
+  body_ = content.str();
+  return 200;
+}
+
+DeserializationError MemoryFeed::decode(double &now, AircraftSink &sink)
+{
+  return decodeAircraftJson(body_.data(), body_.size(), now, [&](const AircraftFields &a)
+                            { sink.onAircraft(a); });
+}
+
+// ===================== Storage =====================
+uint8_t MemoryStorage::getUChar(const char *key, uint8_t defaultValue)
+{
+  std::map<std::string, uint8_t>::const_iterator it = values_.find(key);
+  return it != values_.end() ? it->second : defaultValue;
+}
+
+void MemoryStorage::putUChar(const char *key, uint8_t value)
+{
+  values_[key] = value;
+  writes_++;
+}
@@ -0,0 +1,118 @@
+#pragma once
+#include <map>
+#include <string>
+#include <HB9IIU_Platform.h>
+
+// Desktop implementations of the core's platform interfaces
+
+// ===================== Clocks =====================
+// Monotonic wall-clock microseconds, for timing host code
+uint64_t steadyMicros();
+
+// Time only moves when told to: tests and replays run faster than real time
+class ManualClock : public Clock
+{
+public:
+  explicit ManualClock(uint32_t startMs = 0) : now_(startMs) {}
+
+  uint32_t millis() override { return now_; }
+
+  void set(uint32_t ms) { now_ = ms; }
+  void advance(uint32_t ms) { now_ += ms; }
+
+private:
+  uint32_t now_;
+};
+
+// Wall-clock milliseconds since construction
+class SystemClock : public Clock
+{
+public:
+  SystemClock();
+
+  uint32_t millis() override;
+
+private:
+  uint64_t startUs_;
+};
+
+// ===================== Display =====================
+// Discards the pixels, counts the calls
+class NullDisplay : public Display
+{
+public:
+  struct Counters
+  {
+    unsigned long pushImage = 0;
+    unsigned long drawFastHLine = 0;
+    unsigned long fillRect = 0;
+    unsigned long drawRect = 0;
+    unsigned long drawString = 0;
+    unsigned long pixels = 0; // pixels written by all the calls above (text excluded)
+  };
+
+  void startWrite() override {}
+  void endWrite() override {}
+
+  void pushImage(int32_t x, int32_t y, int32_t w, int32_t h, const uint16_t *data) override;
+  void drawFastHLine(int32_t x, int32_t y, int32_t w, uint16_t color) override;
+  void fillRect(int32_t x, int32_t y, int32_t w, int32_t h, uint16_t color) override;
+  void drawRect(int32_t x, int32_t y, int32_t w, int32_t h, uint16_t color) override;
+  void drawString(const char *text, int32_t x, int32_t y, uint16_t fg, uint16_t bg) override;
+
+  const Counters &counters() const { return counters_; }
+  void resetCounters() { counters_ = Counters(); }
+
+private:
+  Counters counters_;
+};
+
+// ===================== Network =====================
+// Serves the same aircraft.json body on every get()
+class MemoryFeed : public Network
+{
+public:
+  MemoryFeed() : httpCode_(200), connected_(true) {}
+
+  void setBody(const std::string &body) { body_ = body; }
+  void setHttpCode(int code) { httpCode_ = code; }
+  void setConnected(bool connected) { connected_ = connected; }
+
+  bool connected() override { return connected_; }
+  int get() override { return httpCode_; }
+  DeserializationError decode(double &now, AircraftSink &sink) override;
+  void end() override {}
+
+protected:
+  std::string body_;
+  int httpCode_;
+  bool connected_;
+};
+
+// Serves aircraft.json from a file, read again on every get()
+class FileFeed : public MemoryFeed
+{
+public:
+  explicit FileFeed(const std::string &path) : path_(path) {}
+
+  void setPath(const std::string &path) { path_ = path; }
+
+  int get() override; // 200, or 404 if the file can't be read
+
+private:
+  std::string path_;
+};
+
+// ===================== Storage =====================
+class MemoryStorage : public Storage
+{
+public:
+  uint8_t getUChar(const char *key, uint8_t defaultValue) override;
+  void putUChar(const char *key, uint8_t value) override;
+
+  unsigned long writes() const { return writes_; }
+
+private:
+  std::map<std::string, uint8_t> values_;
+  unsigned long writes_ = 0;
+};
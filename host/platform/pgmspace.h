@@ -0,0 +1,7 @@
+#pragma once
+
+// The firmware's image headers (src/*565.h, src/plane32_360.h) include
+// <pgmspace.h>; on the host their arrays are ordinary constants
+#ifndef PROGMEM
+#define PROGMEM
+#endif
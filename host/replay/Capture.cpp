@@ -0,0 +1,83 @@
+#include "Capture.h"
+
+static const char CAPTURE_MAGIC[] = "ADSBCAP 1\n";
+
+// ===================== Writer =====================
+bool CaptureWriter::open(const std::string &path)
+{
+  close();
+  f_ = fopen(path.c_str(), "wb");
+  if (!f_)
+    return false;
+  return fputs(CAPTURE_MAGIC, f_) >= 0;
+}
+
+bool CaptureWriter::append(uint32_t ms, const std::string &body)
+{
+  if (!f_)
+    return false;
+  if (fprintf(f_, "%lu %lu\n", (unsigned long)ms, (unsigned long)body.size()) < 0)
+    return false;
+  if (fwrite(body.data(), 1, body.size(), f_) != body.size())
+    return false;
+  return fputc('\n', f_) != EOF;
+}
+
+bool CaptureWriter::close()
+{
+  if (!f_)
+    return true;
+  const bool ok = fclose(f_) == 0;
+  f_ = nullptr;
+  return ok;
+}
+
+// ===================== Reader =====================
+bool CaptureReader::open(const std::string &path)
+{
+  close();
+  failed_ = false;
+  f_ = fopen(path.c_str(), "rb");
+  if (!f_)
+    return false;
+
+  char magic[sizeof(CAPTURE_MAGIC)] = {};
+  if (!fgets(magic, sizeof(magic), f_) || std::string(magic) != CAPTURE_MAGIC)
+  {
+    close();
+    return false;
+  }
+  return true;
+}
+
+bool CaptureReader::next(Snapshot &snap)
+{
+  if (!f_ || failed_)
+    return false;
+
+  unsigned long ms, length;
+  const int n = fscanf(f_, "%lu %lu", &ms, &length);
+  if (n == EOF)
+    return false; // clean end
+  if (n != 2 || fgetc(f_) != '\n')
+  {
+    failed_ = true;
+    return false;
+  }
+
+  snap.ms = (uint32_t)ms;
+  snap.body.resize(length);
+  if ((length && fread(&snap.body[0], 1, length, f_) != length) || fgetc(f_) != '\n')
+  {
+    failed_ = true;
+    return false;
+  }
+  return true;
+}
+
+void CaptureReader::close()
+{
+  if (f_)
+    fclose(f_);
+  f_ = nullptr;
+}
@@ -0,0 +1,56 @@
+#pragma once
+#include <stdint.h>
+#include <stdio.h>
+#include <string>
+
+// A recording of aircraft.json snapshots, each with the time it was taken.
+//
+// File layout (text header, then raw records, so a capture can be appended
+// to while it is recorded and inspected with `less`):
+//
+//   ADSBCAP 1\n
+//   <ms> <length>\n<length bytes of aircraft.json>\n
+//   <ms> <length>\n...
+//
+// <ms> is milliseconds since the first snapshot, non-decreasing.
+
+struct Snapshot
+{
+  uint32_t ms = 0;
+  std::string body;
+};
+
+class CaptureWriter
+{
+public:
+  CaptureWriter() : f_(nullptr) {}
+  ~CaptureWriter() { close(); }
+
+  // Creates (truncates) the file and writes the header
+  bool open(const std::string &path);
+  bool append(uint32_t ms, const std::string &body);
+  bool close();
+
+private:
+  FILE *f_;
+};
+
+class CaptureReader
+{
+public:
+  CaptureReader() : f_(nullptr), failed_(false) {}
+  ~CaptureReader() { close(); }
+
+  // False if the file can't be read or isn't a capture
+  bool open(const std::string &path);
+
+  // False at the end of the capture or on a damaged record (see failed())
+  bool next(Snapshot &snap);
+
+  bool failed() const { return failed_; }
+  void close();
+
+private:
+  FILE *f_;
+  bool failed_;
+};
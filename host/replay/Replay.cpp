@@ -0,0 +1,71 @@
+#include "Replay.h"
+
+// ===================== Feed =====================
+ReplayFeed::ReplayFeed(CaptureReader &capture, Clock &clock)
+    : capture_(capture), clock_(clock), served_(false)
+{
+  havePending_ = capture_.next(pending_);
+}
+
+int ReplayFeed::get()
+{
+  const uint32_t now = clock_.millis();
+  while (havePending_ && pending_.ms <= now)
+  {
+    body_.swap(pending_.body);
+    served_ = true;
+    havePending_ = capture_.next(pending_);
+  }
+  return served_ ? 200 : 404;
+}
+
+// ===================== Driver =====================
+ReplayDriver::ReplayDriver(CaptureReader &capture, PixelFormat format,
+                           const MapView &view, const RenderAssets &assets)
+    : clock_(0),
+      tft_(format),
+      display_(tft_),
+      feed_(capture, clock_),
+      core_(clock_, display_, feed_, view, assets)
+{
+  // What setup() leaves on the panel; not part of the per-frame cost
+  tft_.pushImage(0, 0, SW, SH, assets.background);
+  display_.startWrite();
+  core_.drawLegendBar();
+  display_.endWrite();
+  tft_.resetCost();
+}
+
+unsigned long ReplayDriver::run(const std::function<void(const ReplayFrame &)> &onFrame)
+{
+  unsigned long fetches = 0;
+  for (uint32_t t = 0;; t += FETCH_PERIOD_MS)
+  {
+    clock_.set(t);
+
+    ReplayFrame frame;
+    frame.index = fetches++;
+    frame.ms = t;
+    const SpiCost before = tft_.cost();
+
+    const uint64_t t0 = steadyMicros();
+    frame.ok = core_.fetchAndUpdateTracks(frame.report);
+    const uint64_t t1 = steadyMicros();
+    if (frame.ok)
+      core_.renderTracks();
+    frame.renderUs = steadyMicros() - t1;
+    frame.fetchUs = t1 - t0;
+
+    frame.spi = tft_.cost() - before;
+    frame.drawn = frame.ok ? core_.drawCount() : 0;
+    for (int i = 0; i < MAX_TRACKS; i++)
+      if (core_.tracks()[i].used)
+        frame.tracks++;
+
+    onFrame(frame);
+
+    if (feed_.finished())
+      break;
+  }
+  return fetches;
+}
@@ -0,0 +1,65 @@
+#pragma once
+#include <functional>
+#include <HB9IIU_Core.h>
+#include <HostPlatform.h>
+#include <EmulatorDisplay.h>
+#include "Capture.h"
+
+// Runs a capture through the same ingest -> track -> render pipeline as the
+// firmware's loop(): one fetch every FETCH_PERIOD_MS of virtual time, each
+// serving the newest snapshot taken by then, followed by renderTracks() if
+// it succeeded. The clock is a ManualClock, so TRACK_TTL_MS expiry happens
+// exactly as on the device while a day of traffic replays in seconds.
+
+// Serves the newest snapshot whose time is <= the clock on every get()
+class ReplayFeed : public MemoryFeed
+{
+public:
+  ReplayFeed(CaptureReader &capture, Clock &clock);
+
+  int get() override; // 200, or 404 before the first snapshot
+
+  // No snapshot is left to serve
+  bool finished() const { return !havePending_; }
+
+private:
+  CaptureReader &capture_;
+  Clock &clock_;
+  Snapshot pending_;
+  bool havePending_;
+  bool served_;
+};
+
+// One fetch of the replay
+struct ReplayFrame
+{
+  unsigned long index = 0;
+  uint32_t ms = 0; // virtual time since the first snapshot
+  bool ok = false; // fetch succeeded (and the frame was rendered)
+  FetchReport report;
+  int tracks = 0;        // slots in use after the frame
+  int drawn = 0;         // planes drawn
+  uint64_t fetchUs = 0;  // host time: decode + track updates
+  uint64_t renderUs = 0; // host time: renderTracks()
+  SpiCost spi;           // what the panel was sent during the frame
+};
+
+class ReplayDriver
+{
+public:
+  ReplayDriver(CaptureReader &capture, PixelFormat format,
+               const MapView &view, const RenderAssets &assets);
+
+  // Replays the whole capture; returns the number of fetches
+  unsigned long run(const std::function<void(const ReplayFrame &)> &onFrame);
+
+  const TftEmulator &tft() const { return tft_; }
+  const AdsbCore &core() const { return core_; }
+
+private:
+  ManualClock clock_;
+  TftEmulator tft_;
+  EmulatorDisplay display_;
+  ReplayFeed feed_;
+  AdsbCore core_;
+};
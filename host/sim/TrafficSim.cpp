@@ -0,0 +1,155 @@
+#include "TrafficSim.h"
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <HB9IIU_Geo.h>
+
+static const double M_PER_DEG_LAT = 111320.0;
+static const double KT_TO_MPS = 0.514444;
+
+static const char *const AIRLINES[] = {"SWR", "EZY", "EJU", "AFR", "DLH", "BAW", "KLM", "RYR", "AUA", "ITY"};
+
+TrafficSim::TrafficSim(const TrafficOptions &options, double startEpoch)
+    : opt_(options), rng_(options.seed), now_(startEpoch), nextId_(0), messages_(0)
+{
+  planes_.resize(opt_.aircraft > 0 ? opt_.aircraft : 0);
+  for (size_t i = 0; i < planes_.size(); i++)
+    spawn(planes_[i], false);
+}
+
+// ===================== Model =====================
+void TrafficSim::spawn(Plane &p, bool atEdge)
+{
+  const uint32_t id = nextId_++;
+  snprintf(p.hex, sizeof(p.hex), "%06x", (unsigned)(0x400000 + id % 0x3FFFFF));
+  snprintf(p.flight, sizeof(p.flight), "%s%-5u", AIRLINES[id % 10], (unsigned)(id % 9000 + 100));
+
+  // New arrivals enter at the edge, heading roughly inwards; the initial
+  // population is spread evenly over the disk
+  const double brg = uniform(0, 360);
+  const double distKm = atEdge ? opt_.radiusKm * 0.99 : opt_.radiusKm * sqrt(uniform(0, 1));
+  p.lat = opt_.homeLat + distKm * 1000 * cos(deg2rad(brg)) / M_PER_DEG_LAT;
+  p.lon = opt_.homeLon + distKm * 1000 * sin(deg2rad(brg)) / (M_PER_DEG_LAT * cos(deg2rad(opt_.homeLat)));
+  p.trackDeg = atEdge ? fmod(brg + 180 + uniform(-60, 60) + 360, 360) : uniform(0, 360);
+  p.turnDps = 0;
+
+  p.ground = chance(opt_.onGround);
+  p.altFt = p.ground ? 0 : uniform(2000, 41000);
+  p.targetAltFt = p.altFt;
+  p.vrateFpm = 0;
+  p.gsKt = p.ground ? uniform(0, 25) : 150 + p.altFt / 41000 * 330 + uniform(-20, 20);
+
+  p.hasFlight = !chance(opt_.missingFlight);
+  p.hasPosition = !chance(opt_.missingPosition);
+  p.hasTrack = !chance(opt_.missingTrack);
+  p.hasAlt = !chance(opt_.missingAlt);
+
+  p.repLat = p.lat;
+  p.repLon = p.lon;
+  p.lastPos = now_ - uniform(0, opt_.posIntervalS);
+  p.nextPos = now_ + std::exponential_distribution<double>(1.0 / opt_.posIntervalS)(rng_);
+  p.lastMsg = now_;
+}
+
+void TrafficSim::step(Plane &p, double dt)
+{
+  // Gentle turns now and then, climbs / descents to a new level
+  if (chance(dt / 60))
+    p.turnDps = uniform(-1.5, 1.5);
+  else if (chance(dt / 20))
+    p.turnDps = 0;
+  if (!p.ground && chance(dt / 300))
+  {
+    p.targetAltFt = uniform(2000, 41000);
+    p.vrateFpm = p.targetAltFt > p.altFt ? uniform(800, 2500) : -uniform(800, 2500);
+  }
+
+  p.trackDeg = fmod(p.trackDeg + p.turnDps * dt + 360, 360);
+
+  const double d = p.gsKt * KT_TO_MPS * dt;
+  p.lat += d * cos(deg2rad(p.trackDeg)) / M_PER_DEG_LAT;
+  p.lon += d * sin(deg2rad(p.trackDeg)) / (M_PER_DEG_LAT * cos(deg2rad(p.lat)));
+
+  if (p.vrateFpm != 0)
+  {
+    p.altFt += p.vrateFpm * dt / 60;
+    if ((p.vrateFpm > 0) == (p.altFt >= p.targetAltFt))
+    {
+      p.altFt = p.targetAltFt;
+      p.vrateFpm = 0;
+    }
+  }
+
+  if (haversine_km(opt_.homeLat, opt_.homeLon, p.lat, p.lon) > opt_.radiusKm)
+  {
+    spawn(p, true);
+    return;
+  }
+
+  // Position messages
+  if (now_ >= p.nextPos)
+  {
+    std::normal_distribution<double> noise(0, opt_.posNoiseM > 0 ? opt_.posNoiseM : 1e-9);
+    p.repLat = p.lat + noise(rng_) / M_PER_DEG_LAT;
+    p.repLon = p.lon + noise(rng_) / (M_PER_DEG_LAT * cos(deg2rad(p.lat)));
+    p.lastPos = now_;
+    p.nextPos = now_ + std::exponential_distribution<double>(1.0 / opt_.posIntervalS)(rng_);
+    messages_++;
+  }
+  // Other messages (identity, velocity, altitude) a few times a second
+  if (chance(dt * 4 > 1 ? 1 : dt * 4))
+  {
+    p.lastMsg = now_;
+    messages_++;
+  }
+}
+
+void TrafficSim::advance(double seconds)
+{
+  // Steps of at most 1 s so turns and message timing stay smooth
+  while (seconds > 0)
+  {
+    const double dt = seconds < 1 ? seconds : 1;
+    now_ += dt;
+    seconds -= dt;
+    for (size_t i = 0; i < planes_.size(); i++)
+      step(planes_[i], dt);
+  }
+}
+
+// ===================== aircraft.json =====================
+void TrafficSim::aircraftJson(std::string &out)
+{
+  char buf[512];
+  snprintf(buf, sizeof(buf), "{ \"now\" : %.1f,\n  \"messages\" : %lu,\n  \"aircraft\" : [\n", now_, messages_);
+  out += buf;
+
+  std::normal_distribution<double> altNoise(0, opt_.altNoiseFt > 0 ? opt_.altNoiseFt : 1e-9);
+  for (size_t i = 0; i < planes_.size(); i++)
+  {
+    const Plane &p = planes_[i];
+    int n = snprintf(buf, sizeof(buf), "%s{\"hex\":\"%s\",\"type\":\"adsb_icao\"", i ? ",\n" : "", p.hex);
+
+    if (p.hasFlight)
+      n += snprintf(buf + n, sizeof(buf) - n, ",\"flight\":\"%-8s\"", p.flight);
+    if (p.hasAlt)
+    {
+      if (p.ground)
+        n += snprintf(buf + n, sizeof(buf) - n, ",\"alt_baro\":\"ground\"");
+      else
+        n += snprintf(buf + n, sizeof(buf) - n, ",\"alt_baro\":%d,\"alt_geom\":%d,\"baro_rate\":%d",
+                      (int)(p.altFt + altNoise(rng_)) / 25 * 25, (int)p.altFt / 25 * 25 + 300, (int)p.vrateFpm / 64 * 64);
+    }
+    n += snprintf(buf + n, sizeof(buf) - n, ",\"gs\":%.1f", p.gsKt);
+    if (p.hasTrack)
+      n += snprintf(buf + n, sizeof(buf) - n, ",\"track\":%.2f", p.trackDeg);
+    n += snprintf(buf + n, sizeof(buf) - n, ",\"squawk\":\"%04o\",\"category\":\"A3\"", (unsigned)(strtoul(p.hex, nullptr, 16) % 4096));
+    if (p.hasPosition)
+      n += snprintf(buf + n, sizeof(buf) - n, ",\"lat\":%.6f,\"lon\":%.6f,\"nic\":8,\"rc\":186,\"seen_pos\":%.1f",
+                    p.repLat, p.repLon, now_ - p.lastPos);
+    n += snprintf(buf + n, sizeof(buf) - n, ",\"version\":2,\"mlat\":[],\"tisb\":[],\"messages\":%u,\"seen\":%.1f,\"rssi\":%.1f}",
+                  (unsigned)(messages_ % 100000), now_ - p.lastMsg, -20.0 - (i % 17));
+    out += buf;
+  }
+  out += "\n  ]\n}\n";
+}
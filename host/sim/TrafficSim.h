@@ -0,0 +1,74 @@
+#pragma once
+#include <stdint.h>
+#include <random>
+#include <string>
+#include <vector>
+
+// Synthetic air traffic around a home position, rendered as a tar1090
+// aircraft.json. Aircraft fly straight legs with gentle turns, climbs and
+// descents, and are replaced by new arrivals when they leave the area.
+// Positions are only refreshed when a simulated position message arrives,
+// so seen_pos behaves like a real receiver's.
+
+struct TrafficOptions
+{
+  int aircraft = 200;
+  double homeLat = 46.47171849999999; // Config.h HOME_LAT
+  double homeLon = 6.476770899999999; // Config.h HOME_LON
+  double radiusKm = 400;              // aircraft leaving this circle are replaced
+
+  double posIntervalS = 1.0; // mean time between position messages
+  double posNoiseM = 0;      // sigma of the reported position
+  double altNoiseFt = 0;     // sigma of the reported altitude
+
+  // Share of aircraft that never report the field
+  double missingFlight = 0.10;
+  double missingPosition = 0.05; // Mode-S only
+  double missingTrack = 0.03;
+  double missingAlt = 0.02;
+  double onGround = 0.03; // "alt_baro":"ground"
+
+  uint32_t seed = 1;
+};
+
+class TrafficSim
+{
+public:
+  explicit TrafficSim(const TrafficOptions &options, double startEpoch = 1718000000.0);
+
+  // Moves the simulation forward
+  void advance(double seconds);
+
+  double now() const { return now_; }
+  int count() const { return (int)planes_.size(); }
+
+  // The current state as tar1090 would serve it (appends to `out`)
+  void aircraftJson(std::string &out);
+
+private:
+  struct Plane
+  {
+    char hex[7];
+    char flight[9];
+    double lat, lon;       // true position
+    double repLat, repLon; // position of the last position message
+    double altFt, targetAltFt, vrateFpm;
+    double gsKt, trackDeg, turnDps;
+    double lastPos, nextPos; // epochs of position messages
+    double lastMsg;
+    bool hasFlight, hasPosition, hasTrack, hasAlt, ground;
+  };
+
+  void spawn(Plane &p, bool atEdge);
+  void step(Plane &p, double dt);
+
+  double uniform(double lo, double hi) { return std::uniform_real_distribution<double>(lo, hi)(rng_); }
+  bool chance(double p) { return uniform(0, 1) < p; }
+
+  TrafficOptions opt_;
+  std::mt19937 rng_;
+  std::vector<Plane> planes_;
+  double now_;
+  uint32_t nextId_;
+  unsigned long messages_;
+};
@@ -0,0 +1,134 @@
+#include <catch.hpp>
+#include <HB9IIU_Core.h>
+#include <HostPlatform.h>
+#include <string>
+#include "TestView.h"
+
+// A blank background and a plane that is a 32x32 square at every heading
+static uint16_t background[SW * SH];
+static uint8_t planeMask[PW / 8 * PH];
+static uint16_t planeOffsets[360];
+
+static RenderAssets testAssets()
+{
+  memset(planeMask, 0xFF, sizeof(planeMask));
+  RenderAssets assets = {background, planeMask, planeOffsets, PW / 8};
+  return assets;
+}
+
+static std::string aircraftJson(const char *aircraft)
+{
+  return std::string("{\"now\":1718000000.5,\"messages\":42,\"aircraft\":[") + aircraft + "]}";
+}
+
+TEST_CASE("AdsbCore")
+{
+  ManualClock clock(100000);
+  NullDisplay display;
+  MemoryFeed feed;
+  AdsbCore core(clock, display, feed, TEST_VIEW, testAssets());
+  FetchReport report;
+
+  feed.setBody(aircraftJson(
+      "{\"hex\":\"4b1234\",\"flight\":\"SWR12   \",\"alt_baro\":35000,\"track\":90.0,"
+      "\"lat\":46.47,\"lon\":6.48,\"seen_pos\":0.5,\"seen\":0.1},"
+      "{\"hex\":\"4b5678\",\"lat\":46.6,\"lon\":6.3,\"seen_pos\":1.2,\"seen\":0.2},"
+      "{\"hex\":\"3c0001\",\"alt_baro\":\"ground\",\"seen\":2.0}"));
+
+  SECTION("fetchAndUpdateTracks()")
+  {
+    REQUIRE(core.fetchAndUpdateTracks(report));
+    REQUIRE(report.httpCode == 200);
+    REQUIRE(report.now == 1718000000.5);
+    REQUIRE(report.stats.totalRaw == 3);
+    REQUIRE(report.stats.totalShown == 3);
+    REQUIRE(report.stats.withPos == 2);
+    REQUIRE(report.stats.updated == 2);
+    REQUIRE(core.lastStats().updated == 2);
+
+    const int idx = core.tracks().findTrackByHex("4b1234");
+    REQUIRE(idx >= 0);
+    REQUIRE(core.tracks()[idx].headingDeg == 90);
+    REQUIRE(core.tracks()[idx].lastUpdateMs == 100000);
+  }
+
+  SECTION("HTTP error")
+  {
+    feed.setHttpCode(503);
+    REQUIRE_FALSE(core.fetchAndUpdateTracks(report));
+    REQUIRE(report.httpCode == 503);
+  }
+
+  SECTION("invalid JSON keeps the previous counters")
+  {
+    REQUIRE(core.fetchAndUpdateTracks(report));
+    feed.setBody("{\"now\":1,\"aircraft\":[{\"hex\":");
+    REQUIRE_FALSE(core.fetchAndUpdateTracks(report));
+    REQUIRE(report.error == DeserializationError::IncompleteInput);
+    REQUIRE(core.lastStats().totalRaw == 3);
+  }
+
+  SECTION("truncated JSON keeps the aircraft decoded before the error")
+  {
+    REQUIRE(core.fetchAndUpdateTracks(report));
+    clock.advance(1000);
+    feed.setBody("{\"now\":1718000001.5,\"aircraft\":["
+                 "{\"hex\":\"4b1234\",\"track\":180.0,\"lat\":46.48,\"lon\":6.49,\"seen_pos\":0.5,\"seen\":0.1},"
+                 "{\"hex\":\"4b5678\",\"track\":270.0,\"lat\":46.61,\"lon\":6.31,\"seen_pos\"");
+    REQUIRE_FALSE(core.fetchAndUpdateTracks(report));
+    REQUIRE(report.error == DeserializationError::IncompleteInput);
+    REQUIRE(report.stats.updated == 1);
+    REQUIRE(core.lastStats().updated == 2);
+
+    // The complete object was applied as it was parsed...
+    const int first = core.tracks().findTrackByHex("4b1234");
+    REQUIRE(first >= 0);
+    REQUIRE(core.tracks()[first].headingDeg == 180);
+    REQUIRE(core.tracks()[first].lastUpdateMs == 101000);
+
+    // ...the cut one was not
+    const int second = core.tracks().findTrackByHex("4b5678");
+    REQUIRE(second >= 0);
+    REQUIRE(core.tracks()[second].lastUpdateMs == 100000);
+  }
+
+  SECTION("not connected")
+  {
+    feed.setConnected(false);
+    REQUIRE_FALSE(core.fetchAndUpdateTracks(report));
+    REQUIRE(report.httpCode == 0);
+  }
+
+  SECTION("renderTracks()")
+  {
+    REQUIRE(core.fetchAndUpdateTracks(report));
+    core.renderTracks();
+
+    REQUIRE(core.drawCount() == 2);
+    // one composited 32x32 band per plane, and the bottom bar a row at a
+    // time (NullDisplay lends no band)
+    REQUIRE(display.counters().pushImage == 2 + BOTTOM_H);
+    REQUIRE(display.counters().drawString == 0);
+    REQUIRE(display.counters().drawFastHLine == 0);
+
+    SECTION("nothing moved: the planes are redrawn in place")
+    {
+      display.resetCounters();
+      core.renderTracks();
+      REQUIRE(display.counters().pushImage == 2);
+    }
+
+    SECTION("tracks expire after TRACK_TTL_MS")
+    {
+      clock.advance(TRACK_TTL_MS + 1);
+      display.resetCounters();
+      core.renderTracks();
+
+      REQUIRE(core.drawCount() == 0);
+      REQUIRE(core.tracks().findTrackByHex("4b1234") < 0);
+      // erased, and two runs of changed text in the bar (8 rows each)
+      REQUIRE(display.counters().pushImage == 2 + 2 * 8);
+      REQUIRE(display.counters().drawFastHLine == 0);
+    }
+  }
+}
@@ -0,0 +1,18 @@
+#pragma once
+#include <stdio.h>
+#include <string.h>
+#include <HB9IIU_AircraftDecoder.h>
+
+// A decoded aircraft with a position, `seen_pos` 1 s ago
+inline AircraftFields makeAircraft(const char *hex, double lat, double lon)
+{
+  AircraftFields a;
+  memset(&a, 0, sizeof(a));
+  snprintf(a.hex, sizeof(a.hex), "%s", hex);
+  a.lat_e6 = (int32_t)(lat * 1e6);
+  a.lon_e6 = (int32_t)(lon * 1e6);
+  a.seen_d10 = 10;
+  a.seen_pos_d10 = 10;
+  a.present = AF_HEX | AF_LAT | AF_LON | AF_SEEN | AF_SEEN_POS;
+  return a;
+}
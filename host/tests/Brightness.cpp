@@ -0,0 +1,67 @@
+#include <catch.hpp>
+#include <HB9IIU_Brightness.h>
+#include <HostPlatform.h>
+
+TEST_CASE("BrightnessSetting")
+{
+  ManualClock clock(1000);
+  MemoryStorage storage;
+  BrightnessSetting bl(storage, clock, 50);
+
+  SECTION("load() falls back to the default")
+  {
+    REQUIRE(bl.load() == 50);
+  }
+
+  SECTION("load() returns the saved level")
+  {
+    storage.putUChar("bl", 80);
+    REQUIRE(bl.load() == 80);
+  }
+
+  SECTION("steps at most every BL_STEP_MS while touched")
+  {
+    bl.load();
+    REQUIRE(bl.touch(true));
+    REQUIRE(bl.percent() == 55);
+    clock.advance(BrightnessSetting::BL_STEP_MS - 1);
+    REQUIRE_FALSE(bl.touch(true));
+    clock.advance(1);
+    REQUIRE(bl.touch(false));
+    REQUIRE(bl.percent() == 50);
+  }
+
+  SECTION("clamps to 0..100")
+  {
+    storage.putUChar("bl", 98);
+    bl.load();
+    REQUIRE(bl.touch(true));
+    REQUIRE(bl.percent() == 100);
+    clock.advance(BrightnessSetting::BL_STEP_MS);
+    REQUIRE_FALSE(bl.touch(true));
+  }
+
+  SECTION("saves once the panel is idle")
+  {
+    bl.load();
+    bl.touch(true);
+    clock.advance(BrightnessSetting::BL_SAVE_IDLE_MS - 1);
+    REQUIRE_FALSE(bl.saveIfIdle());
+    clock.advance(1);
+    REQUIRE(bl.saveIfIdle());
+    REQUIRE(storage.getUChar("bl", 0) == 55);
+    REQUIRE_FALSE(bl.saveIfIdle());
+    REQUIRE(storage.writes() == 1);
+  }
+
+  SECTION("doesn't write a level that is already saved")
+  {
+    bl.load();
+    bl.touch(true);
+    clock.advance(BrightnessSetting::BL_STEP_MS);
+    bl.touch(false);
+    clock.advance(BrightnessSetting::BL_SAVE_IDLE_MS);
+    REQUIRE_FALSE(bl.saveIfIdle());
+    REQUIRE(storage.writes() == 0);
+  }
+}
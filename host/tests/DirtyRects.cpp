@@ -0,0 +1,91 @@
+#include <catch.hpp>
+#include <HB9IIU_DirtyRects.h>
+#include "TestView.h"
+
+TEST_CASE("rectClampToScreen()")
+{
+  Rect r = rectClampToScreen({-10, -5, 32, 32});
+  REQUIRE(r.x == 0);
+  REQUIRE(r.y == 0);
+  REQUIRE(r.w == 22);
+  REQUIRE(r.h == 27);
+
+  r = rectClampToScreen({SW - 8, SH - 4, 32, 32});
+  REQUIRE(r.w == 8);
+  REQUIRE(r.h == 4);
+
+  r = rectClampToScreen({SW + 10, 0, 32, 32});
+  REQUIRE(r.w == 0);
+}
+
+TEST_CASE("planDirtyRects()")
+{
+  TrackStore tracks(TEST_VIEW);
+  Rect dirty[MAX_DIRTY];
+
+  auto place = [&](int idx, int cx, int cy)
+  {
+    tracks[idx].used = true;
+    tracks[idx].cx = cx;
+    tracks[idx].cy = cy;
+  };
+
+  auto drawnAt = [&](int idx, int x, int y)
+  {
+    tracks[idx].drawn = true;
+    tracks[idx].oldDrawX = x;
+    tracks[idx].oldDrawY = y;
+  };
+
+  SECTION("a new plane dirties its rect")
+  {
+    place(0, 100, 100);
+    const int list[] = {0};
+
+    REQUIRE(planDirtyRects(tracks, list, 1, dirty) == 1);
+    REQUIRE(dirty[0].x == 84);
+    REQUIRE(dirty[0].y == 84);
+    REQUIRE(dirty[0].w == PW);
+    REQUIRE(dirty[0].h == PH);
+  }
+
+  SECTION("a plane that moved a little dirties the union of its rects")
+  {
+    place(0, 100, 100);
+    drawnAt(0, 80, 84);
+    const int list[] = {0};
+
+    REQUIRE(planDirtyRects(tracks, list, 1, dirty) == 1);
+    REQUIRE(dirty[0].x == 80);
+    REQUIRE(dirty[0].w == PW + 4);
+  }
+
+  SECTION("a plane that jumped dirties both rects")
+  {
+    place(0, 300, 100);
+    drawnAt(0, 84, 84);
+    const int list[] = {0};
+
+    REQUIRE(planDirtyRects(tracks, list, 1, dirty) == 2);
+  }
+
+  SECTION("a plane removed from the list dirties its old rect")
+  {
+    place(1, 200, 200);
+    drawnAt(1, 184, 184);
+
+    REQUIRE(planDirtyRects(tracks, nullptr, 0, dirty) == 1);
+    REQUIRE(dirty[0].x == 184);
+    REQUIRE_FALSE(tracks[1].drawn);
+  }
+
+  SECTION("rects are clamped to the screen")
+  {
+    place(0, 4, 100);
+    const int list[] = {0};
+
+    REQUIRE(planDirtyRects(tracks, list, 1, dirty) == 1);
+    REQUIRE(dirty[0].x == 0);
+    REQUIRE(dirty[0].w == 20);
+  }
+}
@@ -0,0 +1,333 @@
+#include <catch.hpp>
+#include <TFT_eSPI.h>
+#include <random>
+#include <vector>
+
+// The same drawing with the TFT_eSPI primitives and through a display list
+// must put the same bytes, with the same DC levels, on the wire. With DMA the
+// fake ESP-IDF driver only sends a transaction when its result is taken, so a
+// half of the buffer or a transaction slot reused too early changes the bytes.
+
+namespace
+{
+
+struct Op
+{
+  int kind; // 0 rows of pixels, 1 fill, 2 column run, 3 image
+  int x, y, w, h;
+  uint16_t color;
+};
+
+std::vector<Op> randomOps(uint32_t seed, int n)
+{
+  std::mt19937 rng(seed);
+  std::vector<Op> ops;
+  for (int i = 0; i < n; i++)
+  {
+    Op op;
+    op.kind = rng() % 4;
+    op.x = rng() % 250;
+    op.y = rng() % 400;
+    op.w = 1 + rng() % 70;
+    op.h = 1 + rng() % 4;
+    op.color = (uint16_t)rng();
+    ops.push_back(op);
+  }
+  return ops;
+}
+
+std::vector<uint16_t> imagePixels()
+{
+  std::mt19937 rng(7);
+  std::vector<uint16_t> img(70 * 4);
+  for (auto &p : img)
+    p = (uint16_t)rng();
+  return img;
+}
+
+// What dmaWait() does on the ESP32 (DMA_BUSY_CHECK is empty on the host)
+void drainDma(TFT_eSPI &tft)
+{
+  spi_transaction_t *t;
+  while (tft.spiBusyCheck)
+  {
+    spi_device_get_trans_result(dmaHAL, &t, portMAX_DELAY);
+    tft.spiBusyCheck--;
+  }
+}
+
+std::vector<uint16_t> drawDirect(const std::vector<Op> &ops, bool swap)
+{
+  const std::vector<uint16_t> img = imagePixels();
+  TFT_eSPI tft;
+  tft.init();
+  tft.setSwapBytes(swap);
+  spiWire().reset();
+
+  tft.startWrite();
+  for (const Op &op : ops)
+  {
+    switch (op.kind)
+    {
+    case 0:
+      for (int r = 0; r < op.h; r++)
+      {
+        tft.setWindow(op.x, op.y + r, op.x + op.w - 1, op.y + r);
+        tft.pushPixels(img.data() + r * op.w, op.w);
+      }
+      break;
+    case 1:
+      tft.setWindow(op.x, op.y, op.x + op.w - 1, op.y + op.h - 1);
+      tft.pushBlock(op.color, op.w * op.h);
+      break;
+    case 2:
+      tft.setWindow(op.x, op.y, op.x, tft.height() - 1);
+      tft.pushBlock(op.color, 3);
+      break;
+    default:
+      tft.setWindow(op.x, op.y, op.x + op.w - 1, op.y + op.h - 1);
+      tft.pushPixels(img.data(), op.w * op.h);
+      break;
+    }
+  }
+  tft.endWrite();
+  return spiWire().bytes();
+}
+
+std::vector<uint16_t> drawListed(const std::vector<Op> &ops, bool swap, bool dma, uint32_t bytes)
+{
+  const std::vector<uint16_t> img = imagePixels();
+  TFT_eSPI tft;
+  tft.init();
+  tft.setSwapBytes(swap);
+  tft.DMA_Enabled = dma;
+  spiWire().reset();
+
+  // Off by one, dlBegin() aligns the start
+  std::vector<uint8_t> buffer(bytes + 1);
+  // dlImage() sends from them in place (and may swap them)
+  std::vector<std::vector<uint16_t>> images;
+  images.reserve(ops.size());
+
+  tft.startWrite();
+  REQUIRE(tft.dlBegin(buffer.data() + 1, bytes));
+  for (const Op &op : ops)
+  {
+    switch (op.kind)
+    {
+    case 0:
+      for (int r = 0; r < op.h; r++)
+      {
+        tft.dlWindow(op.x, op.y + r, op.x + op.w - 1, op.y + r);
+        tft.dlPixels(img.data() + r * op.w, op.w);
+      }
+      break;
+    case 1:
+      tft.dlWindow(op.x, op.y, op.x + op.w - 1, op.y + op.h - 1);
+      tft.dlFill(op.color, op.w * op.h);
+      break;
+    case 2:
+      tft.dlWindow(op.x, op.y, op.x, tft.height() - 1);
+      tft.dlFill(op.color, 3);
+      break;
+    default:
+      images.push_back(img);
+      tft.dlWindow(op.x, op.y, op.x + op.w - 1, op.y + op.h - 1);
+      tft.dlImage(images.back().data(), op.w * op.h, nullptr, nullptr);
+      break;
+    }
+    REQUIRE(spiQueued() <= TFT_DMA_QUEUE);
+    REQUIRE(spiQueued() == tft.spiBusyCheck);
+  }
+  tft.dlEnd();
+  drainDma(tft);
+  tft.endWrite();
+  return spiWire().bytes();
+}
+
+} // namespace
+
+TEST_CASE("Display list")
+{
+  const std::vector<Op> ops = randomOps(1, 300);
+
+  SECTION("sends what the primitives send, with the SPI writes")
+  {
+    for (bool swap : {false, true})
+    {
+      const std::vector<uint16_t> direct = drawDirect(ops, swap);
+      for (uint32_t bytes : {600u, 2000u, 8192u})
+      {
+        INFO("swap " << swap << ", buffer " << bytes);
+        REQUIRE(drawListed(ops, swap, false, bytes) == direct);
+      }
+    }
+  }
+
+  SECTION("sends what the primitives send, as DMA transactions")
+  {
+    for (bool swap : {false, true})
+    {
+      const std::vector<uint16_t> direct = drawDirect(ops, swap);
+      for (uint32_t bytes : {600u, 2000u, 8192u})
+      {
+        INFO("swap " << swap << ", buffer " << bytes);
+        REQUIRE(drawListed(ops, swap, true, bytes) == direct);
+      }
+    }
+  }
+
+  SECTION("a full queue waits for the oldest transaction")
+  {
+    // Each window is three commands and two parameter blocks: far more
+    // transactions than the queue holds, from both halves of the buffer
+    TFT_eSPI tft;
+    tft.init();
+    tft.DMA_Enabled = true;
+    spiWire().reset();
+
+    static uint32_t buffer[1024];
+    tft.startWrite();
+    REQUIRE(tft.dlBegin(buffer, sizeof buffer));
+    for (int i = 0; i < 100; i++)
+    {
+      tft.dlWindow(i, i, i + 10, i + 10);
+      tft.dlFill(0xF800, 11 * 11);
+      REQUIRE(tft.spiBusyCheck <= TFT_DMA_QUEUE);
+    }
+    tft.dlEnd();
+    drainDma(tft);
+    tft.endWrite();
+
+    REQUIRE(spiWire().commands() == 300);
+    REQUIRE(spiWire().pixel(99, 99) == 0xF800);
+    REQUIRE(spiWire().pixel(109, 109) == 0xF800);
+  }
+
+  SECTION("dlSpans() draws what drawSpans() draws")
+  {
+    tft_span_t spans[] = {{20, 6, 2}, {10, 5, 4}, {20, 7, 2}, {10, 6, 4}, {20, 5, 2}, {-3, 8, 5}, {310, 9, 20}};
+    tft_span_t copy[7];
+
+    for (bool dma : {false, true})
+    {
+      TFT_eSPI tft;
+      tft.init();
+      spiWire().reset();
+      memcpy(copy, spans, sizeof spans);
+      tft.drawSpans(copy, 7, 0x07E0);
+      const std::vector<uint16_t> frame = spiWire().frame();
+      const uint32_t commands = spiWire().commands();
+
+      TFT_eSPI listed;
+      listed.init();
+      listed.DMA_Enabled = dma;
+      spiWire().reset();
+      static uint32_t buffer[256];
+      memcpy(copy, spans, sizeof spans);
+      listed.startWrite();
+      REQUIRE(listed.dlBegin(buffer, sizeof buffer));
+      listed.dlSpans(copy, 7, 0x07E0);
+      listed.dlEnd();
+      drainDma(listed);
+      listed.endWrite();
+
+      INFO("dma " << dma);
+      REQUIRE(spiWire().frame() == frame);
+      REQUIRE(spiWire().commands() == commands);
+      REQUIRE(spiWire().pixel(0, 8) == 0x07E0);
+      REQUIRE(spiWire().pixel(319, 9) == 0x07E0);
+    }
+  }
+
+  SECTION("dlImage() calls done once, after its pixels are sent")
+  {
+    // As TftDisplay lends its bands: a band is filled again once its done()
+    // has run, and the driver is only asked for results while waiting
+    static const int BANDS = 2;
+    static const int ROWS = 8;
+    static uint16_t bands[BANDS][320 * ROWS];
+    static uint32_t buffer[1024];
+
+    for (bool dma : {false, true})
+    {
+      TFT_eSPI tft;
+      tft.init();
+      tft.setSwapBytes(true); // Colour values, as the firmware's bands
+      tft.DMA_Enabled = dma;
+      spiWire().reset();
+
+      volatile bool busy[BANDS] = {false, false};
+      int done = 0;
+      struct Ctx
+      {
+        volatile bool *busy;
+        int *done;
+      } ctx[BANDS] = {{&busy[0], &done}, {&busy[1], &done}};
+      auto bandDone = [](void *p)
+      {
+        Ctx *c = (Ctx *)p;
+        REQUIRE(*c->busy);
+        *c->busy = false;
+        (*c->done)++;
+      };
+
+      tft.startWrite();
+      REQUIRE(tft.dlBegin(buffer, sizeof buffer));
+      for (int band = 0; band < 480 / ROWS; band++)
+      {
+        const int i = band % BANDS;
+        spi_transaction_t *t;
+        while (busy[i])
+        {
+          REQUIRE(tft.spiBusyCheck > 0);
+          spi_device_get_trans_result(dmaHAL, &t, portMAX_DELAY);
+          tft.spiBusyCheck--;
+        }
+        for (int p = 0; p < 320 * ROWS; p++)
+          bands[i][p] = (uint16_t)(band * 0x0841 + p / 320);
+        busy[i] = true;
+
+        tft.dlWindow(0, band * ROWS, 319, band * ROWS + ROWS - 1);
+        tft.dlImage(bands[i], 320 * ROWS, bandDone, &ctx[i]);
+        // Without DMA the pixels are written before dlImage() returns
+        REQUIRE(busy[i] == dma);
+      }
+      tft.dlEnd();
+      drainDma(tft);
+      tft.endWrite();
+
+      INFO("dma " << dma);
+      REQUIRE(done == 480 / ROWS);
+      for (int y = 0; y < 480; y++)
+      {
+        REQUIRE(spiWire().pixel(0, y) == (uint16_t)(y / ROWS * 0x0841 + y % ROWS));
+        REQUIRE(spiWire().pixel(319, y) == (uint16_t)(y / ROWS * 0x0841 + y % ROWS));
+      }
+    }
+  }
+
+  SECTION("dlImage() without pixels calls done at once")
+  {
+    TFT_eSPI tft;
+    tft.DMA_Enabled = true;
+    static uint32_t buffer[256];
+    int done = 0;
+    REQUIRE(tft.dlBegin(buffer, sizeof buffer));
+    tft.dlImage(nullptr, 0, [](void *ctx) { (*(int *)ctx)++; }, &done);
+    REQUIRE(done == 1);
+    REQUIRE(tft.spiBusyCheck == 0);
+    tft.dlEnd();
+  }
+
+  SECTION("dlBegin() refuses a buffer under 512 bytes")
+  {
+    TFT_eSPI tft;
+    static uint32_t buffer[128];
+    REQUIRE_FALSE(tft.dlBegin(buffer, 511));
+    REQUIRE_FALSE(tft.dlBegin(nullptr, 4096));
+    REQUIRE(tft.dlBegin(buffer, 512));
+    tft.dlEnd();
+    REQUIRE_FALSE(tft.dlRecording());
+  }
+}
@@ -0,0 +1,49 @@
+#include <catch.hpp>
+#include "TestView.h"
+
+TEST_CASE("haversine_km")
+{
+  // one degree of latitude
+  REQUIRE(haversine_km(46.0, 6.0, 47.0, 6.0) == Approx(111.195).epsilon(0.001));
+  REQUIRE(haversine_km(46.0, 6.0, 46.0, 6.0) == 0.0);
+}
+
+TEST_CASE("bearing_deg")
+{
+  REQUIRE(bearing_deg(46.0, 6.0, 47.0, 6.0) == Approx(0.0).margin(1e-9));
+  REQUIRE(bearing_deg(46.0, 6.0, 46.0, 7.0) == Approx(89.64).epsilon(0.001));
+  REQUIRE(bearing_deg(46.0, 6.0, 45.0, 6.0) == Approx(180.0));
+  REQUIRE(bearing_deg(46.0, 6.0, 46.0, 5.0) == Approx(270.36).epsilon(0.001));
+}
+
+TEST_CASE("latlon_to_screen_xy")
+{
+  int sx, sy;
+
+  SECTION("home is the center of the screen")
+  {
+    REQUIRE(latlon_to_screen_xy(TEST_VIEW, TEST_VIEW.homeLat, TEST_VIEW.homeLon, sx, sy));
+    REQUIRE(sx == 240);
+    REQUIRE(sy == 160);
+  }
+
+  SECTION("north is up, east is right")
+  {
+    REQUIRE(latlon_to_screen_xy(TEST_VIEW, TEST_VIEW.homeLat + 0.1, TEST_VIEW.homeLon + 0.1, sx, sy));
+    REQUIRE(sx == 258);
+    REQUIRE(sy < 160);
+  }
+
+  SECTION("accepts a sprite partly off screen")
+  {
+    // 15 pixels west of the left edge
+    REQUIRE(latlon_to_screen_xy(TEST_VIEW, TEST_VIEW.homeLat, TEST_VIEW.homeLon - 1.4, sx, sy));
+    REQUIRE(sx < 0);
+  }
+
+  SECTION("rejects what can't be visible")
+  {
+    REQUIRE_FALSE(latlon_to_screen_xy(TEST_VIEW, TEST_VIEW.homeLat, TEST_VIEW.homeLon + 2.0, sx, sy));
+    REQUIRE_FALSE(latlon_to_screen_xy(TEST_VIEW, TEST_VIEW.homeLat - 2.0, TEST_VIEW.homeLon, sx, sy));
+  }
+}
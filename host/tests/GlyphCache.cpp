@@ -0,0 +1,195 @@
+#include <catch.hpp>
+#include <TFT_eSPI.h>
+#include <map>
+#include <vector>
+
+// Smooth font glyphs from a .vlw file, with and without the glyph cache.
+// TFT_ESPI_DIR is lib/TFT_eSPI (set by CMake).
+
+namespace
+{
+
+const char *FONT_DIR = TFT_ESPI_DIR "/examples/Smooth Fonts/SPIFFS/Font_Demo_2/data";
+
+// The cache's own state, for the tests
+class CachedTft : public TFT_eSPI
+{
+public:
+  uint16_t glyph(uint16_t code)
+  {
+    uint16_t gNum = 0;
+    REQUIRE(getUnicodeIndex(code, &gNum));
+    return gNum;
+  }
+
+  // Bytes the glyph takes in the cache
+  uint32_t entryBytes(uint16_t code)
+  {
+    const uint16_t g = glyph(code);
+    return sizeof(glyph_cache_t) + gWidth[g] * gHeight[g];
+  }
+
+  bool cached(uint16_t code) { return gc_index && gc_index[glyph(code)]; }
+  uint32_t used() const { return gc_used; }
+
+  void draw(uint16_t code)
+  {
+    setCursor(100, 100);
+    drawGlyph(code);
+  }
+};
+
+struct Stats
+{
+  uint32_t hits, misses;
+};
+
+Stats stats(TFT_eSPI &tft)
+{
+  Stats s;
+  tft.getGlyphCacheStats(&s.hits, &s.misses);
+  return s;
+}
+
+} // namespace
+
+TEST_CASE("Glyph cache")
+{
+  fs::FS fonts(FONT_DIR);
+  CachedTft tft;
+  tft.init();
+  tft.setTextColor(0xFFFF, 0x0000);
+  tft.loadFont("NotoSansBold15", fonts);
+  REQUIRE(tft.fontLoaded);
+
+  SECTION("draws what the file draws, without reading it again")
+  {
+    const char *text = "Glyph cache 0123";
+
+    spiWire().reset();
+    tft.setCursor(10, 10);
+    tft.print(text);
+    const std::vector<uint16_t> uncached = spiWire().frame();
+    REQUIRE(stats(tft).misses == 0);
+
+    tft.setGlyphCache(16 * 1024);
+    for (int pass = 0; pass < 2; pass++)
+    {
+      spiWire().reset();
+      const uint32_t reads = fonts.reads();
+      tft.setCursor(10, 10);
+      tft.print(text);
+
+      INFO("pass " << pass);
+      REQUIRE(spiWire().frame() == uncached);
+      if (pass == 0)
+      {
+        // "c" is drawn twice, space is not a glyph: 12 distinct glyphs
+        REQUIRE(stats(tft).misses == 12);
+        REQUIRE(stats(tft).hits == 2);
+        REQUIRE(fonts.reads() - reads == 12); // One read per glyph, not per row
+      }
+      else
+      {
+        REQUIRE(stats(tft).misses == 12);
+        REQUIRE(stats(tft).hits == 2 + 14);
+        REQUIRE(fonts.reads() == reads);
+      }
+    }
+
+    tft.resetGlyphCacheStats();
+    REQUIRE(stats(tft).hits == 0);
+    REQUIRE(stats(tft).misses == 0);
+  }
+
+  SECTION("evicts the least recently drawn glyph first")
+  {
+    // Four glyphs of the same size, so each new one evicts exactly one
+    std::map<uint32_t, std::vector<uint16_t>> bySize;
+    std::vector<uint16_t> same;
+    for (uint16_t c = 0x21; c < 0x7F && same.size() < 4; c++)
+    {
+      std::vector<uint16_t> &codes = bySize[tft.entryBytes(c)];
+      codes.push_back(c);
+      if (codes.size() == 4)
+        same = codes;
+    }
+    REQUIRE(same.size() == 4);
+    const uint16_t a = same[0], b = same[1], c = same[2], d = same[3];
+    const uint32_t entry = tft.entryBytes(a);
+
+    tft.setGlyphCache(3 * entry);
+    tft.draw(a);
+    tft.draw(b);
+    tft.draw(c);
+    REQUIRE(tft.used() == 3 * entry);
+
+    tft.draw(a); // b is now the oldest
+    tft.draw(d);
+    REQUIRE(tft.cached(a));
+    REQUIRE_FALSE(tft.cached(b));
+    REQUIRE(tft.cached(c));
+    REQUIRE(tft.cached(d));
+    REQUIRE(tft.used() == 3 * entry);
+
+    tft.draw(b); // then c
+    REQUIRE_FALSE(tft.cached(c));
+    REQUIRE(tft.cached(a));
+    REQUIRE(tft.cached(b));
+    REQUIRE(tft.cached(d));
+    REQUIRE(stats(tft).misses == 5);
+    REQUIRE(stats(tft).hits == 1);
+
+    // A smaller budget drops the oldest: a, then d
+    tft.setGlyphCache(entry);
+    REQUIRE(tft.used() == entry);
+    REQUIRE(tft.cached(b));
+    REQUIRE_FALSE(tft.cached(a));
+    REQUIRE_FALSE(tft.cached(d));
+
+    tft.setGlyphCache(0);
+    REQUIRE(tft.used() == 0);
+    REQUIRE_FALSE(tft.cached(b));
+  }
+
+  SECTION("a glyph over the budget is drawn from the file, uncached")
+  {
+    const uint16_t big = 'W';
+    const uint16_t g = tft.glyph(big);
+
+    spiWire().reset();
+    tft.draw(big);
+    const std::vector<uint16_t> uncached = spiWire().frame();
+
+    tft.setGlyphCache(tft.entryBytes(big) - 1);
+    tft.draw('i'); // Fits
+    REQUIRE(tft.cached('i'));
+
+    spiWire().reset();
+    const uint32_t reads = fonts.reads();
+    tft.draw(big);
+
+    REQUIRE(spiWire().frame() == uncached);
+    REQUIRE_FALSE(tft.cached(big));
+    REQUIRE(tft.cached('i')); // Nothing was evicted for it
+    REQUIRE(tft.used() == tft.entryBytes('i'));
+    REQUIRE(stats(tft).misses == 2);
+    REQUIRE(fonts.reads() - reads == tft.gHeight[g]); // A row at a time
+  }
+
+  SECTION("unloading the font empties the cache")
+  {
+    tft.setGlyphCache(4096);
+    tft.draw('x');
+    REQUIRE(tft.used() > 0);
+    tft.unloadFont();
+    REQUIRE(tft.used() == 0);
+
+    // The budget stays for the next font
+    tft.loadFont("NotoSansBold15", fonts);
+    tft.draw('x');
+    REQUIRE(tft.cached('x'));
+  }
+
+  tft.unloadFont();
+}
@@ -0,0 +1,408 @@
+// Golden-frame tests for the renderer.
+//
+//   GoldenFrames check <dir>   renders every scene and compares each frame
+//                              pixel for pixel with <dir>/<frame>.frame
+//   GoldenFrames update <dir>  rewrites the golden frames
+//
+// Scenes are fixed track sets fed through AdsbCore with the firmware's map
+// and sprites into the emulated panel. Besides pixel equality, every frame
+// reports its SPI cost next to the cost recorded with the golden frame, so
+// a render optimization shows both that the output is unchanged and what it
+// saved. A mismatch writes <frame>.actual.png and <frame>.golden.png into
+// the working directory.
+//
+// A .frame file stores the framebuffer as the runs of pixels that differ
+// from the background (little-endian):
+//   "HBFR", u32 version, 5 x u64 SpiCost, u32 run count,
+//   then per run: u32 offset, u32 length, length x u16 pixels
+
+#include <math.h>
+#include <stdio.h>
+#include <string.h>
+#include <string>
+#include <vector>
+#include <EmulatorDisplay.h>
+#include <FirmwareAssets.h>
+#include <HB9IIU_Core.h>
+#include <HostPlatform.h>
+
+static const uint32_t FRAME_VERSION = 1;
+static const double PI = 3.14159265358979323846;
+
+// ===================== Scenes =====================
+struct Plane
+{
+  const char *hex;
+  int sx, sy;     // sprite center on screen
+  int headingDeg; // -1: no track
+  int altFt;      // -1: no altitude
+};
+
+// Lat/lon that projects to the screen pixel (sx, sy)
+static void screenToLatLon(const MapView &view, int sx, int sy, double &lat, double &lon)
+{
+  const double world = 256.0 * (double)(1UL << view.zoom);
+  const double gx = view.px0 + sx;
+  const double gy = view.py0 + sy;
+  lon = gx / world * 360.0 - 180.0;
+  lat = atan(sinh(PI * (1.0 - 2.0 * gy / world))) * 180.0 / PI;
+}
+
+static std::string aircraftJson(const MapView &view, const std::vector<Plane> &planes)
+{
+  std::string body = "{\"now\":1718000000.0,\"aircraft\":[";
+  char buf[256];
+  for (size_t i = 0; i < planes.size(); i++)
+  {
+    const Plane &p = planes[i];
+    double lat, lon;
+    screenToLatLon(view, p.sx, p.sy, lat, lon);
+    int n = snprintf(buf, sizeof(buf), "%s{\"hex\":\"%s\",\"lat\":%.7f,\"lon\":%.7f,\"seen_pos\":0.1,\"seen\":0.1",
+                     i ? "," : "", p.hex, lat, lon);
+    if (p.headingDeg >= 0)
+      n += snprintf(buf + n, sizeof(buf) - n, ",\"track\":%d.0", p.headingDeg);
+    if (p.altFt >= 0)
+      n += snprintf(buf + n, sizeof(buf) - n, ",\"alt_baro\":%d", p.altFt);
+    snprintf(buf + n, sizeof(buf) - n, "}");
+    body += buf;
+  }
+  return body + "]}";
+}
+
+struct Frame
+{
+  std::string name;
+  std::vector<uint16_t> pixels;
+  SpiCost cost; // of this step only
+};
+
+// The panel after setup(), then one fetch + render per step
+class Scene
+{
+public:
+  explicit Scene(const char *name)
+      : name_(name), assets_(firmwareAssets()), view_(firmwareMapView()),
+        clock_(10000), tft_(PixelFormat::Rgb565), display_(tft_),
+        core_(clock_, display_, feed_, view_, assets_)
+  {
+    tft_.pushImage(0, 0, SW, SH, assets_.background);
+    display_.startWrite();
+    core_.drawLegendBar();
+    display_.endWrite();
+  }
+
+  // Fetches `planes` after `elapsedMs` and keeps the rendered frame
+  void step(std::vector<Frame> &out, const std::vector<Plane> &planes, uint32_t elapsedMs = FETCH_PERIOD_MS)
+  {
+    clock_.advance(elapsedMs);
+    feed_.setBody(aircraftJson(view_, planes));
+    tft_.resetCost();
+
+    FetchReport report;
+    if (core_.fetchAndUpdateTracks(report))
+      core_.renderTracks();
+
+    Frame f;
+    f.name = name_ + "_" + std::to_string(steps_++);
+    f.pixels.assign(tft_.framebuffer(), tft_.framebuffer() + SW * SH);
+    f.cost = tft_.cost();
+    out.push_back(f);
+  }
+
+private:
+  std::string name_;
+  RenderAssets assets_;
+  MapView view_;
+  ManualClock clock_;
+  TftEmulator tft_;
+  EmulatorDisplay display_;
+  MemoryFeed feed_;
+  AdsbCore core_;
+  int steps_ = 0;
+};
+
+static const char *const HEX[] = {
+    "4b0000", "4b0001", "4b0002", "4b0003", "4b0004", "4b0005", "4b0006", "4b0007", "4b0008",
+    "4b0009", "4b000a", "4b000b", "4b000c", "4b000d", "4b000e", "4b000f", "4b0010", "4b0011",
+    "4b0012", "4b0013", "4b0014", "4b0015", "4b0016", "4b0017", "4b0018", "4b0019", "4b001a",
+    "4b001b", "4b001c", "4b001d", "4b001e", "4b001f", "4b0020", "4b0021", "4b0022", "4b0023"};
+
+// One altitude per color band, and unknown
+static const int ALTS_FT[] = {-1, 1500, 9000, 24000, 38000};
+
+static std::vector<Frame> renderScenes()
+{
+  std::vector<Frame> frames;
+
+  // Every 10 degrees of heading (mapHeadingToSprite), all altitude colors
+  {
+    Scene s("headings");
+    std::vector<Plane> planes;
+    for (int i = 0; i < 36; i++)
+      planes.push_back({HEX[i], 50 + (i % 6) * 76, 45 + (i / 6) * 46, i * 10, ALTS_FT[i % 5]});
+    s.step(frames, planes);
+  }
+
+  // Clipping at the screen edges and overlap with the legend / bottom bars
+  {
+    Scene s("edges");
+    const std::vector<Plane> planes = {
+        {HEX[0], 0, 0, 45, 38000},
+        {HEX[1], SW - 1, 0, 135, 24000},
+        {HEX[2], 0, SH - 1, 225, 9000},
+        {HEX[3], SW - 1, SH - 1, 315, 1500},
+        {HEX[4], -12, 160, 90, 38000},
+        {HEX[5], SW + 12, 160, 270, 38000},
+        {HEX[6], 240, -12, 180, 38000},
+        {HEX[7], 240, SH + 12, 0, 38000},
+        {HEX[8], 16, 100, 0, 9000},
+        {HEX[9], SW - 16, 100, 0, 9000},
+        {HEX[10], 120, 8, 30, 24000},
+        {HEX[11], 330, LEGEND_H, 60, -1},
+        {HEX[12], 160, SH - 8, 200, 1500},
+        {HEX[13], 380, SH - BOTTOM_H, 250, 9000},
+        // Partly off screen, and exactly against the bars
+        {HEX[14], 4, 200, 300, 24000},
+        {HEX[15], SW - 6, 240, 100, 1500},
+        {HEX[16], 200, LEGEND_H + PH / 2, 10, 38000},
+        {HEX[17], 260, LEGEND_H + PH / 2 - 1, 10, 38000},
+        {HEX[18], 300, SH - BOTTOM_H - PH / 2, 170, 9000},
+        {HEX[19], 360, SH - BOTTOM_H - PH / 2 + 1, 170, 9000},
+    };
+    s.step(frames, planes);
+  }
+
+  // Overlapping sprites: draw order and redraw of neighbours
+  {
+    Scene s("overlap");
+    std::vector<Plane> planes;
+    for (int i = 0; i < 8; i++)
+      planes.push_back({HEX[i], 230 + (i % 3) * 9, 150 + (i / 3) * 11, i * 45 + 5, ALTS_FT[i % 5]});
+    s.step(frames, planes);
+  }
+
+  // Moves, a slot reuse, a new plane, then expiry after TRACK_TTL_MS
+  {
+    Scene s("motion");
+    std::vector<Plane> planes = {
+        {HEX[0], 100, 100, 90, 38000},
+        {HEX[1], 200, 150, 180, 24000},
+        {HEX[2], 300, 200, 270, 9000},
+        {HEX[3], 360, 80, 0, 1500},
+    };
+    s.step(frames, planes);
+
+    planes[0].sx += 4;   // small move: one dirty union
+    planes[1].sy += 40;  // far move: two dirty rects
+    planes[2].headingDeg = 300;
+    planes.pop_back();   // stops reporting, stays until it expires
+    planes.push_back({HEX[4], 120, 110, 45, -1});
+    s.step(frames, planes);
+
+    s.step(frames, planes, TRACK_TTL_MS);
+  }
+
+  return frames;
+}
+
+// ===================== .frame files =====================
+static void put32(std::vector<uint8_t> &out, uint32_t v)
+{
+  for (int i = 0; i < 4; i++)
+    out.push_back((uint8_t)(v >> (8 * i)));
+}
+
+static void put64(std::vector<uint8_t> &out, uint64_t v)
+{
+  put32(out, (uint32_t)v);
+  put32(out, (uint32_t)(v >> 32));
+}
+
+static bool writeFrame(const std::string &path, const Frame &f, const uint16_t *background)
+{
+  std::vector<uint8_t> out = {'H', 'B', 'F', 'R'};
+  put32(out, FRAME_VERSION);
+  put64(out, f.cost.commands);
+  put64(out, f.cost.windows);
+  put64(out, f.cost.commandBytes);
+  put64(out, f.cost.pixelBytes);
+  put64(out, f.cost.transactions);
+
+  std::vector<uint8_t> runs;
+  uint32_t count = 0;
+  for (uint32_t i = 0; i < (uint32_t)f.pixels.size();)
+  {
+    if (f.pixels[i] == background[i])
+    {
+      i++;
+      continue;
+    }
+    uint32_t end = i;
+    while (end < f.pixels.size() && f.pixels[end] != background[end])
+      end++;
+    put32(runs, i);
+    put32(runs, end - i);
+    for (; i < end; i++)
+    {
+      runs.push_back((uint8_t)f.pixels[i]);
+      runs.push_back((uint8_t)(f.pixels[i] >> 8));
+    }
+    count++;
+  }
+  put32(out, count);
+  out.insert(out.end(), runs.begin(), runs.end());
+
+  FILE *file = fopen(path.c_str(), "wb");
+  if (!file)
+    return false;
+  const bool ok = fwrite(out.data(), 1, out.size(), file) == out.size();
+  return fclose(file) == 0 && ok;
+}
+
+struct Reader
+{
+  std::vector<uint8_t> data;
+  size_t pos = 0;
+  bool ok = true;
+
+  uint32_t get32()
+  {
+    if (pos + 4 > data.size())
+    {
+      ok = false;
+      return 0;
+    }
+    uint32_t v = 0;
+    for (int i = 0; i < 4; i++)
+      v |= (uint32_t)data[pos++] << (8 * i);
+    return v;
+  }
+
+  uint64_t get64()
+  {
+    const uint64_t lo = get32();
+    return lo | (uint64_t)get32() << 32;
+  }
+};
+
+static bool readFrame(const std::string &path, Frame &f, const uint16_t *background)
+{
+  FILE *file = fopen(path.c_str(), "rb");
+  if (!file)
+    return false;
+  Reader r;
+  uint8_t buf[4096];
+  size_t n;
+  while ((n = fread(buf, 1, sizeof(buf), file)) > 0)
+    r.data.insert(r.data.end(), buf, buf + n);
+  fclose(file);
+
+  if (r.data.size() < 4 || memcmp(r.data.data(), "HBFR", 4) != 0)
+    return false;
+  r.pos = 4;
+  if (r.get32() != FRAME_VERSION)
+    return false;
+  f.cost.commands = r.get64();
+  f.cost.windows = r.get64();
+  f.cost.commandBytes = r.get64();
+  f.cost.pixelBytes = r.get64();
+  f.cost.transactions = r.get64();
+
+  f.pixels.assign(background, background + SW * SH);
+  for (uint32_t count = r.get32(); count && r.ok; count--)
+  {
+    const uint32_t offset = r.get32();
+    const uint32_t length = r.get32();
+    if (!r.ok || offset + length > f.pixels.size() || r.pos + 2 * length > r.data.size())
+      return false;
+    for (uint32_t i = 0; i < length; i++, r.pos += 2)
+      f.pixels[offset + i] = (uint16_t)(r.data[r.pos] | r.data[r.pos + 1] << 8);
+  }
+  return r.ok && r.pos == r.data.size();
+}
+
+static void dumpPng(const std::string &path, const std::vector<uint16_t> &pixels)
+{
+  TftEmulator tft(PixelFormat::Rgb565);
+  tft.pushImage(0, 0, SW, SH, pixels.data());
+  tft.writePng(path.c_str());
+}
+
+// ===================== main =====================
+int main(int argc, char **argv)
+{
+  if (argc != 3 || (strcmp(argv[1], "check") && strcmp(argv[1], "update")))
+  {
+    fprintf(stderr, "usage: GoldenFrames check|update <dir>\n");
+    return 2;
+  }
+  const bool update = !strcmp(argv[1], "update");
+  const std::string dir = argv[2];
+  const uint16_t *background = firmwareAssets().background;
+
+  const std::vector<Frame> frames = renderScenes();
+
+  printf("%-12s %12s %12s %8s %12s\n", "frame", "golden B", "actual B", "delta", "wire us");
+  int failures = 0;
+  SpiCost goldenTotal, actualTotal;
+  for (size_t i = 0; i < frames.size(); i++)
+  {
+    const Frame &actual = frames[i];
+    const std::string path = dir + "/" + actual.name + ".frame";
+
+    if (update)
+    {
+      if (!writeFrame(path, actual, background))
+      {
+        fprintf(stderr, "%s: can't write\n", path.c_str());
+        return 1;
+      }
+      printf("%-12s %12s %12llu %8s %12.1f\n", actual.name.c_str(), "-",
+             (unsigned long long)actual.cost.bytes(), "", actual.cost.wireMicros(SPI_HZ_ST7796));
+      continue;
+    }
+
+    Frame golden;
+    if (!readFrame(path, golden, background))
+    {
+      printf("%-12s missing or damaged golden frame %s\n", actual.name.c_str(), path.c_str());
+      failures++;
+      continue;
+    }
+
+    goldenTotal += golden.cost;
+    actualTotal += actual.cost;
+    const double delta = golden.cost.bytes() ? 100.0 * ((double)actual.cost.bytes() - golden.cost.bytes()) / golden.cost.bytes() : 0;
+    printf("%-12s %12llu %12llu %7.1f%% %12.1f\n", actual.name.c_str(),
+           (unsigned long long)golden.cost.bytes(), (unsigned long long)actual.cost.bytes(),
+           delta, actual.cost.wireMicros(SPI_HZ_ST7796));
+
+    size_t diff = 0, first = 0;
+    for (size_t p = 0; p < actual.pixels.size(); p++)
+      if (actual.pixels[p] != golden.pixels[p] && !diff++)
+        first = p;
+    if (diff)
+    {
+      printf("  FAILED: %lu pixels differ, first at (%lu,%lu): 0x%04X, golden 0x%04X\n",
+             (unsigned long)diff, (unsigned long)(first % SW), (unsigned long)(first / SW),
+             actual.pixels[first], golden.pixels[first]);
+      dumpPng(actual.name + ".actual.png", actual.pixels);
+      dumpPng(actual.name + ".golden.png", golden.pixels);
+      failures++;
+    }
+  }
+
+  if (update)
+  {
+    printf("%lu golden frames written to %s\n", (unsigned long)frames.size(), dir.c_str());
+    return 0;
+  }
+
+  printf("total: %llu -> %llu SPI bytes, %.1f -> %.1f us at %lu MHz\n",
+         (unsigned long long)goldenTotal.bytes(), (unsigned long long)actualTotal.bytes(),
+         goldenTotal.wireMicros(SPI_HZ_ST7796), actualTotal.wireMicros(SPI_HZ_ST7796),
+         (unsigned long)(SPI_HZ_ST7796 / 1000000));
+  if (failures)
+    printf("%d of %lu frames differ from the golden frames\n", failures, (unsigned long)frames.size());
+  return failures ? 1 : 0;
+}
@@ -0,0 +1,159 @@
+#include <catch.hpp>
+#include <HB9IIU_Core.h>
+#include <HostPlatform.h>
+#include <vector>
+#include "TestView.h"
+
+// Defined here so REQUIRE() can take them by reference
+static const int TOP = OverlayLayer::TOP;
+static const int BOTTOM = OverlayLayer::BOTTOM;
+
+TEST_CASE("OverlayLayer")
+{
+  std::vector<uint8_t> pixels(OverlayLayer::BYTES, 0xAA);
+  OverlayLayer overlay(pixels.data());
+  Rect rects[8];
+
+  SECTION("starts clear and clean")
+  {
+    REQUIRE(overlay.pixel(0, 0) == 0);
+    REQUIRE(overlay.pixel(SW - 1, SH - 1) == 0);
+    REQUIRE(overlay.takeDirtyRects(rects, 8) == 0);
+  }
+
+  SECTION("setPixel() writes one nibble and clips to the map rows")
+  {
+    overlay.setPixel(10, 25, 3);
+    overlay.setPixel(11, 25, 12);
+    overlay.setPixel(-1, 25, 7);
+    overlay.setPixel(SW, 25, 7);
+    REQUIRE(overlay.pixel(10, 25) == 3);
+    REQUIRE(overlay.pixel(11, 25) == 12);
+    REQUIRE(overlay.pixel(9, 25) == 0);
+    REQUIRE(overlay.pixel(12, 25) == 0);
+    REQUIRE(pixels[((25 - TOP) * SW + 10) / 2] == 0x3C);
+
+    overlay.setPixel(10, TOP - 1, 7);
+    overlay.setPixel(10, BOTTOM, 7);
+    REQUIRE(overlay.pixel(10, TOP - 1) == 0);
+    REQUIRE(overlay.pixel(10, BOTTOM) == 0);
+  }
+
+  SECTION("fillRect() with odd edges matches setPixel()")
+  {
+    std::vector<uint8_t> refPixels(OverlayLayer::BYTES);
+    OverlayLayer ref(refPixels.data());
+    overlay.fillRect(3, 27, 10, 4, 9);
+    overlay.fillRect(-5, 15, 8, 8, 2);
+    overlay.fillRect(SW - 3, BOTTOM - 2, 10, 10, 15);
+    for (int y = 27; y < 31; y++)
+      for (int x = 3; x < 13; x++)
+        ref.setPixel(x, y, 9);
+    for (int y = TOP; y < 23; y++)
+      for (int x = 0; x < 3; x++)
+        ref.setPixel(x, y, 2);
+    for (int y = BOTTOM - 2; y < BOTTOM; y++)
+      for (int x = SW - 3; x < SW; x++)
+        ref.setPixel(x, y, 15);
+    REQUIRE(pixels == refPixels);
+  }
+
+  SECTION("drawLine() and drawCircle() hit their end points")
+  {
+    overlay.drawLine(5, 25, 40, 37, 1);
+    REQUIRE(overlay.pixel(5, 25) == 1);
+    REQUIRE(overlay.pixel(40, 37) == 1);
+
+    overlay.drawCircle(100, 100, 30, 4);
+    REQUIRE(overlay.pixel(130, 100) == 4);
+    REQUIRE(overlay.pixel(70, 100) == 4);
+    REQUIRE(overlay.pixel(100, 70) == 4);
+    REQUIRE(overlay.pixel(100, 130) == 4);
+    REQUIRE(overlay.pixel(100, 100) == 0);
+  }
+
+  SECTION("dirty tiles come back as merged rects, once")
+  {
+    overlay.fillRect(20, 20, 40, 10, 1); // tiles x 1..3, y 1
+    overlay.fillRect(20, 36, 40, 4, 1);  // same tiles, y 2
+    overlay.setPixel(SW - 1, 40, 1);     // tile x 29, y 2
+
+    // Tile row 1 starts in the legend: cut at TOP
+    REQUIRE(overlay.takeDirtyRects(rects, 8) == 2);
+    REQUIRE(rects[0].x == 16);
+    REQUIRE(rects[0].y == TOP);
+    REQUIRE(rects[0].w == 48);
+    REQUIRE(rects[0].h == 48 - TOP);
+    REQUIRE(rects[1].x == SW - 16);
+    REQUIRE(rects[1].y == 32);
+    REQUIRE(rects[1].w == 16);
+    REQUIRE(rects[1].h == 16);
+    REQUIRE(overlay.takeDirtyRects(rects, 8) == 0);
+
+    overlay.setPixel(20, 20, 1); // unchanged
+    REQUIRE(overlay.takeDirtyRects(rects, 8) == 0);
+  }
+
+  SECTION("rects over the limit stay dirty")
+  {
+    for (int i = 0; i < 5; i++)
+      overlay.setPixel(i * 2 * OverlayLayer::TILE, TOP + i * 2 * OverlayLayer::TILE, 1);
+    REQUIRE(overlay.takeDirtyRects(rects, 3) == 3);
+    REQUIRE(overlay.takeDirtyRects(rects, 3) == 2);
+    REQUIRE(overlay.takeDirtyRects(rects, 3) == 0);
+  }
+
+  SECTION("invalidate() and a palette change mark the whole layer")
+  {
+    overlay.setPalette(1, 0x1234);
+    REQUIRE(overlay.takeDirtyRects(rects, 8) == 1);
+    REQUIRE(rects[0].x == 0);
+    REQUIRE(rects[0].y == TOP);
+    REQUIRE(rects[0].w == SW);
+    REQUIRE(rects[0].h == BOTTOM - TOP);
+    overlay.setPalette(1, 0x1234);
+    REQUIRE(overlay.takeDirtyRects(rects, 8) == 0);
+  }
+
+  SECTION("composite() draws the palette colors of non-clear pixels")
+  {
+    overlay.setPalette(5, 0xF800);
+    overlay.setPixel(101, 51, 5);
+    overlay.setPixel(102, 52, 5);
+
+    const Rect b = {100, 50, 4, 3};
+    uint16_t band[4 * 3];
+    for (int i = 0; i < 12; i++)
+      band[i] = 0x0101;
+    overlay.composite(band, b);
+    for (int i = 0; i < 12; i++)
+      REQUIRE(band[i] == (i == 1 * 4 + 1 || i == 2 * 4 + 2 ? 0xF800 : 0x0101));
+  }
+}
+
+TEST_CASE("AdsbCore redraws dirty overlay tiles")
+{
+  static uint16_t background[SW * SH];
+  static uint8_t planeMask[PW / 8 * PH];
+  static uint16_t planeOffsets[360];
+  const RenderAssets assets = {background, planeMask, planeOffsets, PW / 8};
+
+  ManualClock clock(100000);
+  NullDisplay display;
+  MemoryFeed feed;
+  AdsbCore core(clock, display, feed, TEST_VIEW, assets);
+
+  std::vector<uint8_t> pixels(OverlayLayer::BYTES);
+  OverlayLayer overlay(pixels.data());
+  core.setOverlay(&overlay);
+
+  core.renderTracks(); // the whole layer once
+  display.resetCounters();
+  core.renderTracks();
+  REQUIRE(display.counters().pushImage == 0);
+
+  overlay.setPixel(200, 100, 1);
+  core.renderTracks();
+  REQUIRE(display.counters().pushImage == 1);
+  REQUIRE(display.counters().pixels >= OverlayLayer::TILE * OverlayLayer::TILE);
+}
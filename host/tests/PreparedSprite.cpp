@@ -0,0 +1,134 @@
+#include <catch.hpp>
+#include <TFT_eSPI.h>
+#include <random>
+#include <vector>
+
+// pushPrepared() against pushSprite(x, y, transparent), on the wire
+
+namespace
+{
+
+const int W = 320; // TFT_eSPI's ST7796 in rotation 0
+const int H = 480;
+
+// A sprite of transparent pixels with opaque rectangles and single pixels,
+// some of them in the transparent colour
+void drawScene(TFT_eSprite &spr, std::mt19937 &rng, uint16_t transparent)
+{
+  spr.fillSprite(transparent);
+  const int w = spr.width(), h = spr.height();
+  for (int k = rng() % 6; k > 0; k--)
+    spr.fillRect((int)(rng() % w), (int)(rng() % h), 1 + (int)(rng() % w), 1 + (int)(rng() % h),
+                 rng() % 8 ? (uint16_t)rng() : transparent);
+  for (int k = rng() % 40; k > 0; k--)
+    spr.drawPixel((int)(rng() % w), (int)(rng() % h), rng() % 4 ? (uint16_t)rng() : transparent);
+}
+
+} // namespace
+
+TEST_CASE("pushPrepared()")
+{
+  TFT_eSPI tft;
+  tft.init();
+
+  SECTION("draws what pushSprite() with a transparent colour draws")
+  {
+    std::mt19937 rng(48);
+
+    for (int n = 0; n < 300; n++)
+    {
+      TFT_eSprite spr(&tft);
+      REQUIRE(spr.createSprite(1 + rng() % 70, 1 + rng() % 40));
+      const uint16_t transparent = (uint16_t)rng();
+      drawScene(spr, rng, transparent);
+      REQUIRE(spr.prepareRuns(transparent));
+
+      // Often across an edge of the screen
+      const int x = (int)(rng() % (W + 100)) - 50;
+      const int y = (int)(rng() % (H + 60)) - 30;
+      const bool swap = rng() & 1;
+
+      // Every 3rd in a viewport, with or without its datum; every 5th
+      // with the origin moved
+      tft.resetViewport();
+      const bool viewport = n % 3 == 0;
+      const bool vpDatum = rng() & 1;
+      if (viewport)
+        tft.setViewport((int)(rng() % 250), (int)(rng() % 400), 10 + (int)(rng() % 120), 4 + (int)(rng() % 60),
+                        vpDatum);
+      const bool origin = n % 5 == 0;
+      if (origin)
+        tft.setOrigin((int)(rng() % 80) - 40, (int)(rng() % 80) - 40);
+      tft.setSwapBytes(swap);
+
+      spiWire().reset();
+      spr.pushSprite(x, y, transparent);
+      const std::vector<uint16_t> expected = spiWire().frame();
+
+      spiWire().reset();
+      spr.pushPrepared(x, y);
+
+      INFO("sprite " << n << ": " << spr.width() << "x" << spr.height() << " at " << x << "," << y
+                     << (viewport ? (vpDatum ? " in a viewport with its datum" : " in a viewport") : "")
+                     << (origin ? " moved origin" : "") << (swap ? " swapped" : ""));
+      REQUIRE(spiWire().frame() == expected);
+      // The caller's byte order is left as it was
+      REQUIRE(tft.getSwapBytes() == swap);
+
+      spr.deleteSprite();
+    }
+  }
+
+  SECTION("a fully transparent sprite sends nothing")
+  {
+    TFT_eSprite spr(&tft);
+    REQUIRE(spr.createSprite(40, 20));
+    spr.fillSprite(TFT_MAGENTA);
+    REQUIRE(spr.prepareRuns(TFT_MAGENTA));
+    REQUIRE(spr.preparedRuns() == 0);
+
+    spiWire().reset();
+    spr.pushPrepared(10, 10);
+    REQUIRE(spiWire().bytes().empty());
+    spr.deleteSprite();
+  }
+
+  SECTION("runs are recorded per row")
+  {
+    TFT_eSprite spr(&tft);
+    REQUIRE(spr.createSprite(16, 4));
+    spr.fillSprite(TFT_BLACK);
+    spr.drawFastHLine(2, 1, 3, TFT_RED);
+    spr.drawFastHLine(9, 1, 7, TFT_RED);
+    spr.drawFastHLine(0, 3, 16, TFT_GREEN);
+    REQUIRE(spr.prepareRuns(TFT_BLACK));
+    REQUIRE(spr.preparedRuns() == 3);
+
+    spr.releaseRuns();
+    REQUIRE(spr.preparedRuns() == 0);
+    spiWire().reset();
+    spr.pushPrepared(10, 10);
+    REQUIRE(spiWire().bytes().empty());
+    spr.deleteSprite();
+  }
+
+  SECTION("only 16-bit sprites can be prepared")
+  {
+    for (int8_t bpp : {1, 4, 8})
+    {
+      TFT_eSprite spr(&tft);
+      spr.setColorDepth(bpp);
+      REQUIRE(spr.createSprite(16, 8));
+      spr.fillSprite(TFT_BLACK);
+      spr.drawPixel(3, 3, TFT_WHITE);
+
+      INFO(bpp << " bpp");
+      REQUIRE_FALSE(spr.prepareRuns(TFT_BLACK));
+      REQUIRE(spr.preparedRuns() == 0);
+      spr.deleteSprite();
+    }
+
+    TFT_eSprite none(&tft);
+    REQUIRE_FALSE(none.prepareRuns(TFT_BLACK));
+  }
+}
@@ -0,0 +1,203 @@
+#include <catch.hpp>
+#include <TFT_eSPI.h>
+#include <random>
+#include <stdio.h>
+#include <string>
+#include <vector>
+
+namespace
+{
+
+const int W = 320; // TFT_eSPI's ST7796 in rotation 0
+const int H = 480;
+
+uint16_t swap16(uint16_t v) { return (uint16_t)(v << 8 | v >> 8); }
+
+struct Viewport
+{
+  int x, y, w, h;
+  bool contains(int px, int py) const { return px >= x && py >= y && px < x + w && py < y + h; }
+};
+
+// "" if the frames match, else the first pixel that differs
+std::string frameDiff(const std::vector<uint16_t> &got, const std::vector<uint16_t> &expected)
+{
+  for (size_t i = 0; i < got.size(); i++)
+  {
+    if (got[i] != expected[i])
+    {
+      char s[64];
+      snprintf(s, sizeof s, "%d,%d is 0x%04X, not 0x%04X", (int)(i % SpiWire::WIDTH), (int)(i / SpiWire::WIDTH),
+               got[i], expected[i]);
+      return s;
+    }
+  }
+  return "";
+}
+
+// drawChar() of the GLCD font at size 1 before pushMask(): one window and
+// the 6 x 8 cell, a column at a time LSB at the top, sent pixel by pixel
+void oldDrawChar(TFT_eSPI &tft, int x, int y, uint16_t c, uint16_t color, uint16_t bg)
+{
+  if (c > 175)
+    c++; // Not cp437
+  uint8_t column[6];
+  for (int i = 0; i < 5; i++)
+    column[i] = font[c * 5 + i];
+  column[5] = 0;
+
+  tft.startWrite();
+  tft.setWindow(x, y, x + 5, y + 7);
+  for (int j = 0; j < 8; j++)
+    for (int k = 0; k < 6; k++)
+      tft.pushBlock(column[k] & (1 << j) ? color : bg, 1);
+  tft.endWrite();
+}
+
+} // namespace
+
+TEST_CASE("pushMask()")
+{
+  std::mt19937 rng(45);
+
+  for (int n = 0; n < 300; n++)
+  {
+    const int w = 1 + rng() % 90;
+    const int h = 1 + rng() % 12;
+    const int stride = (w + 7) / 8 + rng() % 3;
+    const int bgStride = w + rng() % 5;
+    // Often across an edge of the screen
+    const int x = (int)(rng() % (W + 80)) - 40;
+    const int y = (int)(rng() % (H + 20)) - 10;
+    const bool swap = rng() & 1;
+    const bool image = rng() & 1;
+    const bool viewport = n % 4 == 0;
+    const uint16_t fg = (uint16_t)rng();
+    const uint16_t bgColor = (uint16_t)rng();
+
+    std::vector<uint8_t> mask(stride * h);
+    for (auto &m : mask)
+      m = (uint8_t)rng();
+    std::vector<uint16_t> bg(bgStride * h);
+    for (auto &p : bg)
+      p = (uint16_t)rng();
+
+    Viewport vp = {0, 0, W, H};
+    TFT_eSPI tft;
+    tft.init();
+    tft.setSwapBytes(swap);
+    if (viewport)
+    {
+      vp = {(int)(rng() % 200), (int)(rng() % 300), 20 + (int)(rng() % 100), 4 + (int)(rng() % 20)};
+      tft.setViewport(vp.x, vp.y, vp.w, vp.h, false);
+    }
+    spiWire().reset();
+
+    if (image)
+      tft.pushMask(x, y, w, h, mask.data(), stride, fg, bg.data(), bgStride);
+    else
+      tft.pushMask(x, y, w, h, mask.data(), stride, fg, bgColor);
+
+    // Image pixels are sent as pushImage() sends them
+    std::vector<uint16_t> expected(SpiWire::WIDTH * SpiWire::HEIGHT, 0);
+    for (int j = 0; j < h; j++)
+    {
+      for (int i = 0; i < w; i++)
+      {
+        const int px = x + i, py = y + j;
+        if (px < 0 || py < 0 || px >= W || py >= H || !vp.contains(px, py))
+          continue;
+        uint16_t c = fg;
+        if (!(mask[j * stride + i / 8] & (0x80 >> (i % 8))))
+          c = image ? (swap ? bg[j * bgStride + i] : swap16(bg[j * bgStride + i])) : bgColor;
+        expected[py * SpiWire::WIDTH + px] = c;
+      }
+    }
+
+    INFO("mask " << n << ": " << w << "x" << h << " at " << x << "," << y << (image ? " image" : " colour")
+                 << (swap ? " swapped" : "") << (viewport ? " in a viewport" : ""));
+    REQUIRE(frameDiff(spiWire().frame(), expected) == "");
+    // One window at most
+    REQUIRE(spiWire().commands() <= 3);
+  }
+}
+
+TEST_CASE("drawChar() of the GLCD font")
+{
+  const uint16_t fg = 0xFFE0;
+  const uint16_t bg = 0x001F;
+  // Without cp437(true) characters above 175 move up one glyph, so 255 reads
+  // past the end of the font (as it always has): not compared
+  const int LAST = 254;
+
+  SECTION("sends the bytes it sent before pushMask()")
+  {
+    for (int c = 0; c <= LAST; c++)
+    {
+      TFT_eSPI tft;
+      tft.init();
+      spiWire().reset();
+      oldDrawChar(tft, 100, 200, (uint16_t)c, fg, bg);
+      const std::vector<uint16_t> before = spiWire().bytes();
+
+      TFT_eSPI now;
+      now.init();
+      spiWire().reset();
+      now.drawChar(100, 200, (uint16_t)c, fg, bg, 1);
+
+      INFO("character " << c);
+      REQUIRE(spiWire().bytes() == before);
+    }
+  }
+
+  SECTION("clipped, draws the visible part of the cell a sprite draws")
+  {
+    TFT_eSPI tft;
+    tft.init();
+    TFT_eSprite cell(&tft);
+    REQUIRE(cell.createSprite(6, 8));
+
+    struct
+    {
+      int x, y;
+      Viewport vp;
+    } cases[] = {
+        {-3, 10, {0, 0, W, H}},
+        {W - 4, 10, {0, 0, W, H}},
+        {10, -5, {0, 0, W, H}},
+        {10, H - 3, {0, 0, W, H}},
+        {-2, H - 6, {0, 0, W, H}},
+        {38, 18, {40, 20, 50, 30}},
+        {86, 46, {40, 20, 50, 30}},
+    };
+
+    for (const auto &k : cases)
+    {
+      for (int c = 32; c <= LAST; c++)
+      {
+        cell.fillSprite(0);
+        cell.drawChar(0, 0, (uint16_t)c, fg, bg, 1);
+
+        tft.resetViewport();
+        tft.setViewport(k.vp.x, k.vp.y, k.vp.w, k.vp.h, false);
+        spiWire().reset();
+        tft.drawChar(k.x, k.y, (uint16_t)c, fg, bg, 1);
+
+        std::vector<uint16_t> expected(SpiWire::WIDTH * SpiWire::HEIGHT, 0);
+        for (int j = 0; j < 8; j++)
+        {
+          for (int i = 0; i < 6; i++)
+          {
+            const int px = k.x + i, py = k.y + j;
+            if (px >= 0 && py >= 0 && px < W && py < H && k.vp.contains(px, py))
+              expected[py * SpiWire::WIDTH + px] = cell.readPixel(i, j);
+          }
+        }
+
+        INFO("character " << c << " at " << k.x << "," << k.y);
+        REQUIRE(frameDiff(spiWire().frame(), expected) == "");
+      }
+    }
+    cell.deleteSprite();
+  }
+}
@@ -0,0 +1,87 @@
+#include <catch.hpp>
+#include <Replay.h>
+#include <stdio.h>
+#include <string>
+#include <vector>
+#include "TestView.h"
+
+static uint16_t background[SW * SH];
+static uint8_t planeMask[PW / 8 * PH];
+static uint16_t planeOffsets[360];
+
+static std::string snapshot(double now, bool withPlane)
+{
+  std::string body = "{\"now\":" + std::to_string(now) + ",\"aircraft\":[";
+  if (withPlane)
+    body += "{\"hex\":\"4b1234\",\"track\":90.0,\"lat\":46.47,\"lon\":6.48,\"seen_pos\":0.5,\"seen\":0.1}";
+  return body + "]}";
+}
+
+TEST_CASE("Capture round trip")
+{
+  const char *path = "Replay_test.cap";
+  CaptureWriter out;
+  REQUIRE(out.open(path));
+  REQUIRE(out.append(0, "{}"));
+  REQUIRE(out.append(1500, std::string("a\nb\0c", 5)));
+  REQUIRE(out.append(1500, ""));
+  REQUIRE(out.close());
+
+  CaptureReader in;
+  REQUIRE(in.open(path));
+  Snapshot s;
+  REQUIRE(in.next(s));
+  REQUIRE(s.ms == 0);
+  REQUIRE(s.body == "{}");
+  REQUIRE(in.next(s));
+  REQUIRE(s.ms == 1500);
+  REQUIRE(s.body == std::string("a\nb\0c", 5));
+  REQUIRE(in.next(s));
+  REQUIRE(s.body.empty());
+  REQUIRE_FALSE(in.next(s));
+  REQUIRE_FALSE(in.failed());
+  in.close();
+
+  remove(path);
+  REQUIRE_FALSE(in.open(path));
+}
+
+TEST_CASE("ReplayDriver")
+{
+  // A plane seen for 3 s, then 30 s of empty snapshots
+  const char *path = "Replay_test.cap";
+  CaptureWriter out;
+  REQUIRE(out.open(path));
+  for (uint32_t s = 0; s <= 33; s++)
+    REQUIRE(out.append(s * 1000 + 200, snapshot(1718000000.0 + s, s < 3)));
+  REQUIRE(out.close());
+
+  CaptureReader in;
+  REQUIRE(in.open(path));
+  memset(planeMask, 0xFF, sizeof(planeMask));
+  const RenderAssets assets = {background, planeMask, planeOffsets, PW / 8};
+  ReplayDriver driver(in, PixelFormat::Rgb565, TEST_VIEW, assets);
+
+  std::vector<ReplayFrame> frames;
+  const unsigned long fetches = driver.run([&](const ReplayFrame &f)
+                                           { frames.push_back(f); });
+  remove(path);
+
+  // t=0 is before the first snapshot; the last one is served at t=34000
+  REQUIRE(fetches == 35);
+  REQUIRE_FALSE(frames[0].ok);
+  REQUIRE(frames[0].report.httpCode == 404);
+  REQUIRE(frames[0].spi.bytes() == 0);
+
+  REQUIRE(frames[1].ok);
+  REQUIRE(frames[1].drawn == 1);
+  REQUIRE(frames[1].spi.pixelBytes > 0);
+
+  // Last update at t=3000, dropped once TRACK_TTL_MS has passed
+  const uint32_t lastSeen = 3000;
+  for (size_t i = 1; i < frames.size(); i++)
+  {
+    INFO("t=" << frames[i].ms);
+    REQUIRE(frames[i].tracks == (frames[i].ms > lastSeen + TRACK_TTL_MS ? 0 : 1));
+  }
+}
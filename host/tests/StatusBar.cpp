@@ -0,0 +1,103 @@
+#include <catch.hpp>
+#include <HB9IIU_StatusBar.h>
+#include <EmulatorDisplay.h>
+#include <HostPlatform.h>
+#include <string.h>
+#include <pgmspace.h>
+#include <Fonts/glcdfont.c> // TFT_eSPI's, for the copy in HB9IIU_Font.cpp
+
+static const int TEXT_Y = (BOTTOM_H - 8) / 2 + BOTTOM_TEXT_Y_OFFSET;
+
+// The bar as the old drawString() code drew it
+static void drawReference(TftEmulator &tft, const char *text)
+{
+  EmulatorDisplay display(tft);
+  display.startWrite();
+  display.fillRect(0, SH - BOTTOM_H, SW, BOTTOM_H, RGB565_BLACK);
+  display.drawString(text, BOTTOM_LEFT_MARGIN, SH - BOTTOM_H + TEXT_Y, RGB565_WHITE, RGB565_BLACK);
+  display.endWrite();
+}
+
+static bool sameBar(const TftEmulator &a, const TftEmulator &b)
+{
+  const size_t offset = (size_t)(SH - BOTTOM_H) * SW;
+  return memcmp(a.framebuffer() + offset, b.framebuffer() + offset,
+                (size_t)BOTTOM_H * SW * sizeof(uint16_t)) == 0;
+}
+
+TEST_CASE("StatusBar")
+{
+  const char *first = "Tot 12  Pos 9  Drw 4 | NEAR SWR12 3.2km | FAR 88.0km | MAX ALT 11000m";
+  const char *second = "Tot 12  Pos 9  Drw 5 | NEAR SWR12 3.4km | FAR 88.0km | MAX ALT 11000m";
+
+  SECTION("the bitmap bar has the pixels of drawString(), also after a diff")
+  {
+    TftEmulator tft(PixelFormat::Rgb565), ref(PixelFormat::Rgb565);
+    EmulatorDisplay display(tft);
+    StatusBar bar(display);
+
+    display.startWrite();
+    bar.drawTextDiff(first);
+    display.endWrite();
+    drawReference(ref, first);
+    REQUIRE(sameBar(tft, ref));
+
+    display.startWrite();
+    bar.drawTextDiff(second);
+    display.endWrite();
+    drawReference(ref, second);
+    REQUIRE(sameBar(tft, ref));
+  }
+
+  SECTION("only the changed column blocks of the text rows are pushed")
+  {
+    NullDisplay display;
+    StatusBar bar(display);
+
+    bar.drawTextDiff(first);
+    REQUIRE(display.counters().pushImage == BOTTOM_H); // whole bar, a row at a time
+    REQUIRE(display.counters().pixels == (unsigned long)SW * BOTTOM_H);
+
+    display.resetCounters();
+    bar.drawTextDiff(first);
+    REQUIRE(display.counters().pushImage == 0);
+
+    // Two characters changed, far apart: two runs of at most two blocks
+    display.resetCounters();
+    bar.drawTextDiff(second);
+    REQUIRE(display.counters().pushImage == 2 * 8);
+    REQUIRE(display.counters().pixels <= 2 * 8 * 2 * StatusBar::BLOCK);
+    REQUIRE(display.counters().drawString == 0);
+  }
+
+  SECTION("a proportional font is narrower")
+  {
+    REQUIRE(fontTextWidth(GLCD_FONT, "Hi 1") == 4 * 6);
+    // 'H' 5 columns, 'i' 3, space 3, '1' 3, each plus one blank column
+    REQUIRE(fontTextWidth(GLCD_FONT_PROPORTIONAL, "Hi 1") == 6 + 4 + 3 + 4);
+
+    // 'i' is drawn from its first inked column
+    REQUIRE(fontInkOffset(GLCD_FONT, 'i') == 0);
+    REQUIRE(fontInkOffset(GLCD_FONT_PROPORTIONAL, 'i') == -1);
+
+    NullDisplay display;
+    StatusBar bar(display);
+    bar.setFont(GLCD_FONT_PROPORTIONAL);
+    bar.drawTextDiff("iiii");
+    display.resetCounters();
+    bar.drawTextDiff("iiij");
+    REQUIRE(display.counters().pushImage == 8);
+  }
+
+  SECTION("the GLCD font is TFT_eSPI's, characters 32..126")
+  {
+    REQUIRE(GLCD_FONT.first == ' ');
+    REQUIRE(GLCD_FONT.last == '~');
+    for (int c = ' '; c <= '~'; c++)
+    {
+      INFO("character " << c);
+      for (int i = 0; i < 5; i++)
+        REQUIRE(fontColumn(GLCD_FONT, (char)c, i) == font[c * 5 + i]);
+    }
+  }
+}
@@ -0,0 +1,5 @@
+#pragma once
+#include <HB9IIU_Geo.h>
+
+// Config.h's home and map window: home projects to the screen center (240,160)
+static const MapView TEST_VIEW = {46.47171849999999, 6.476770899999999, 8, 33707.06016028444, 23031.052289240848};
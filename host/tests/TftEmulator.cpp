@@ -0,0 +1,282 @@
+#include <catch.hpp>
+#include <stdio.h>
+#include <EmulatorDisplay.h>
+
+TEST_CASE("TftEmulator cost model")
+{
+  TftEmulator tft(PixelFormat::Rgb565);
+
+  SECTION("setWindow() is three commands and eight parameter bytes")
+  {
+    tft.setWindow(0, 0, 9, 9);
+    REQUIRE(tft.cost().commands == 3);
+    REQUIRE(tft.cost().windows == 1);
+    REQUIRE(tft.cost().commandBytes == 11);
+    REQUIRE(tft.cost().pixelBytes == 0);
+  }
+
+  SECTION("fillRect() is one window and w*h pixels")
+  {
+    tft.fillRect(10, 20, 30, 40, 0xF800);
+    REQUIRE(tft.cost().windows == 1);
+    REQUIRE(tft.cost().pixelBytes == 30 * 40 * 2);
+    REQUIRE(tft.cost().transactions == 1);
+    REQUIRE(tft.readPixel(10, 20) == 0xF800);
+    REQUIRE(tft.readPixel(39, 59) == 0xF800);
+    REQUIRE(tft.readPixel(40, 59) == 0);
+  }
+
+  SECTION("18-bit panels send three bytes per pixel")
+  {
+    TftEmulator ili(PixelFormat::Rgb666);
+    ili.fillRect(0, 0, 10, 10, 0xFFFF);
+    REQUIRE(ili.cost().pixelBytes == 300);
+  }
+
+  SECTION("primitives are clipped to the screen")
+  {
+    tft.fillRect(-10, -10, 20, 20, 0x07E0);
+    REQUIRE(tft.cost().pixelBytes == 10 * 10 * 2);
+
+    tft.resetCost();
+    tft.drawFastHLine(TftEmulator::WIDTH, 0, 10, 0x07E0);
+    REQUIRE(tft.cost().commands == 0);
+  }
+
+  SECTION("pushImage() clips the source rows")
+  {
+    uint16_t img[4 * 4];
+    for (int i = 0; i < 16; i++)
+      img[i] = (uint16_t)i;
+
+    tft.pushImage(-1, -2, 4, 4, img);
+    REQUIRE(tft.cost().windows == 1);
+    REQUIRE(tft.cost().pixelBytes == 3 * 2 * 2);
+    REQUIRE(tft.readPixel(0, 0) == 9);
+    REQUIRE(tft.readPixel(2, 1) == 15);
+  }
+
+  SECTION("drawRect() is four lines in one transaction")
+  {
+    tft.drawRect(0, 0, 10, 5, 0x001F);
+    REQUIRE(tft.cost().windows == 4);
+    REQUIRE(tft.cost().transactions == 1);
+    REQUIRE(tft.cost().pixelBytes == (10 + 10 + 3 + 3) * 2);
+    REQUIRE(tft.readPixel(0, 2) == 0x001F);
+    REQUIRE(tft.readPixel(5, 2) == 0);
+  }
+
+  SECTION("startWrite() holds CS across primitives")
+  {
+    tft.startWrite();
+    tft.fillRect(0, 0, 1, 1, 0);
+    tft.fillRect(1, 1, 1, 1, 0);
+    tft.endWrite();
+    REQUIRE(tft.cost().transactions == 1);
+
+    tft.fillRect(0, 0, 1, 1, 0);
+    REQUIRE(tft.cost().transactions == 2);
+  }
+
+  SECTION("drawPixel() only re-sends the address that changed")
+  {
+    tft.drawPixel(5, 5, 0xFFFF);
+    REQUIRE(tft.cost().commands == 3);
+    tft.drawPixel(6, 5, 0xFFFF);
+    REQUIRE(tft.cost().commands == 5);
+    tft.setWindow(0, 0, 1, 1);
+    tft.drawPixel(6, 5, 0xFFFF);
+    REQUIRE(tft.cost().commands == 11);
+  }
+
+  SECTION("setWindow() leaves out the range the controller already has")
+  {
+    tft.setWindow(10, 0, 19, 0);
+    tft.setWindow(10, 1, 19, 1); // row by row: PASET only
+    REQUIRE(tft.cost().commands == 3 + 2);
+    REQUIRE(tft.cost().addressSaved == 5);
+    tft.setWindow(10, 1, 19, 1); // same window: RAMWR only
+    REQUIRE(tft.cost().commands == 3 + 2 + 1);
+    REQUIRE(tft.cost().windows == 3);
+    REQUIRE(tft.cost().addressSaved == 15);
+
+    tft.invalidateWindow();
+    tft.setWindow(10, 1, 19, 1);
+    REQUIRE(tft.cost().commands == 3 + 2 + 1 + 3);
+  }
+
+  SECTION("drawPixel() and setWindow() share the controller's address")
+  {
+    tft.setWindow(7, 0, 7, 9);
+    tft.drawPixel(7, 3, 0xFFFF); // column already set
+    REQUIRE(tft.cost().commands == 3 + 2);
+    tft.setWindow(7, 3, 7, 3); // both already set
+    REQUIRE(tft.cost().commands == 3 + 2 + 1);
+  }
+
+  SECTION("drawSpans() only addresses what changed")
+  {
+    tft_span_t spans[] = {
+        {20, 6, 2},
+        {10, 5, 4},
+        {20, 7, 2},
+        {10, 6, 4},
+        {20, 5, 2},
+        {-3, 8, 5},
+    };
+    tft.drawSpans(spans, 6, 0xF800);
+
+    // Sorted by row then column:
+    // (10,5) CASET PASET RAMWR, (20,5) CASET RAMWR, (10,6) CASET PASET RAMWR,
+    // (20,6) CASET RAMWR, (20,7) nothing: the panel wrapped there,
+    // (0,8) clipped to 2 pixels, CASET PASET RAMWR
+    REQUIRE(tft.cost().windows == 5);
+    REQUIRE(tft.cost().commands == 13);
+    REQUIRE(tft.cost().transactions == 1);
+    REQUIRE(tft.cost().pixelBytes == (4 + 4 + 2 + 2 + 2 + 2) * 2);
+    REQUIRE(spans[0].y == 5);
+    REQUIRE(tft.readPixel(13, 6) == 0xF800);
+    REQUIRE(tft.readPixel(21, 7) == 0xF800);
+    REQUIRE(tft.readPixel(1, 8) == 0xF800);
+    REQUIRE(tft.readPixel(2, 8) == 0);
+  }
+
+  SECTION("drawSpans() streams rows with the same columns")
+  {
+    tft_span_t spans[32];
+    for (int i = 0; i < 32; i++)
+      spans[i] = {100, 50 + i, 8};
+    tft.drawSpans(spans, 32, 0x07E0);
+
+    REQUIRE(tft.cost().windows == 1);
+    REQUIRE(tft.cost().commands == 3);
+  }
+
+  SECTION("wire time")
+  {
+    tft.fillRect(0, 0, TftEmulator::WIDTH, TftEmulator::HEIGHT, 0);
+    // 307211 bytes at 55 MHz
+    REQUIRE(tft.cost().wireMicros(SPI_HZ_ST7796) == Approx(44685.2).epsilon(1e-4));
+  }
+}
+
+TEST_CASE("TftEmulator::pushMask()")
+{
+  TftEmulator tft(PixelFormat::Rgb565);
+  const uint8_t mask[2 * 3] = {0x80, 0x01, 0x00, 0x00, 0xFF, 0xFF}; // 9x3, stride 2
+  uint16_t bg[9 * 3];
+  for (int i = 0; i < 9 * 3; i++)
+    bg[i] = (uint16_t)(100 + i);
+
+  SECTION("over a colour: one window")
+  {
+    tft.pushMask(10, 10, 9, 3, mask, 2, 0xF800, 0x001F);
+    REQUIRE(tft.cost().windows == 1);
+    REQUIRE(tft.cost().pixelBytes == 9 * 3 * 2);
+    REQUIRE(tft.readPixel(10, 10) == 0xF800);
+    REQUIRE(tft.readPixel(11, 10) == 0x001F);
+    REQUIRE(tft.readPixel(17, 10) == 0x001F);
+    REQUIRE(tft.readPixel(18, 12) == 0xF800);
+  }
+
+  SECTION("over an image, clipped")
+  {
+    tft.pushMask(-1, -1, 9, 3, mask, 2, 0xF800, bg, 9);
+    REQUIRE(tft.cost().pixelBytes == 8 * 2 * 2);
+    REQUIRE(tft.readPixel(0, 0) == 100 + 9 + 1);
+    REQUIRE(tft.readPixel(7, 1) == 0xF800);
+  }
+}
+
+TEST_CASE("TftEmulator text")
+{
+  TftEmulator tft(PixelFormat::Rgb565);
+
+  SECTION("an opaque character is one 6x8 block")
+  {
+    tft.setTextColor(0xFFFF, 0x0001);
+    REQUIRE(tft.drawString("AB", 10, 10) == 12);
+    REQUIRE(tft.cost().windows == 2);
+    REQUIRE(tft.cost().pixelBytes == 2 * 48 * 2);
+    // the sixth column of the cell is background
+    REQUIRE(tft.readPixel(15, 10) == 1);
+  }
+
+  SECTION("a transparent character is one drawPixel() per set pixel")
+  {
+    tft.setTextColor(0xFFFF, 0xFFFF);
+    tft.drawString("-", 10, 10);
+    // '-' is 5 set pixels on one row
+    REQUIRE(tft.cost().pixelBytes == 5 * 2);
+    REQUIRE(tft.cost().windows == 0);
+    REQUIRE(tft.cost().transactions == 1);
+  }
+
+  SECTION("a character across the right edge is clipped to one block")
+  {
+    tft.setTextColor(0xFFFF, 0x0001);
+    tft.drawString("X", TftEmulator::WIDTH - 4, 0);
+    REQUIRE(tft.cost().windows == 1);
+    REQUIRE(tft.cost().pixelBytes == 4 * 8 * 2);
+  }
+}
+
+TEST_CASE("TftEmulator text on an 18-bit panel")
+{
+  // drawChar() doesn't use pushMask() with SPI_18BIT_DRIVER
+  TftEmulator tft(PixelFormat::Rgb666);
+  tft.setTextColor(0xFFFF, 0x0001);
+
+  SECTION("an opaque character is one 6x8 block")
+  {
+    tft.drawString("A", 10, 10);
+    REQUIRE(tft.cost().windows == 1);
+    REQUIRE(tft.cost().pixelBytes == 48 * 3);
+    REQUIRE(tft.readPixel(15, 10) == 1);
+  }
+
+  SECTION("a character touching the right edge falls back to pixels")
+  {
+    tft.drawString("X", TftEmulator::WIDTH - 6, 0);
+    REQUIRE(tft.cost().windows == 48);
+    REQUIRE(tft.cost().pixelBytes == 48 * 3);
+  }
+}
+
+TEST_CASE("EmulatorDisplay")
+{
+  TftEmulator tft(PixelFormat::Rgb565);
+  EmulatorDisplay display(tft);
+
+  display.startWrite();
+  display.drawString("HB9IIU", 0, 300, 0xFFFF, 0x0000);
+  display.drawFastHLine(0, 299, 480, 0x7BEF);
+  display.endWrite();
+
+  REQUIRE(tft.cost().transactions == 1);
+  REQUIRE(tft.cost().windows == 6 + 1);
+  REQUIRE(tft.readPixel(479, 299) == 0x7BEF);
+}
+
+TEST_CASE("TftEmulator::writePng()")
+{
+  TftEmulator tft;
+  tft.fillRect(0, 0, 100, 100, 0xF800);
+
+  const char *path = "TftEmulator_test.png";
+  REQUIRE(tft.writePng(path));
+
+  FILE *f = fopen(path, "rb");
+  REQUIRE(f != nullptr);
+  unsigned char head[8];
+  REQUIRE(fread(head, 1, 8, f) == 8);
+  fseek(f, 0, SEEK_END);
+  const long size = ftell(f);
+  fclose(f);
+  remove(path);
+
+  REQUIRE(head[0] == 0x89);
+  REQUIRE(head[1] == 'P');
+  // signature + IHDR + IEND + IDAT holding 320 rows of 1 + 480*3 bytes in 64K blocks
+  REQUIRE(size > 320 * (1 + 480 * 3));
+}
@@ -0,0 +1,56 @@
+#include <catch.hpp>
+#include <HB9IIU_Touch.h>
+
+TEST_CASE("touchMedian()")
+{
+  uint16_t v[5] = {900, 12, 410, 400, 405};
+  REQUIRE(touchMedian(v, 5) == 405);
+
+  uint16_t one[1] = {7};
+  REQUIRE(touchMedian(one, 1) == 7);
+}
+
+TEST_CASE("TouchGestures")
+{
+  TouchGestures g;
+  TouchEvent e;
+
+  SECTION("a short press is a tap where the finger went down")
+  {
+    REQUIRE_FALSE(g.down(1000, 100, 50, e));
+    REQUIRE_FALSE(g.down(1010, 103, 52, e)); // within DRAG_SLOP
+    REQUIRE(g.pressed());
+    REQUIRE(g.up(e));
+    REQUIRE(e.type == TouchEvent::Tap);
+    REQUIRE(e.x == 100);
+    REQUIRE(e.y == 50);
+    REQUIRE_FALSE(g.pressed());
+    REQUIRE_FALSE(g.up(e));
+  }
+
+  SECTION("holding still repeats LongPress, and is no tap")
+  {
+    g.down(0, 10, 10, e);
+    REQUIRE_FALSE(g.down(TouchGestures::LONG_PRESS_MS - 1, 10, 10, e));
+    REQUIRE(g.down(TouchGestures::LONG_PRESS_MS, 10, 10, e));
+    REQUIRE(e.type == TouchEvent::LongPress);
+    REQUIRE_FALSE(g.down(TouchGestures::LONG_PRESS_MS + TouchGestures::REPEAT_MS - 1, 10, 10, e));
+    REQUIRE(g.down(TouchGestures::LONG_PRESS_MS + TouchGestures::REPEAT_MS, 10, 10, e));
+    REQUIRE(e.type == TouchEvent::LongPress);
+    REQUIRE_FALSE(g.up(e));
+  }
+
+  SECTION("moving past DRAG_SLOP drags, with the movement of each sample")
+  {
+    g.down(0, 10, 10, e);
+    REQUIRE(g.down(10, 10, 10 + TouchGestures::DRAG_SLOP + 1, e));
+    REQUIRE(e.type == TouchEvent::Drag);
+    REQUIRE(e.dy == TouchGestures::DRAG_SLOP + 1);
+    REQUIRE(g.down(20, 15, 30, e));
+    REQUIRE(e.dx == 5);
+    REQUIRE(e.y == 30);
+    REQUIRE_FALSE(g.down(30, 15, 30, e)); // didn't move
+    REQUIRE_FALSE(g.down(TouchGestures::LONG_PRESS_MS * 2, 15, 30, e));
+    REQUIRE_FALSE(g.up(e));
+  }
+}
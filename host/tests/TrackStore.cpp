@@ -0,0 +1,151 @@
+#include <catch.hpp>
+#include <stdio.h>
+#include <string>
+#include <HB9IIU_TrackStore.h>
+#include "Aircraft.h"
+#include "TestView.h"
+
+static const double LAT = TEST_VIEW.homeLat;
+static const double LON = TEST_VIEW.homeLon;
+
+TEST_CASE("TrackStore::accept()")
+{
+  static TrackStore store(TEST_VIEW);
+  FetchStats st;
+  TrackFix fix;
+
+  SECTION("fresh aircraft near home")
+  {
+    REQUIRE(store.accept(makeAircraft("4b1234", LAT, LON), st, fix));
+    REQUIRE(fix.sx == 240);
+    REQUIRE(fix.sy == 160);
+    REQUIRE(st.totalRaw == 1);
+    REQUIRE(st.totalShown == 1);
+    REQUIRE(st.withPos == 1);
+    REQUIRE(st.fresh == 1);
+    REQUIRE(st.within == 1);
+  }
+
+  SECTION("no hex")
+  {
+    AircraftFields a = makeAircraft("", LAT, LON);
+    REQUIRE_FALSE(store.accept(a, st, fix));
+    REQUIRE(st.totalRaw == 1);
+    REQUIRE(st.totalShown == 0);
+  }
+
+  SECTION("no position")
+  {
+    AircraftFields a = makeAircraft("4b1234", LAT, LON);
+    a.present &= ~AF_LON;
+    REQUIRE_FALSE(store.accept(a, st, fix));
+    REQUIRE(st.totalShown == 1);
+    REQUIRE(st.withPos == 0);
+  }
+
+  SECTION("stale position")
+  {
+    AircraftFields a = makeAircraft("4b1234", LAT, LON);
+    a.seen_pos_d10 = MAX_SEEN_POS_D10 + 1;
+    REQUIRE_FALSE(store.accept(a, st, fix));
+    REQUIRE(st.withPos == 1);
+    REQUIRE(st.fresh == 0);
+  }
+
+  SECTION("out of range")
+  {
+    REQUIRE_FALSE(store.accept(makeAircraft("4b1234", LAT + 5.0, LON), st, fix));
+    REQUIRE(st.fresh == 1);
+    REQUIRE(st.within == 0);
+  }
+
+  SECTION("in range but off screen")
+  {
+    REQUIRE_FALSE(store.accept(makeAircraft("4b1234", LAT + 2.0, LON), st, fix));
+    REQUIRE(st.within == 1);
+  }
+}
+
+TEST_CASE("TrackStore::assign()")
+{
+  static TrackStore store(TEST_VIEW);
+  FetchStats st;
+  TrackFix fix;
+
+  AircraftFields a = makeAircraft("4b1234", LAT, LON);
+  strcpy(a.flight, " SWR12  ");
+  a.track_d10 = 3595;  // 359.5 rounds to 360, i.e. 0
+  a.alt_baro = 35000;  // feet
+  a.present |= AF_FLIGHT | AF_TRACK | AF_ALT_BARO;
+  REQUIRE(store.accept(a, st, fix));
+
+  const int idx = store.slotFor(a.hex);
+  store.assign(idx, a, fix, 1234);
+
+  const Track &t = store[idx];
+  REQUIRE(t.used);
+  REQUIRE(std::string(t.hex) == "4b1234");
+  REQUIRE(std::string(t.flight) == "SWR12");
+  REQUIRE(t.headingDeg == 0);
+  REQUIRE(t.altitude_m == 10668);
+  REQUIRE(t.color == ALT_COLOR_L4);
+  REQUIRE(t.lastUpdateMs == 1234);
+  REQUIRE(store.findTrackByHex("4b1234") == idx);
+  REQUIRE(std::string(trackLabel(t)) == "SWR12");
+}
+
+TEST_CASE("TrackStore::allocTrackSlot() recycles the oldest track")
+{
+  static TrackStore store(TEST_VIEW);
+  FetchStats st;
+  TrackFix fix;
+  char hex[7];
+
+  for (int i = 0; i < MAX_TRACKS; i++)
+  {
+    snprintf(hex, sizeof(hex), "%06x", i);
+    AircraftFields a = makeAircraft(hex, LAT, LON);
+    REQUIRE(store.accept(a, st, fix));
+    REQUIRE(store.slotFor(hex) == i);
+    store.assign(i, a, fix, i == 42 ? 1 : 1000 + i);
+  }
+
+  REQUIRE(store.slotFor("abcdef") == 42);
+  REQUIRE(store.slotFor("000007") == 7);
+}
+
+TEST_CASE("TrackStore::buildDrawList()")
+{
+  static TrackStore store(TEST_VIEW);
+  FetchStats st;
+  TrackFix fix;
+  int list[MAX_DRAW];
+
+  auto add = [&](const char *hex, double lat, double lon, int32_t altFt, uint32_t nowMs)
+  {
+    AircraftFields a = makeAircraft(hex, lat, lon);
+    if (altFt >= 0)
+    {
+      a.alt_baro = altFt;
+      a.present |= AF_ALT_BARO;
+    }
+    REQUIRE(store.accept(a, st, fix));
+    int idx = store.slotFor(hex);
+    store.assign(idx, a, fix, nowMs);
+    return idx;
+  };
+
+  const int high = add("000001", LAT, LON, 30000, 1000);
+  const int low = add("000002", LAT + 0.1, LON, 2000, 1000);
+  const int unknown = add("000003", LAT - 0.1, LON, -1, 1000);
+  add("000004", LAT + 0.5, LON, 1000, 1000);  // under the legend bar
+  add("000005", LAT - 0.6, LON, 1000, 1000);  // over the bottom bar
+  add("000006", LAT, LON + 0.1, 1000, 0);     // position too old
+
+  const int n = store.buildDrawList(31000, list, MAX_DRAW);
+
+  REQUIRE(n == 3);
+  REQUIRE(list[0] == unknown);
+  REQUIRE(list[1] == low);
+  REQUIRE(list[2] == high);
+}
@@ -0,0 +1,87 @@
+#include <catch.hpp>
+#include <HB9IIU_AircraftDecoder.h>
+#include <HB9IIU_Geo.h>
+#include <TrafficSim.h>
+#include <map>
+#include <string>
+
+struct Decoded
+{
+  double now = 0;
+  std::map<std::string, AircraftFields> aircraft;
+};
+
+static Decoded decode(TrafficSim &sim)
+{
+  std::string body;
+  sim.aircraftJson(body);
+  Decoded d;
+  DeserializationError err = decodeAircraftJson(body.data(), body.size(), d.now, [&](const AircraftFields &a)
+                                                { d.aircraft[a.hex] = a; });
+  REQUIRE(err == DeserializationError::Ok);
+  return d;
+}
+
+TEST_CASE("TrafficSim")
+{
+  TrafficOptions opt;
+  opt.aircraft = 500;
+  opt.radiusKm = 200;
+  opt.missingPosition = 0.2;
+  TrafficSim sim(opt);
+
+  SECTION("serves every aircraft once, around home")
+  {
+    Decoded d = decode(sim);
+    REQUIRE(d.now == 1718000000.0);
+    REQUIRE(d.aircraft.size() == 500);
+
+    int withPos = 0;
+    for (const auto &kv : d.aircraft)
+    {
+      const AircraftFields &a = kv.second;
+      if (!(a.present & AF_LAT))
+        continue;
+      withPos++;
+      REQUIRE(haversine_km(opt.homeLat, opt.homeLon, a.lat_e6 / 1e6, a.lon_e6 / 1e6) <= opt.radiusKm + 1);
+      REQUIRE(a.seen_pos_d10 <= 10 * opt.posIntervalS);
+    }
+    // 20% are Mode-S only
+    REQUIRE(withPos > 350);
+    REQUIRE(withPos < 450);
+  }
+
+  SECTION("aircraft move, and leavers are replaced")
+  {
+    Decoded before = decode(sim);
+    sim.advance(3600);
+    Decoded after = decode(sim);
+
+    REQUIRE(after.now == 1718003600.0);
+    REQUIRE(after.aircraft.size() == 500);
+
+    int stayed = 0, moved = 0;
+    for (const auto &kv : after.aircraft)
+    {
+      auto it = before.aircraft.find(kv.first);
+      if (it == before.aircraft.end())
+        continue;
+      stayed++;
+      if ((kv.second.present & AF_LAT) && kv.second.lat_e6 != it->second.lat_e6)
+        moved++;
+    }
+    REQUIRE(stayed < 500);
+    REQUIRE(moved > 0);
+  }
+
+  SECTION("same seed, same traffic")
+  {
+    TrafficSim other(opt);
+    sim.advance(10);
+    other.advance(10);
+    std::string a, b;
+    sim.aircraftJson(a);
+    other.aircraftJson(b);
+    REQUIRE(a == b);
+  }
+}
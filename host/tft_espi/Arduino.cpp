@@ -0,0 +1,120 @@
+// The Arduino core, SPI, file system and ESP-IDF SPI master calls of the
+// host build of TFT_eSPI
+
+#include <TFT_eSPI.h>
+#include <stdio.h>
+
+#include <chrono>
+#include <deque>
+
+// ===== Arduino core =====
+void pinMode(int, int) {}
+
+void digitalWrite(int pin, int level)
+{
+  if (pin == TFT_DC)
+    spiWire().setDc(level);
+}
+
+int digitalRead(int) { return HIGH; }
+
+// Fixed sequence, so dithered drawing repeats
+long random(long howbig)
+{
+  static uint32_t state = 1;
+  state = state * 1103515245 + 12345;
+  return howbig > 0 ? (long)((state >> 8) % howbig) : 0;
+}
+
+long random(long howsmall, long howbig) { return howsmall + random(howbig - howsmall); }
+
+char *ltoa(long value, char *str, int radix)
+{
+  if (radix == 16)
+    sprintf(str, "%lx", value);
+  else
+    sprintf(str, "%ld", value);
+  return str;
+}
+
+void delay(uint32_t) {}
+void delayMicroseconds(uint32_t) {}
+void yield() {}
+
+uint32_t millis() { return micros() / 1000; }
+
+uint32_t micros()
+{
+  static const auto start = std::chrono::steady_clock::now();
+  return (uint32_t)std::chrono::duration_cast<std::chrono::microseconds>(
+             std::chrono::steady_clock::now() - start)
+      .count();
+}
+
+class HostSerial : public Print
+{
+public:
+  size_t write(uint8_t c) override { return fputc(c, stderr) == EOF ? 0 : 1; }
+};
+
+static HostSerial hostSerial;
+Print &Serial = hostSerial;
+
+SPIClass SPI;
+fs::FS SPIFFS;
+
+// ===== ESP-IDF SPI master =====
+spi_device_handle_t dmaHAL = nullptr;
+
+static std::deque<spi_transaction_t *> queued;
+
+esp_err_t spi_device_queue_trans(spi_device_handle_t, spi_transaction_t *trans, uint32_t)
+{
+  if (queued.size() >= TFT_DMA_QUEUE)
+  {
+    fprintf(stderr, "spi_device_queue_trans: queue full, would block forever\n");
+    abort();
+  }
+  for (spi_transaction_t *t : queued)
+  {
+    if (t == trans)
+    {
+      fprintf(stderr, "spi_device_queue_trans: transaction queued twice\n");
+      abort();
+    }
+  }
+  if (!(trans->flags & SPI_TRANS_USE_TXDATA) && ((uintptr_t)trans->tx_buffer & 3))
+  {
+    fprintf(stderr, "spi_device_queue_trans: DMA buffer not 4 byte aligned\n");
+    abort();
+  }
+  queued.push_back(trans);
+  return ESP_OK;
+}
+
+esp_err_t spi_device_get_trans_result(spi_device_handle_t, spi_transaction_t **trans, uint32_t)
+{
+  if (queued.empty())
+  {
+    fprintf(stderr, "spi_device_get_trans_result: nothing queued, would block forever\n");
+    abort();
+  }
+  spi_transaction_t *t = queued.front();
+  queued.pop_front();
+
+  spiWire().setDc(t->user != nullptr);
+  const uint8_t *p = (t->flags & SPI_TRANS_USE_TXDATA) ? t->tx_data : (const uint8_t *)t->tx_buffer;
+  for (uint32_t i = 0; i < t->length / 8; i++)
+    spiWire().write(p[i]);
+
+  if ((uintptr_t)t->user > 1)
+  {
+    tft_dl_job_t *job = (tft_dl_job_t *)t->user;
+    job->done(job->ctx);
+  }
+
+  *trans = t;
+  return ESP_OK;
+}
+
+uint32_t spiQueued() { return (uint32_t)queued.size(); }
@@ -0,0 +1,76 @@
+#pragma once
+
+// The part of the Arduino core that TFT_eSPI uses, for the host build of the
+// library. Pins only matter for TFT_DC, which SpiWire follows.
+
+#include <assert.h>
+#include <math.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include <algorithm>
+#include <string>
+
+#include <Print.h>
+
+#ifndef PROGMEM
+#define PROGMEM
+#endif
+
+typedef uint8_t byte;
+typedef bool boolean;
+
+#define LOW 0
+#define HIGH 1
+#define INPUT 0
+#define OUTPUT 1
+#define INPUT_PULLUP 2
+
+#define pgm_read_byte(addr) (*(const uint8_t *)(addr))
+#define pgm_read_word(addr) (*(const uint16_t *)(addr))
+#define pgm_read_dword(addr) (*(const uint32_t *)(addr))
+#define pgm_read_pointer(addr) (*(void *const *)(addr))
+
+void pinMode(int pin, int mode);
+void digitalWrite(int pin, int level);
+int digitalRead(int pin);
+#define digitalPinToBitMask(pin) (1UL << ((pin) & 31))
+
+void delay(uint32_t ms);
+void delayMicroseconds(uint32_t us);
+uint32_t millis();
+uint32_t micros();
+void yield();
+
+extern Print &Serial; // stderr
+
+using std::max;
+using std::min;
+
+long random(long howbig);
+long random(long howsmall, long howbig);
+char *ltoa(long value, char *str, int radix);
+
+// Enough of Arduino's String for TFT_eSPI's String overloads
+class String : public std::string
+{
+public:
+  String() {}
+  String(const char *s) : std::string(s ? s : "") {}
+  String(const std::string &s) : std::string(s) {}
+
+  unsigned int length() const { return (unsigned int)size(); }
+  void toCharArray(char *buf, unsigned int bufsize) const
+  {
+    if (!bufsize)
+      return;
+    size_t n = size() < bufsize - 1 ? size() : bufsize - 1;
+    memcpy(buf, data(), n);
+    buf[n] = 0;
+  }
+  bool endsWith(const String &s) const
+  {
+    return size() >= s.size() && compare(size() - s.size(), s.size(), s) == 0;
+  }
+  bool startsWith(const String &s) const { return compare(0, s.size(), s) == 0; }
+};
@@ -0,0 +1,79 @@
+#pragma once
+
+#include <memory>
+#include <stdint.h>
+#include <stdio.h>
+#include <string>
+
+// Arduino's file system API over a host directory, counting the reads so a
+// test can see when TFT_eSPI goes to the file
+namespace fs
+{
+
+enum SeekMode
+{
+  SeekSet = SEEK_SET,
+  SeekCur = SEEK_CUR,
+  SeekEnd = SEEK_END
+};
+
+class File
+{
+public:
+  File() {}
+  File(const std::shared_ptr<FILE> &f, const std::shared_ptr<uint32_t> &reads) : f_(f), reads_(reads) {}
+
+  explicit operator bool() const { return (bool)f_; }
+
+  int read()
+  {
+    uint8_t b;
+    return read(&b, 1) == 1 ? b : -1;
+  }
+  size_t read(uint8_t *buf, size_t size)
+  {
+    if (!f_)
+      return 0;
+    (*reads_)++;
+    return fread(buf, 1, size, f_.get());
+  }
+  bool seek(uint32_t pos, SeekMode mode) { return f_ && fseek(f_.get(), pos, mode) == 0; }
+  void close() { f_.reset(); }
+
+private:
+  std::shared_ptr<FILE> f_;
+  std::shared_ptr<uint32_t> reads_;
+};
+
+class FS
+{
+public:
+  explicit FS(const std::string &root = ".") : root_(root), reads_(new uint32_t(0)) {}
+
+  bool exists(const std::string &path) const
+  {
+    FILE *f = fopen((root_ + path).c_str(), "rb");
+    if (f)
+      fclose(f);
+    return f != nullptr;
+  }
+
+  File open(const std::string &path, const char * /*mode*/ = "r") const
+  {
+    FILE *f = fopen((root_ + path).c_str(), "rb");
+    if (!f)
+      return File();
+    return File(std::shared_ptr<FILE>(f, fclose), reads_);
+  }
+
+  // read() calls on the files opened from here
+  uint32_t reads() const { return *reads_; }
+
+private:
+  std::string root_;
+  std::shared_ptr<uint32_t> reads_;
+};
+
+} // namespace fs
+
+extern fs::FS SPIFFS;
@@ -0,0 +1,30 @@
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+#include <string>
+
+// Arduino's Print, as far as TFT_eSPI overrides and calls it
+class Print
+{
+public:
+  virtual ~Print() {}
+
+  virtual size_t write(uint8_t c) = 0;
+  virtual size_t write(const uint8_t *buffer, size_t size)
+  {
+    size_t n = 0;
+    while (size--)
+      n += write(*buffer++);
+    return n;
+  }
+
+  size_t write(const char *s) { return s ? write((const uint8_t *)s, strlen(s)) : 0; }
+  size_t print(const char *s) { return write(s); }
+  size_t print(char c) { return write((uint8_t)c); }
+  size_t print(const std::string &s) { return write((const uint8_t *)s.data(), s.size()); }
+  size_t println(const char *s) { return print(s) + print('\n'); }
+  size_t println(const std::string &s) { return print(s) + print('\n'); }
+  size_t println() { return print('\n'); }
+};
@@ -0,0 +1,48 @@
+#pragma once
+
+#include <stdint.h>
+
+#include "SpiWire.h"
+
+#define SPI_HAS_TRANSACTION
+#define SPI_MODE0 0
+#define MSBFIRST 1
+
+struct SPISettings
+{
+  SPISettings() {}
+  SPISettings(uint32_t, uint8_t, uint8_t) {}
+};
+
+// Arduino's SPI, sending every byte to SpiWire with the level of TFT_DC
+class SPIClass
+{
+public:
+  void begin() {}
+  void begin(int8_t, int8_t, int8_t, int8_t) {}
+  void end() {}
+  void beginTransaction(const SPISettings &) {}
+  void endTransaction() {}
+  void setFrequency(uint32_t) {}
+
+  uint8_t transfer(uint8_t data)
+  {
+    spiWire().write(data);
+    return 0;
+  }
+  uint16_t transfer16(uint16_t data)
+  {
+    spiWire().write(data >> 8);
+    spiWire().write(data & 0xFF);
+    return 0;
+  }
+  void transfer(void *buf, uint32_t count)
+  {
+    const uint8_t *p = (const uint8_t *)buf;
+    while (count--)
+      spiWire().write(*p++);
+  }
+  void writeBytes(const uint8_t *data, uint32_t size) { transfer((void *)data, size); }
+};
+
+extern SPIClass SPI;
@@ -0,0 +1,78 @@
+#include "SpiWire.h"
+
+static const uint8_t CASET = 0x2A;
+static const uint8_t PASET = 0x2B;
+static const uint8_t RAMWR = 0x2C;
+
+SpiWire &spiWire()
+{
+  static SpiWire wire;
+  return wire;
+}
+
+SpiWire::SpiWire()
+    : commands_(0), dc_(true), cmd_(0), nParam_(0), xs_(0), xe_(WIDTH - 1), ys_(0), ye_(HEIGHT - 1), x_(0), y_(0)
+{
+  reset();
+}
+
+void SpiWire::reset()
+{
+  bytes_.clear();
+  frame_.assign(WIDTH * HEIGHT, 0);
+  commands_ = 0;
+}
+
+void SpiWire::write(uint8_t b)
+{
+  bytes_.push_back((uint16_t)(dc_ << 8 | b));
+
+  if (!dc_)
+  {
+    commands_++;
+    cmd_ = b;
+    nParam_ = 0;
+    if (cmd_ == RAMWR)
+    {
+      x_ = xs_;
+      y_ = ys_;
+    }
+    return;
+  }
+
+  if (cmd_ == CASET || cmd_ == PASET)
+  {
+    if (nParam_ < 4)
+      param_[nParam_++] = b;
+    if (nParam_ == 4)
+    {
+      const int s = param_[0] << 8 | param_[1];
+      const int e = param_[2] << 8 | param_[3];
+      if (cmd_ == CASET)
+      {
+        xs_ = s;
+        xe_ = e;
+      }
+      else
+      {
+        ys_ = s;
+        ye_ = e;
+      }
+    }
+  }
+  else if (cmd_ == RAMWR)
+  {
+    // Two bytes a pixel, MSB first; the address wraps at the end of the window
+    param_[nParam_++] = b;
+    if (nParam_ < 2)
+      return;
+    nParam_ = 0;
+    if (y_ <= ye_ && x_ < WIDTH && y_ < HEIGHT)
+      frame_[y_ * WIDTH + x_] = (uint16_t)(param_[0] << 8 | param_[1]);
+    if (++x_ > xe_)
+    {
+      x_ = xs_;
+      y_++;
+    }
+  }
+}
@@ -0,0 +1,45 @@
+#pragma once
+
+#include <stdint.h>
+#include <vector>
+
+// What the host build of TFT_eSPI sends to the panel: every byte with the
+// level of DC, and the frame the ST7796 would show for them (CASET, PASET
+// and RAMWR with RGB565 pixels, in panel coordinates).
+class SpiWire
+{
+public:
+  static const int WIDTH = 480; // Panel memory, both rotations fit
+  static const int HEIGHT = 480;
+
+  SpiWire();
+
+  // Forget the bytes, the frame goes back to 0. The controller keeps its
+  // window, as TFT_eSPI's setWindow() expects
+  void reset();
+
+  void setDc(int level) { dc_ = level != 0; }
+  void write(uint8_t b);
+
+  // DC << 8 | byte, in the order sent
+  const std::vector<uint16_t> &bytes() const { return bytes_; }
+  uint32_t commands() const { return commands_; }
+
+  uint16_t pixel(int x, int y) const { return frame_[y * WIDTH + x]; }
+  const std::vector<uint16_t> &frame() const { return frame_; }
+
+private:
+  std::vector<uint16_t> bytes_;
+  std::vector<uint16_t> frame_;
+  uint32_t commands_;
+  bool dc_;
+
+  // Controller state
+  uint8_t cmd_;
+  uint8_t param_[4];
+  int nParam_;
+  int xs_, xe_, ys_, ye_;
+  int x_, y_;
+};
+
+SpiWire &spiWire();
@@ -0,0 +1,37 @@
+#pragma once
+
+#include <stdint.h>
+
+// The ESP-IDF SPI master calls of TFT_eSPI's display list (TFT_DL_DMA). A
+// queued transaction is only sent when its result is taken, as the oldest,
+// so a buffer or transaction reused too early shows on the wire.
+
+typedef int esp_err_t;
+#define ESP_OK 0
+
+#define portMAX_DELAY 0xFFFFFFFF
+
+#define SPI_TRANS_USE_TXDATA (1 << 3)
+
+struct spi_transaction_t
+{
+  uint32_t flags;
+  uint32_t length; // bits
+  void *user;
+  const void *tx_buffer;
+  uint8_t tx_data[4];
+};
+
+typedef struct spi_device_t *spi_device_handle_t;
+
+// Aborts when more than TFT_DMA_QUEUE are queued (the driver would block)
+esp_err_t spi_device_queue_trans(spi_device_handle_t handle, spi_transaction_t *trans, uint32_t ticks);
+
+// Sends the oldest: DC from user (dc_callback), then its done() if user is a
+// dlImage() job (dl_job_callback)
+esp_err_t spi_device_get_trans_result(spi_device_handle_t handle, spi_transaction_t **trans, uint32_t ticks);
+
+// Transactions queued and not yet taken
+uint32_t spiQueued();
+
+extern spi_device_handle_t dmaHAL;
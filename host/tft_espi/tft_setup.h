@@ -0,0 +1,24 @@
+#pragma once
+
+// TFT_eSPI setup of the host build: the cyd4_st7796 panel, the GLCD and
+// smooth fonts (files from fs::FS) and the display list's DMA path, with
+// driver/spi_master.h standing in for ESP-IDF. DMA_Enabled picks the path.
+
+#define USER_SETUP_LOADED
+
+#define ST7796_DRIVER
+#define TFT_CS 15
+#define TFT_DC 2
+#define TFT_RST -1
+#define TOUCH_CS 33
+#define SPI_FREQUENCY 55000000
+
+#define LOAD_GLCD
+#define SMOOTH_FONT
+
+#include <FS.h>
+#define FONT_FS_AVAILABLE
+
+#include <driver/spi_master.h>
+#define TFT_DL_DMA
+#define TFT_DMA_QUEUE 4
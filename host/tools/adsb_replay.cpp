@@ -0,0 +1,213 @@
+// Records and replays aircraft.json traffic through the core.
+//
+//   adsb_replay pack <capture> <aircraft.json>...
+//       Builds a capture from saved snapshots, in the given order, timed by
+//       the "now" field of each document.
+//
+//   adsb_replay run <capture> [--ili9488] [--csv <file>] [--png <file>]
+//       Replays the capture with the firmware's map and sprites and prints
+//       per-fetch cost statistics (host time, SPI bytes, wire time at the
+//       board's SPI_FREQUENCY). --csv writes one row per fetch, --png the
+//       last frame.
+
+#include <algorithm>
+#include <fstream>
+#include <sstream>
+#include <stdio.h>
+#include <string.h>
+#include <vector>
+#include "FirmwareAssets.h"
+#include "Replay.h"
+
+static int usage()
+{
+  fprintf(stderr,
+          "usage: adsb_replay pack <capture> <aircraft.json>...\n"
+          "       adsb_replay run <capture> [--ili9488] [--csv <file>] [--png <file>]\n");
+  return 2;
+}
+
+// ===================== pack =====================
+struct NoSink
+{
+  void operator()(const AircraftFields &) const {}
+};
+
+static int pack(int argc, char **argv)
+{
+  if (argc < 4)
+    return usage();
+
+  CaptureWriter out;
+  if (!out.open(argv[2]))
+  {
+    fprintf(stderr, "can't create %s\n", argv[2]);
+    return 1;
+  }
+
+  double first = -1, last = -1;
+  for (int i = 3; i < argc; i++)
+  {
+    std::ifstream in(argv[i], std::ios::binary);
+    std::ostringstream content;
+    content << in.rdbuf();
+    const std::string body = content.str();
+
+    double now = 0;
+    DeserializationError err = decodeAircraftJson(body.data(), body.size(), now, NoSink());
+    if (!in || err || now <= 0)
+    {
+      fprintf(stderr, "%s: not an aircraft.json with \"now\" (%s)\n", argv[i], err.c_str());
+      return 1;
+    }
+    if (first < 0)
+      first = now;
+    if (now < last)
+    {
+      fprintf(stderr, "%s: goes back in time, files must be in capture order\n", argv[i]);
+      return 1;
+    }
+    last = now;
+
+    out.append((uint32_t)((now - first) * 1000.0 + 0.5), body);
+  }
+
+  if (!out.close())
+  {
+    fprintf(stderr, "write error on %s\n", argv[2]);
+    return 1;
+  }
+  printf("%d snapshots, %.0f s\n", argc - 3, last - first);
+  return 0;
+}
+
+// ===================== run =====================
+struct Series
+{
+  std::vector<double> v;
+
+  void add(double x) { v.push_back(x); }
+
+  void print(const char *name)
+  {
+    if (v.empty())
+      return;
+    std::sort(v.begin(), v.end());
+    double sum = 0;
+    for (size_t i = 0; i < v.size(); i++)
+      sum += v[i];
+    printf("  %-12s mean %10.1f  p50 %10.1f  p95 %10.1f  max %10.1f\n", name,
+           sum / v.size(), v[v.size() / 2], v[v.size() * 95 / 100], v.back());
+  }
+};
+
+static int run(int argc, char **argv)
+{
+  if (argc < 3)
+    return usage();
+
+  PixelFormat format = PixelFormat::Rgb565;
+  uint32_t spiHz = SPI_HZ_ST7796;
+  const char *csvPath = nullptr;
+  const char *pngPath = nullptr;
+  for (int i = 3; i < argc; i++)
+  {
+    if (!strcmp(argv[i], "--ili9488"))
+    {
+      format = PixelFormat::Rgb666;
+      spiHz = SPI_HZ_ILI9488;
+    }
+    else if (!strcmp(argv[i], "--csv") && i + 1 < argc)
+      csvPath = argv[++i];
+    else if (!strcmp(argv[i], "--png") && i + 1 < argc)
+      pngPath = argv[++i];
+    else
+      return usage();
+  }
+
+  CaptureReader capture;
+  if (!capture.open(argv[2]))
+  {
+    fprintf(stderr, "%s: not a capture\n", argv[2]);
+    return 1;
+  }
+
+  FILE *csv = nullptr;
+  if (csvPath)
+  {
+    csv = fopen(csvPath, "w");
+    if (!csv)
+    {
+      fprintf(stderr, "can't create %s\n", csvPath);
+      return 1;
+    }
+    fprintf(csv, "fetch,ms,ok,http,raw,shown,with_pos,updated,tracks,drawn,"
+                 "fetch_us,render_us,windows,commands,spi_bytes,addr_saved,wire_us\n");
+  }
+
+  ReplayDriver driver(capture, format, firmwareMapView(), firmwareAssets());
+
+  Series fetchUs, renderUs, spiBytes, addrSaved, wireUs, drawn;
+  unsigned long failed = 0;
+  int peakTracks = 0;
+  uint32_t lastMs = 0;
+
+  const uint64_t t0 = steadyMicros();
+  const unsigned long fetches = driver.run([&](const ReplayFrame &f)
+                                           {
+    lastMs = f.ms;
+    if (!f.ok)
+    {
+      failed++;
+      return;
+    }
+    fetchUs.add((double)f.fetchUs);
+    renderUs.add((double)f.renderUs);
+    spiBytes.add((double)f.spi.bytes());
+    addrSaved.add((double)f.spi.addressSaved);
+    wireUs.add(f.spi.wireMicros(spiHz));
+    drawn.add(f.drawn);
+    peakTracks = std::max(peakTracks, f.tracks);
+
+    if (csv)
+      fprintf(csv, "%lu,%lu,%d,%d,%d,%d,%d,%d,%d,%d,%llu,%llu,%llu,%llu,%llu,%llu,%.1f\n",
+              f.index, (unsigned long)f.ms, f.ok ? 1 : 0, f.report.httpCode,
+              f.report.stats.totalRaw, f.report.stats.totalShown, f.report.stats.withPos,
+              f.report.stats.updated, f.tracks, f.drawn,
+              (unsigned long long)f.fetchUs, (unsigned long long)f.renderUs,
+              (unsigned long long)f.spi.windows, (unsigned long long)f.spi.commands,
+              (unsigned long long)f.spi.bytes(), (unsigned long long)f.spi.addressSaved,
+              f.spi.wireMicros(spiHz)); });
+  const double hostS = (steadyMicros() - t0) / 1e6;
+
+  if (csv)
+    fclose(csv);
+  if (capture.failed())
+    fprintf(stderr, "warning: capture is damaged, replay stopped early\n");
+  if (pngPath && !driver.tft().writePng(pngPath))
+    fprintf(stderr, "can't write %s\n", pngPath);
+
+  printf("%lu fetches over %.0f s of traffic in %.2f s (%.0fx real time), %lu failed\n",
+         fetches, lastMs / 1000.0, hostS, hostS > 0 ? lastMs / 1000.0 / hostS : 0.0, failed);
+  printf("%s at %lu MHz, peak %d tracks\n", format == PixelFormat::Rgb666 ? "ILI9488" : "ST7796",
+         (unsigned long)(spiHz / 1000000), peakTracks);
+  printf("per fetch:\n");
+  fetchUs.print("fetch us");
+  renderUs.print("render us");
+  spiBytes.print("SPI bytes");
+  addrSaved.print("addr saved");
+  wireUs.print("wire us");
+  drawn.print("drawn");
+  return 0;
+}
+
+int main(int argc, char **argv)
+{
+  if (argc < 2)
+    return usage();
+  if (!strcmp(argv[1], "pack"))
+    return pack(argc, argv);
+  if (!strcmp(argv[1], "run"))
+    return run(argc, argv);
+  return usage();
+}
@@ -0,0 +1,261 @@
+// Synthetic tar1090 for load tests.
+//
+//   adsb_sim serve [--port 8080] [--bind 0.0.0.0] [--speed 1] [traffic options]
+//       Serves GET .../aircraft.json over HTTP; the traffic moves with the
+//       wall clock (times --speed). Point AIRCRAFT_URL of a device on the LAN,
+//       or curl, at http://<host>:<port>/tar1090/data/aircraft.json
+//
+//   adsb_sim capture <capture> --seconds N [--every 1] [traffic options]
+//       Writes N seconds of traffic as a capture for adsb_replay.
+//
+// Traffic options:
+//   --aircraft N     number of aircraft (default 200)
+//   --home LAT,LON   center (default Config.h home)
+//   --radius KM      area (default 400)
+//   --interval S     mean time between position messages (default 1)
+//   --noise M        position noise sigma in meters (default 0)
+//   --alt-noise FT   altitude noise sigma (default 0)
+//   --missing P      share of aircraft missing each optional field
+//   --seed N
+
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <signal.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/socket.h>
+#include <sys/time.h>
+#include <unistd.h>
+#include <string>
+#include <HostPlatform.h>
+#include <Capture.h>
+#include "TrafficSim.h"
+
+static int usage()
+{
+  fprintf(stderr,
+          "usage: adsb_sim serve [--port N] [--bind ADDR] [--speed X] [traffic options]\n"
+          "       adsb_sim capture <capture> --seconds N [--every S] [traffic options]\n"
+          "traffic options: --aircraft N --home LAT,LON --radius KM --interval S\n"
+          "                 --noise M --alt-noise FT --missing P --seed N\n");
+  return 2;
+}
+
+// Parses one traffic option at argv[i]; false if it isn't one
+static bool parseTrafficOption(int argc, char **argv, int &i, TrafficOptions &o)
+{
+  if (i + 1 >= argc)
+    return false;
+  const char *name = argv[i];
+  const char *value = argv[i + 1];
+
+  if (!strcmp(name, "--aircraft"))
+    o.aircraft = atoi(value);
+  else if (!strcmp(name, "--home"))
+  {
+    if (sscanf(value, "%lf,%lf", &o.homeLat, &o.homeLon) != 2)
+      return false;
+  }
+  else if (!strcmp(name, "--radius"))
+    o.radiusKm = atof(value);
+  else if (!strcmp(name, "--interval"))
+    o.posIntervalS = atof(value);
+  else if (!strcmp(name, "--noise"))
+    o.posNoiseM = atof(value);
+  else if (!strcmp(name, "--alt-noise"))
+    o.altNoiseFt = atof(value);
+  else if (!strcmp(name, "--missing"))
+    o.missingFlight = o.missingPosition = o.missingTrack = o.missingAlt = atof(value);
+  else if (!strcmp(name, "--seed"))
+    o.seed = (uint32_t)strtoul(value, nullptr, 10);
+  else
+    return false;
+
+  i++;
+  return true;
+}
+
+// ===================== capture =====================
+static int capture(int argc, char **argv)
+{
+  if (argc < 3)
+    return usage();
+
+  TrafficOptions opt;
+  double seconds = 0, every = 1;
+  for (int i = 3; i < argc; i++)
+  {
+    if (!strcmp(argv[i], "--seconds") && i + 1 < argc)
+      seconds = atof(argv[++i]);
+    else if (!strcmp(argv[i], "--every") && i + 1 < argc)
+      every = atof(argv[++i]);
+    else if (!parseTrafficOption(argc, argv, i, opt))
+      return usage();
+  }
+  if (seconds <= 0 || every <= 0)
+    return usage();
+
+  CaptureWriter out;
+  if (!out.open(argv[2]))
+  {
+    fprintf(stderr, "can't create %s\n", argv[2]);
+    return 1;
+  }
+
+  TrafficSim sim(opt);
+  std::string body;
+  unsigned long n = 0;
+  for (double t = 0; t <= seconds; t += every, n++)
+  {
+    body.clear();
+    sim.aircraftJson(body);
+    out.append((uint32_t)(t * 1000 + 0.5), body);
+    sim.advance(every);
+  }
+
+  if (!out.close())
+  {
+    fprintf(stderr, "write error on %s\n", argv[2]);
+    return 1;
+  }
+  printf("%lu snapshots of %d aircraft\n", n, sim.count());
+  return 0;
+}
+
+// ===================== serve =====================
+static bool sendAll(int fd, const char *data, size_t len)
+{
+  while (len)
+  {
+    const ssize_t n = send(fd, data, len, MSG_NOSIGNAL);
+    if (n <= 0)
+      return false;
+    data += n;
+    len -= (size_t)n;
+  }
+  return true;
+}
+
+static void respond(int fd, const char *status, const char *type, const std::string &body)
+{
+  char head[256];
+  const int n = snprintf(head, sizeof(head),
+                         "HTTP/1.1 %s\r\nContent-Type: %s\r\nContent-Length: %lu\r\n"
+                         "Cache-Control: no-cache\r\nConnection: close\r\n\r\n",
+                         status, type, (unsigned long)body.size());
+  if (sendAll(fd, head, n))
+    sendAll(fd, body.data(), body.size());
+}
+
+// A client that connects and then sends or reads nothing would hold up every
+// request after it: give up on it after this long
+static const int CLIENT_TIMEOUT_MS = 2000;
+
+static int serve(int argc, char **argv)
+{
+  TrafficOptions opt;
+  int port = 8080;
+  const char *bindAddr = "0.0.0.0";
+  double speed = 1;
+  for (int i = 2; i < argc; i++)
+  {
+    if (!strcmp(argv[i], "--port") && i + 1 < argc)
+      port = atoi(argv[++i]);
+    else if (!strcmp(argv[i], "--bind") && i + 1 < argc)
+      bindAddr = argv[++i];
+    else if (!strcmp(argv[i], "--speed") && i + 1 < argc)
+      speed = atof(argv[++i]);
+    else if (!parseTrafficOption(argc, argv, i, opt))
+      return usage();
+  }
+
+  const int server = socket(AF_INET, SOCK_STREAM, 0);
+  if (server < 0)
+  {
+    perror("adsb_sim: socket");
+    return 1;
+  }
+  const int yes = 1;
+  setsockopt(server, SOL_SOCKET, SO_REUSEADDR, &yes, sizeof(yes));
+
+  sockaddr_in addr;
+  memset(&addr, 0, sizeof(addr));
+  addr.sin_family = AF_INET;
+  addr.sin_port = htons((uint16_t)port);
+  if (inet_pton(AF_INET, bindAddr, &addr.sin_addr) != 1 ||
+      bind(server, (sockaddr *)&addr, sizeof(addr)) != 0 || listen(server, 16) != 0)
+  {
+    perror("adsb_sim: bind");
+    return 1;
+  }
+  signal(SIGPIPE, SIG_IGN);
+
+  TrafficSim sim(opt);
+  const double startEpoch = sim.now();
+  SystemClock clock;
+  printf("serving %d aircraft on http://%s:%d/tar1090/data/aircraft.json\n", sim.count(), bindAddr, port);
+  fflush(stdout);
+
+  std::string body;
+  for (;;)
+  {
+    const int fd = accept(server, nullptr, nullptr);
+    if (fd < 0)
+      continue;
+
+    timeval timeout;
+    timeout.tv_sec = CLIENT_TIMEOUT_MS / 1000;
+    timeout.tv_usec = CLIENT_TIMEOUT_MS % 1000 * 1000;
+    setsockopt(fd, SOL_SOCKET, SO_RCVTIMEO, &timeout, sizeof(timeout));
+    setsockopt(fd, SOL_SOCKET, SO_SNDTIMEO, &timeout, sizeof(timeout));
+
+    // Only the request line matters; read until the end of the headers
+    std::string request;
+    char buf[1024];
+    while (request.find("\r\n\r\n") == std::string::npos && request.size() < 8192)
+    {
+      const ssize_t n = recv(fd, buf, sizeof(buf), 0);
+      if (n <= 0)
+        break;
+      request.append(buf, (size_t)n);
+    }
+    if (request.find("\r\n") == std::string::npos)
+    {
+      close(fd); // timed out, or closed, before a request line
+      continue;
+    }
+
+    char method[8] = {}, path[512] = {};
+    sscanf(request.c_str(), "%7s %511s", method, path);
+    path[strcspn(path, "?")] = 0; // tar1090 adds ?_=<time> against caches
+    const size_t len = strlen(path);
+    const char *suffix = "aircraft.json";
+
+    if (!strcmp(method, "GET") && len >= strlen(suffix) && !strcmp(path + len - strlen(suffix), suffix))
+    {
+      const double target = startEpoch + clock.millis() / 1000.0 * speed;
+      if (target > sim.now())
+        sim.advance(target - sim.now());
+      body.clear();
+      sim.aircraftJson(body);
+      respond(fd, "200 OK", "application/json", body);
+    }
+    else
+    {
+      respond(fd, "404 Not Found", "text/plain", "not found\n");
+    }
+    close(fd);
+  }
+}
+
+int main(int argc, char **argv)
+{
+  if (argc < 2)
+    return usage();
+  if (!strcmp(argv[1], "serve"))
+    return serve(argc, argv);
+  if (!strcmp(argv[1], "capture"))
+    return capture(argc, argv);
+  return usage();
+}
@@ -0,0 +1,98 @@
+// Panel command counts of the display primitives on the emulated TFT.
+//
+//   render_bench
+//
+// Draws the 360 plane sprites of the firmware as runs of set mask bits, with
+// drawSpans() batches and with one drawFastHLine() per run, and prints what
+// each sends on the wire for both panels.
+
+#include <stdio.h>
+#include <TftEmulator.h>
+#include <FirmwareAssets.h>
+#include <HB9IIU_Renderer.h>
+
+static const int SPAN_BATCH = 64; // runs per drawSpans() call
+
+// The set bits of a PW x PH mask as runs, at x0, y0: in drawSpans() batches,
+// or one windowed line per run
+static void drawMask(TftEmulator &tft, bool batched, int x0, int y0, const uint8_t *mask, int stride, uint16_t color)
+{
+  tft_span_t spans[SPAN_BATCH];
+  uint32_t n = 0;
+  for (int y = 0; y < PH; y++)
+  {
+    const uint8_t *m = mask + y * stride;
+    int x = 0;
+    while (x < PW)
+    {
+      while (x < PW && !(m[x >> 3] & (0x80 >> (x & 7))))
+        x++;
+      if (x >= PW)
+        break;
+      const int xStart = x;
+      while (x < PW && (m[x >> 3] & (0x80 >> (x & 7))))
+        x++;
+
+      if (!batched)
+      {
+        tft.drawFastHLine(x0 + xStart, y0 + y, x - xStart, color);
+        continue;
+      }
+      if (n == SPAN_BATCH)
+      {
+        tft.drawSpans(spans, n, color);
+        n = 0;
+      }
+      spans[n++] = {x0 + xStart, y0 + y, x - xStart};
+    }
+  }
+  if (n)
+    tft.drawSpans(spans, n, color);
+}
+
+static void drawAllSprites(TftEmulator &tft, bool batched)
+{
+  const RenderAssets assets = firmwareAssets();
+  tft.startWrite();
+  for (int h = 0; h < 360; h++)
+    drawMask(tft, batched, SW / 2 - PW / 2, SH / 2 - PH / 2, assets.planeMasks + assets.planeOffsets[h],
+             assets.planeStride, RGB565_YELLOW);
+  tft.endWrite();
+}
+
+static void report(const char *name, const SpiCost &c, uint32_t spiHz)
+{
+  printf("  %-16s %9llu %9llu %11llu %11llu %10.1f\n", name,
+         (unsigned long long)c.commands, (unsigned long long)c.windows,
+         (unsigned long long)c.commandBytes, (unsigned long long)c.pixelBytes,
+         c.wireMicros(spiHz) / 360);
+}
+
+int main()
+{
+  const struct
+  {
+    const char *name;
+    PixelFormat format;
+    uint32_t spiHz;
+  } panels[] = {
+      {"ST7796", PixelFormat::Rgb565, SPI_HZ_ST7796},
+      {"ILI9488", PixelFormat::Rgb666, SPI_HZ_ILI9488},
+  };
+
+  printf("360 plane sprites (32x32, 1-bit masks)\n");
+  for (const auto &panel : panels)
+  {
+    printf("%s at %lu MHz:\n", panel.name, (unsigned long)(panel.spiHz / 1000000));
+    printf("  %-16s %9s %9s %11s %11s %10s\n", "", "commands", "windows", "cmd bytes", "px bytes", "us/sprite");
+
+    TftEmulator perSpan(panel.format);
+    drawAllSprites(perSpan, false);
+    report("drawFastHLine", perSpan.cost(), panel.spiHz);
+
+    TftEmulator batched(panel.format);
+    drawAllSprites(batched, true);
+    report("drawSpans", batched.cost(), panel.spiHz);
+  }
+  return 0;
+}
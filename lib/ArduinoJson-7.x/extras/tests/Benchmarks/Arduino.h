@@ -0,0 +1,14 @@
+// ArduinoJson - https://arduinojson.org
+// Copyright © 2014-2025, Benoit BLANCHON
+// MIT License
+
+#pragma once
+
+// Unlike Helpers/Arduino.h, this one only provides Stream and Print, and
+// doesn't fake PROGMEM, so the benchmarks run the same code paths as on an
+// ESP32.
+
+#include <stddef.h>
+
+#include "../Helpers/api/Print.h"
+#include "../Helpers/api/Stream.h"
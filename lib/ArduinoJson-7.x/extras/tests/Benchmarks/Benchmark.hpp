@@ -0,0 +1,166 @@
+// ArduinoJson - https://arduinojson.org
+// Copyright © 2014-2025, Benoit BLANCHON
+// MIT License
+
+#pragma once
+
+#include <ArduinoJson.h>
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+
+namespace benchmark {
+
+// Builds a document shaped like a readsb/dump1090 "aircraft.json" feed:
+// a few top-level counters followed by a large array of small objects.
+inline std::string makeAircraftFeed(int count) {
+  std::string json =
+      "{\"now\":1718000000.5,\"messages\":123456789,\"aircraft\":[";
+  char buf[512];
+  for (int i = 0; i < count; i++) {
+    double lat = 46.0 + (i % 97) * 0.0137;
+    double lon = 6.0 + (i % 89) * 0.0211;
+    int n = snprintf(
+        buf, sizeof(buf),
+        "%s{\"hex\":\"%06x\",\"type\":\"adsb_icao\",\"flight\":\"SWR%-4d \","
+        "\"alt_baro\":%d,\"alt_geom\":%d,\"gs\":%.1f,\"track\":%.2f,"
+        "\"baro_rate\":%d,\"squawk\":\"%04d\",\"emergency\":\"none\","
+        "\"category\":\"A3\",\"lat\":%.6f,\"lon\":%.6f,\"nic\":8,"
+        "\"rc\":186,\"seen_pos\":%.1f,\"version\":2,\"nac_p\":9,"
+        "\"nac_v\":1,\"sil\":3,\"sil_type\":\"perhour\",\"mlat\":[],"
+        "\"tisb\":[],\"messages\":%d,\"seen\":%.1f,\"rssi\":%.1f}",
+        i ? "," : "", 0x4b0000 + i * 37, i % 10000, 1000 + (i * 250) % 39000,
+        1100 + (i * 250) % 39000, 120.0 + i % 350, (i * 7) % 360 + 0.25,
+        (i % 41 - 20) * 64, i % 7777, lat, lon, (i % 30) * 0.3, i * 11,
+        (i % 20) * 0.1, -10.0 - i % 25);
+    json.append(buf, static_cast<size_t>(n));
+  }
+  json += "]}";
+  return json;
+}
+
+// Counts the bytes and blocks allocated by a JsonDocument
+class CountingAllocator : public ArduinoJson::Allocator {
+ public:
+  virtual ~CountingAllocator() {}
+
+  void* allocate(size_t size) override {
+    allocations_++;
+    current_ += size;
+    if (current_ > peak_)
+      peak_ = current_;
+    size_t* p = static_cast<size_t*>(malloc(sizeof(size_t) + size));
+    *p = size;
+    return p + 1;
+  }
+
+  void deallocate(void* ptr) override {
+    if (!ptr)
+      return;
+    size_t* p = static_cast<size_t*>(ptr) - 1;
+    current_ -= *p;
+    free(p);
+  }
+
+  void* reallocate(void* ptr, size_t new_size) override {
+    reallocations_++;
+    size_t* p = static_cast<size_t*>(ptr) - 1;
+    current_ = current_ - *p + new_size;
+    if (current_ > peak_)
+      peak_ = current_;
+    p = static_cast<size_t*>(realloc(p, sizeof(size_t) + new_size));
+    *p = new_size;
+    return p + 1;
+  }
+
+  size_t peak() const {
+    return peak_;
+  }
+
+  // Number of calls to allocate()
+  size_t allocations() const {
+    return allocations_;
+  }
+
+  // Number of calls to reallocate()
+  size_t reallocations() const {
+    return reallocations_;
+  }
+
+ private:
+  size_t current_ = 0;
+  size_t peak_ = 0;
+  size_t allocations_ = 0;
+  size_t reallocations_ = 0;
+};
+
+// Same, with the 45 or so members that readsb writes for an aircraft with
+// ADS-B version 2, navigation and weather data (tar1090's aircraft.json)
+inline std::string makeReadsbFeed(int count) {
+  std::string json =
+      "{\"now\":1718000000.5,\"messages\":123456789,\"aircraft\":[";
+  char buf[1536];
+  for (int i = 0; i < count; i++) {
+    double lat = 46.0 + (i % 97) * 0.0137;
+    double lon = 6.0 + (i % 89) * 0.0211;
+    int alt = 1000 + (i * 250) % 39000;
+    int n = snprintf(
+        buf, sizeof(buf),
+        "%s{\"hex\":\"%06x\",\"type\":\"adsb_icao\",\"flight\":\"SWR%-4d \","
+        "\"r\":\"HB-J%02d\",\"t\":\"A320\",\"dbFlags\":0,"
+        "\"alt_baro\":%d,\"alt_geom\":%d,\"gs\":%.1f,\"ias\":%d,"
+        "\"tas\":%d,\"mach\":%.3f,\"wd\":%d,\"ws\":%d,\"oat\":%d,"
+        "\"tat\":%d,\"track\":%.2f,\"track_rate\":%.2f,\"roll\":%.2f,"
+        "\"mag_heading\":%.2f,\"true_heading\":%.2f,\"baro_rate\":%d,"
+        "\"geom_rate\":%d,\"squawk\":\"%04d\",\"emergency\":\"none\","
+        "\"category\":\"A3\",\"nav_qnh\":1013.6,\"nav_altitude_mcp\":%d,"
+        "\"nav_heading\":%.2f,\"nav_modes\":[\"autopilot\",\"tcas\"],"
+        "\"lat\":%.6f,\"lon\":%.6f,\"nic\":8,\"rc\":186,"
+        "\"seen_pos\":%.3f,\"r_dst\":%.3f,\"r_dir\":%.1f,\"version\":2,"
+        "\"nic_baro\":1,\"nac_p\":9,\"nac_v\":1,\"sil\":3,"
+        "\"sil_type\":\"perhour\",\"gva\":2,\"sda\":2,\"alert\":0,"
+        "\"spi\":0,\"mlat\":[],\"tisb\":[],\"messages\":%d,"
+        "\"seen\":%.1f,\"rssi\":%.1f}",
+        i ? "," : "", 0x4b0000 + i * 37, i % 10000, i % 100, alt, alt + 100,
+        120.0 + i % 350, 100 + i % 250, 110 + i % 300, 0.2 + (i % 60) * 0.01,
+        i % 360, i % 80, 15 - i % 70, 20 - i % 70, (i * 7) % 360 + 0.25,
+        (i % 7 - 3) * 0.03, (i % 11 - 5) * 0.4, (i * 7) % 360 + 1.5,
+        (i * 7) % 360 + 3.5, (i % 41 - 20) * 64, (i % 41 - 20) * 64 + 32,
+        i % 7777, (alt / 1000) * 1000, (i * 7) % 360 + 0.5, lat, lon,
+        (i % 30) * 0.3, 5.0 + (i % 500) * 0.37, (i * 13) % 360 + 0.5, i * 11,
+        (i % 20) * 0.1, -10.0 - i % 25);
+    json.append(buf, static_cast<size_t>(n));
+  }
+  json += "]}";
+  return json;
+}
+
+// Reads the iteration count from the command line
+inline int iterations(int argc, char* argv[], int defaultValue) {
+  return argc > 1 ? atoi(argv[1]) : defaultValue;
+}
+
+class Stopwatch {
+ public:
+  Stopwatch() : start_(clock::now()) {}
+
+  double seconds() const {
+    return std::chrono::duration<double>(clock::now() - start_).count();
+  }
+
+ private:
+  using clock = std::chrono::steady_clock;
+  clock::time_point start_;
+};
+
+// Prints one line of results: throughput and time per iteration
+inline void report(const char* name, size_t bytesPerIteration, int iterations,
+                   double seconds) {
+  double mb = static_cast<double>(bytesPerIteration) * iterations / 1e6;
+  printf("%-32s %8.2f MB/s %10.1f us/iter\n", name, mb / seconds,
+         seconds * 1e6 / iterations);
+}
+
+}  // namespace benchmark
@@ -0,0 +1,68 @@
+// ArduinoJson - https://arduinojson.org
+// Copyright © 2014-2025, Benoit BLANCHON
+// MIT License
+
+// Regression suite for deserializeJson() on readsb aircraft.json snapshots of
+// 50, 300 and 1000 aircraft, without a filter, with the app's Filter, and
+// with the same filter compiled.
+// For each case, prints the throughput, the allocations per document and the
+// peak memory of the document (pools and strings).
+// The argument sets the iterations for the 300-aircraft snapshot; the others
+// are scaled to parse about the same number of bytes.
+
+#include <ArduinoJson.h>
+
+#include "Benchmark.hpp"
+
+using namespace benchmark;
+
+template <typename... TOptions>
+static bool run(int aircraft, const char* name, const std::string& json,
+                int n, const TOptions&... options) {
+  CountingAllocator allocator;
+  Stopwatch watch;
+  for (int i = 0; i < n; i++) {
+    JsonDocument doc(&allocator);
+    if (deserializeJson(doc, json.data(), json.size(), options...))
+      return false;
+  }
+  double seconds = watch.seconds();
+
+  printf("%8d  %-15s %8.2f MB/s %9.1f us %7.1f %8.1f %9u\n", aircraft, name,
+         static_cast<double>(json.size()) * n / 1e6 / seconds,
+         seconds * 1e6 / n, static_cast<double>(allocator.allocations()) / n,
+         static_cast<double>(allocator.reallocations()) / n,
+         static_cast<unsigned>(allocator.peak()));
+  return true;
+}
+
+int main(int argc, char* argv[]) {
+  int n = iterations(argc, argv, 100);
+
+  JsonDocument filter;
+  filter["now"] = true;
+  for (const char* key : {"hex", "flight", "lat", "lon", "track", "seen",
+                          "seen_pos", "alt_baro"})
+    filter["aircraft"][0][key] = true;
+  DeserializationOption::CompiledFilter compiled(filter);
+  if (compiled.overflowed())
+    return 1;
+
+  printf("%8s  %-15s %13s %12s %7s %8s %9s\n", "aircraft", "filter",
+         "throughput", "time", "allocs", "reallocs", "peak");
+
+  for (int aircraft : {50, 300, 1000}) {
+    std::string json = makeReadsbFeed(aircraft);
+    int scaled = n * 300 / aircraft;
+    if (scaled < 1)
+      scaled = 1;
+
+    bool ok = run(aircraft, "none", json, scaled) &&
+              run(aircraft, "Filter", json, scaled,
+                  DeserializationOption::Filter(filter)) &&
+              run(aircraft, "CompiledFilter", json, scaled, compiled);
+    if (!ok)
+      return 1;
+  }
+  return 0;
+}
@@ -0,0 +1,70 @@
+// ArduinoJson - https://arduinojson.org
+// Copyright © 2014-2025, Benoit BLANCHON
+// MIT License
+
+// Compares Filter and CompiledFilter on a readsb aircraft.json, keeping the
+// 8 members the ESP32 app uses out of about 45 per aircraft.
+
+#include <ArduinoJson.h>
+
+#include "Benchmark.hpp"
+
+using namespace benchmark;
+
+template <typename TFilter>
+static bool runDocument(const char* name, const std::string& json, int n,
+                        const TFilter& filter) {
+  Stopwatch watch;
+  for (int i = 0; i < n; i++) {
+    JsonDocument doc;
+    if (deserializeJson(doc, json.data(), json.size(), filter))
+      return false;
+  }
+  report(name, json.size(), n, watch.seconds());
+  return true;
+}
+
+template <typename TFilter>
+static bool runPullParser(const char* name, const std::string& json, int n,
+                          const TFilter& filter) {
+  Stopwatch watch;
+  for (int i = 0; i < n; i++) {
+    auto parser = makeJsonPullParser(json.data(), json.size(), filter);
+    JsonEvent event;
+    while ((event = parser.next()) != JsonEvent::End)
+      if (event == JsonEvent::Error)
+        return false;
+  }
+  report(name, json.size(), n, watch.seconds());
+  return true;
+}
+
+int main(int argc, char* argv[]) {
+  int n = iterations(argc, argv, 100);
+  std::string json = makeReadsbFeed(300);
+
+  JsonDocument filter;
+  filter["now"] = true;
+  for (const char* key : {"hex", "flight", "lat", "lon", "track", "seen",
+                          "seen_pos", "alt_baro"})
+    filter["aircraft"][0][key] = true;
+
+  DeserializationOption::CompiledFilter compiled(filter);
+  if (compiled.overflowed())
+    return 1;
+
+  printf("%u bytes, %d iterations, %u bytes of tables\n",
+         static_cast<unsigned>(json.size()), n,
+         static_cast<unsigned>(compiled.size()));
+
+  bool ok =
+      runDocument("deserializeJson, Filter", json, n,
+                  DeserializationOption::Filter(filter)) &&
+      runDocument("deserializeJson, CompiledFilter", json, n, compiled) &&
+      runPullParser("JsonPullParser, no filter", json, n,
+                    DeserializationOption::NestingLimit()) &&
+      runPullParser("JsonPullParser, Filter", json, n,
+                    DeserializationOption::Filter(filter)) &&
+      runPullParser("JsonPullParser, CompiledFilter", json, n, compiled);
+  return ok ? 0 : 1;
+}
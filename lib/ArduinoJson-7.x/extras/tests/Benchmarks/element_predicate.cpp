@@ -0,0 +1,80 @@
+// ArduinoJson - https://arduinojson.org
+// Copyright © 2014-2025, Benoit BLANCHON
+// MIT License
+
+// Compares two ways of keeping only the aircraft inside a lat/lon box:
+// deserializing them all and checking the box afterwards, or rejecting them
+// with an element predicate while parsing.
+
+#include <ArduinoJson.h>
+
+#include "Benchmark.hpp"
+
+using namespace benchmark;
+
+static bool inBox(double lat, double lon) {
+  return lat >= 46.2 && lat <= 46.9 && lon >= 6.3 && lon <= 7.2;
+}
+
+static bool keepInBox(JsonVariantConst aircraft, JsonString key) {
+  if (key.isNull())
+    return aircraft["lat"].is<double>() && aircraft["lon"].is<double>();
+  if (key == "lat") {
+    double lat = aircraft["lat"];
+    return lat >= 46.2 && lat <= 46.9;
+  }
+  if (key == "lon") {
+    double lon = aircraft["lon"];
+    return lon >= 6.3 && lon <= 7.2;
+  }
+  return true;
+}
+
+int main(int argc, char* argv[]) {
+  int n = iterations(argc, argv, 200);
+  std::string json = makeAircraftFeed(300);
+
+  JsonDocument filter;
+  filter["aircraft"][0]["hex"] = true;
+  filter["aircraft"][0]["flight"] = true;
+  filter["aircraft"][0]["lat"] = true;
+  filter["aircraft"][0]["lon"] = true;
+  filter["aircraft"][0]["track"] = true;
+  filter["aircraft"][0]["seen_pos"] = true;
+
+  printf("%u bytes, %d iterations\n", static_cast<unsigned>(json.size()), n);
+
+  size_t kept = 0;
+  CountingAllocator afterwards;
+  Stopwatch watch;
+  for (int i = 0; i < n; i++) {
+    JsonDocument doc(&afterwards);
+    if (deserializeJson(doc, json, DeserializationOption::Filter(filter)))
+      return 1;
+    kept = 0;
+    for (JsonObjectConst a : doc["aircraft"].as<JsonArrayConst>())
+      if (inBox(a["lat"], a["lon"]))
+        kept++;
+  }
+  report("check afterwards", json.size(), n, watch.seconds());
+  printf("%-32s %8u bytes peak, %u kept\n", "",
+         static_cast<unsigned>(afterwards.peak()),
+         static_cast<unsigned>(kept));
+
+  CountingAllocator predicate;
+  watch = Stopwatch();
+  for (int i = 0; i < n; i++) {
+    JsonDocument doc(&predicate);
+    if (deserializeJson(doc, json,
+                        DeserializationOption::Filter(
+                            filter, filter["aircraft"], keepInBox)))
+      return 1;
+    kept = doc["aircraft"].size();
+  }
+  report("element predicate", json.size(), n, watch.seconds());
+  printf("%-32s %8u bytes peak, %u kept\n", "",
+         static_cast<unsigned>(predicate.peak()),
+         static_cast<unsigned>(kept));
+
+  return 0;
+}
@@ -0,0 +1,79 @@
+// ArduinoJson - https://arduinojson.org
+// Copyright © 2014-2025, Benoit BLANCHON
+// MIT License
+
+// Compares JsonPullParser::number<double>() with fixedPoint() on the decimal
+// fields of an aircraft feed (lat, lon, track, seen, seen_pos).
+// The difference is much larger on targets where double is soft-float.
+
+#include <ArduinoJson.h>
+
+#include <string.h>
+
+#include "Benchmark.hpp"
+
+using namespace benchmark;
+
+static const int aircraftCount = 300;
+
+using Parser = decltype(makeJsonPullParser(static_cast<const char*>(0), 0));
+
+static bool isDecimalField(JsonString key) {
+  static const char* const names[] = {"lat", "lon", "track", "seen",
+                                      "seen_pos"};
+  for (const char* name : names) {
+    if (key.size() == strlen(name) && !memcmp(key.c_str(), name, key.size()))
+      return true;
+  }
+  return false;
+}
+
+// Calls decode(parser) on the value of every decimal field
+template <typename TDecode>
+static bool decodeFeed(const std::string& json, TDecode decode) {
+  auto parser = makeJsonPullParser(json.data(), json.size());
+  JsonEvent e;
+  while ((e = parser.next()) > JsonEvent::Error) {
+    if (e == JsonEvent::Key && parser.depth() == 3 &&
+        isDecimalField(parser.key()) && parser.next() == JsonEvent::Number)
+      decode(parser);
+  }
+  return e == JsonEvent::End;
+}
+
+template <typename TDecode>
+static bool run(const char* name, const std::string& json, int n,
+                TDecode decode) {
+  Stopwatch watch;
+  for (int i = 0; i < n; i++) {
+    if (!decodeFeed(json, decode))
+      return false;
+  }
+  double seconds = watch.seconds();
+  report(name, json.size(), n, seconds);
+  printf("%-32s %8.1f ns/aircraft\n", "",
+         seconds * 1e9 / n / aircraftCount);
+  return true;
+}
+
+int main(int argc, char* argv[]) {
+  int n = iterations(argc, argv, 200);
+  std::string json = makeAircraftFeed(aircraftCount);
+
+  double sumDouble = 0;
+  int64_t sumFixed = 0;
+
+  printf("%d aircraft, %d iterations\n", aircraftCount, n);
+
+  bool ok = run("number<double>()", json, n,
+                [&](Parser& parser) { sumDouble += parser.number<double>(); }) &&
+            run("fixedPoint(int32_t, 6)", json, n, [&](Parser& parser) {
+              int32_t x = 0;
+              parser.fixedPoint(x, 6);
+              sumFixed += x;
+            });
+
+  // keeps the results alive
+  printf("checksums: %g %lld\n", sumDouble, static_cast<long long>(sumFixed));
+  return ok ? 0 : 1;
+}
@@ -0,0 +1,55 @@
+// ArduinoJson - https://arduinojson.org
+// Copyright © 2014-2025, Benoit BLANCHON
+// MIT License
+
+// Compares deserializeJson() with and without DeserializationOption::InSitu
+// on an aircraft feed, keeping the string fields (hex, flight, squawk...).
+// Both variants start from a fresh copy of the input, since InSitu modifies
+// it.
+
+#include <ArduinoJson.h>
+
+#include <string.h>
+#include <vector>
+
+#include "Benchmark.hpp"
+
+using namespace benchmark;
+
+template <typename... TOptions>
+static bool run(const char* name, const std::string& json, int n,
+                const TOptions&... options) {
+  std::vector<char> input(json.size());
+  CountingAllocator allocator;
+  Stopwatch watch;
+  for (int i = 0; i < n; i++) {
+    memcpy(input.data(), json.data(), json.size());
+    JsonDocument doc(&allocator);
+    if (deserializeJson(doc, input.data(), input.size(), options...))
+      return false;
+  }
+  report(name, json.size(), n, watch.seconds());
+  printf("%-32s %8u bytes peak\n", "", static_cast<unsigned>(allocator.peak()));
+  return true;
+}
+
+int main(int argc, char* argv[]) {
+  int n = iterations(argc, argv, 200);
+  std::string json = makeAircraftFeed(300);
+
+  JsonDocument filter;
+  filter["aircraft"][0]["hex"] = true;
+  filter["aircraft"][0]["type"] = true;
+  filter["aircraft"][0]["flight"] = true;
+  filter["aircraft"][0]["squawk"] = true;
+  filter["aircraft"][0]["emergency"] = true;
+  filter["aircraft"][0]["category"] = true;
+  filter["aircraft"][0]["sil_type"] = true;
+
+  printf("%u bytes, %d iterations\n", static_cast<unsigned>(json.size()), n);
+
+  bool ok = run("copy", json, n, DeserializationOption::Filter(filter)) &&
+            run("InSitu", json, n, DeserializationOption::Filter(filter),
+                DeserializationOption::InSitu());
+  return ok ? 0 : 1;
+}
@@ -0,0 +1,113 @@
+// ArduinoJson - https://arduinojson.org
+// Copyright © 2014-2025, Benoit BLANCHON
+// MIT License
+
+// Compares deserializeJson() with JsonPullParser on an aircraft feed, with and
+// without a filter.
+
+#include <ArduinoJson.h>
+
+#include <string.h>
+
+#include "Benchmark.hpp"
+
+using namespace benchmark;
+
+static double sumWithDocument(const std::string& json,
+                              const JsonDocument* filter) {
+  JsonDocument doc;
+  DeserializationError err =
+      filter
+          ? deserializeJson(doc, json, DeserializationOption::Filter(*filter))
+          : deserializeJson(doc, json);
+  if (err)
+    return -1;
+  double sum = 0;
+  for (JsonObject aircraft : doc["aircraft"].as<JsonArray>())
+    sum += aircraft["lat"].as<double>();
+  return sum;
+}
+
+template <typename TParser>
+static double sumWithParser(TParser& parser) {
+  double sum = 0;
+  bool isLat = false;
+  for (;;) {
+    switch (parser.next()) {
+      case JsonEvent::End:
+        return sum;
+      case JsonEvent::Error:
+        return -1;
+      case JsonEvent::Key:
+        isLat = parser.depth() == 3 && strcmp(parser.key().c_str(), "lat") == 0;
+        break;
+      case JsonEvent::Number:
+        if (isLat)
+          sum += parser.template number<double>();
+        break;
+      default:
+        break;
+    }
+  }
+}
+
+static double sumWithParser(const std::string& json,
+                            const JsonDocument* filter) {
+  if (filter) {
+    auto parser =
+        makeJsonPullParser(json, DeserializationOption::Filter(*filter));
+    return sumWithParser(parser);
+  } else {
+    auto parser = makeJsonPullParser(json);
+    return sumWithParser(parser);
+  }
+}
+
+template <typename TFunc>
+static bool run(const char* name, const std::string& json,
+                const JsonDocument* filter, int n, double expected,
+                TFunc func) {
+  Stopwatch watch;
+  for (int i = 0; i < n; i++) {
+    if (func(json, filter) != expected) {
+      printf("%s: wrong result\n", name);
+      return false;
+    }
+  }
+  report(name, json.size(), n, watch.seconds());
+  return true;
+}
+
+int main(int argc, char* argv[]) {
+  int n = iterations(argc, argv, 200);
+  std::string json = makeAircraftFeed(300);
+
+  JsonDocument filter;
+  filter["now"] = true;
+  filter["aircraft"][0]["hex"] = true;
+  filter["aircraft"][0]["flight"] = true;
+  filter["aircraft"][0]["lat"] = true;
+  filter["aircraft"][0]["lon"] = true;
+  filter["aircraft"][0]["alt_baro"] = true;
+
+  double expected = sumWithDocument(json, nullptr);
+  if (expected < 0) {
+    printf("invalid corpus\n");
+    return 1;
+  }
+
+  printf("%d aircraft, %u bytes, %d iterations\n", 300,
+         static_cast<unsigned>(json.size()), n);
+
+  bool ok = run("deserializeJson()", json, nullptr, n, expected,
+                sumWithDocument) &&
+            run("deserializeJson() + Filter", json, &filter, n, expected,
+                sumWithDocument) &&
+            run("JsonPullParser", json, nullptr, n, expected,
+                static_cast<double (*)(const std::string&,
+                                       const JsonDocument*)>(sumWithParser)) &&
+            run("JsonPullParser + Filter", json, &filter, n, expected,
+                static_cast<double (*)(const std::string&,
+                                       const JsonDocument*)>(sumWithParser));
+  return ok ? 0 : 1;
+}
@@ -0,0 +1,97 @@
+// ArduinoJson - https://arduinojson.org
+// Copyright © 2014-2025, Benoit BLANCHON
+// MIT License
+
+// Counts the calls made to a Stream while parsing an aircraft feed, with and
+// without a ReadBuffer.
+
+#include <Arduino.h>
+
+#define ARDUINOJSON_ENABLE_ARDUINO_STREAM 1
+#include <ArduinoJson.h>
+
+#include "Benchmark.hpp"
+
+using namespace benchmark;
+
+// A Stream that serves a string and counts the calls it receives, like
+// WiFiClient it hands out what has "arrived" in packets of up to 1460 bytes.
+class CountingStream : public Stream {
+ public:
+  CountingStream(const std::string& data) : data_(data), pos_(0), calls_(0) {}
+
+  int available() {
+    calls_++;
+    size_t left = data_.size() - pos_;
+    return static_cast<int>(left < packetSize ? left : packetSize);
+  }
+
+  int read() {
+    calls_++;
+    return pos_ < data_.size() ? static_cast<unsigned char>(data_[pos_++])
+                               : -1;
+  }
+
+  size_t readBytes(char* buffer, size_t length) {
+    calls_++;
+    size_t n = 0;
+    while (n < length && pos_ < data_.size())
+      buffer[n++] = data_[pos_++];
+    return n;
+  }
+
+  size_t calls() const {
+    return calls_;
+  }
+
+ private:
+  static const size_t packetSize = 1460;
+
+  const std::string& data_;
+  size_t pos_;
+  size_t calls_;
+};
+
+template <typename TParse>
+static bool run(const char* name, const std::string& json, int n,
+                TParse parse) {
+  size_t calls = 0;
+  Stopwatch watch;
+  for (int i = 0; i < n; i++) {
+    CountingStream stream(json);
+    if (!parse(stream))
+      return false;
+    calls = stream.calls();
+  }
+  report(name, json.size(), n, watch.seconds());
+  printf("%-32s %8u stream calls per document\n", "",
+         static_cast<unsigned>(calls));
+  return true;
+}
+
+int main(int argc, char* argv[]) {
+  int n = iterations(argc, argv, 100);
+  std::string json = makeAircraftFeed(300);
+
+  JsonDocument filter;
+  filter["aircraft"][0]["lat"] = true;
+  filter["aircraft"][0]["lon"] = true;
+
+  printf("%u bytes, %d iterations\n", static_cast<unsigned>(json.size()), n);
+
+  bool ok =
+      run("deserializeJson(Stream)", json, n,
+          [&](Stream& stream) {
+            JsonDocument doc;
+            return !deserializeJson(doc, stream,
+                                    DeserializationOption::Filter(filter));
+          }) &&
+      run("deserializeJson(Stream) + 1KB", json, n, [&](Stream& stream) {
+        char data[1024];
+        DeserializationOption::ReadBuffer buffer(data);
+        JsonDocument doc;
+        return !deserializeJson(
+            doc, stream, DeserializationOption::Filter(filter), buffer);
+      });
+  return ok ? 0 : 1;
+}
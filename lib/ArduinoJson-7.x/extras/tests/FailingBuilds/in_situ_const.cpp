@@ -0,0 +1,12 @@
+// ArduinoJson - https://arduinojson.org
+// Copyright © 2014-2025, Benoit BLANCHON
+// MIT License
+
+#include <ArduinoJson.h>
+
+// InSitu needs to write to the input
+
+int main() {
+  JsonDocument doc;
+  deserializeJson(doc, "[\"hello\"]", 9, DeserializationOption::InSitu());
+}
@@ -693,6 +693,34 @@ TEST_CASE("Filtering") {
           "null",
           0,
       },
+      {
+          "Long strings and numbers in skipped members",
+          "{\"a\":\"0123456789abcdefghij\\\"klmnopqrstuvwxyz\",\"bb\":1234567890,"
+          "\"c\":-1234.5678e+90,\"example\":42,\"d\":[\"\\\\\",\"'\\\"\"]}",
+          "{\"example\":true}",
+          10,
+          DeserializationError::Ok,
+          "{\"example\":42}",
+          sizeofObject(1) + sizeofString("example"),
+      },
+      {
+          "Single-quoted string with double quotes in skipped member",
+          "{\"a\":'\"\"\"\"\"\"\"\"',\"example\":42}",
+          "{\"example\":true}",
+          10,
+          DeserializationError::Ok,
+          "{\"example\":42}",
+          sizeofObject(1) + sizeofString("example"),
+      },
+      {
+          "Incomplete long string in skipped member",
+          "{\"a\":\"0123456789abcdefghij",
+          "{\"example\":true}",
+          10,
+          DeserializationError::IncompleteInput,
+          "{}",
+          sizeofObject(0),
+      },
       {
           "NUL character in key",
           "{\"x\":0,\"x\\u0000a\":1,\"x\\u0000b\":2}",
@@ -723,6 +751,30 @@ TEST_CASE("Filtering") {
       CHECK(spy.allocatedBytes() == tc.memoryUsage);
     }
   }
+
+  // A CompiledFilter must select exactly what the Filter selects
+  for (auto& tc : testCases) {
+    SECTION(std::string("CompiledFilter: ") + tc.description) {
+      SpyingAllocator spy;
+      JsonDocument filter;
+      JsonDocument doc(&spy);
+
+      REQUIRE(deserializeJson(filter, tc.filter) == DeserializationError::Ok);
+      DeserializationOption::CompiledFilter compiled(filter);
+      REQUIRE(compiled.overflowed() == false);
+
+      CHECK(deserializeJson(
+                doc, tc.input, compiled,
+                DeserializationOption::NestingLimit(tc.nestingLimit)) ==
+            tc.error);
+
+      CHECK(doc.as<std::string>() == tc.output);
+
+      doc.shrinkToFit();
+      CHECK(spy.allocatedBytes() == tc.memoryUsage);
+    }
+  }
+
 }
 
 TEST_CASE("Overloads") {
@@ -816,6 +868,21 @@ TEST_CASE("Overloads") {
 #endif
 }
 
+TEST_CASE("Options passed as const lvalues") {
+  JsonDocument filter;
+  filter["a"] = true;
+  const DeserializationOption::Filter filterOption(filter);
+  const DeserializationOption::NestingLimit nestingLimit(1);
+  JsonDocument doc;
+
+  REQUIRE(deserializeJson(doc, "{\"a\":1,\"b\":2}", filterOption,
+                          nestingLimit) == DeserializationError::Ok);
+  REQUIRE(doc.as<std::string>() == "{\"a\":1}");
+
+  REQUIRE(deserializeJson(doc, "{\"a\":[[1]]}", filterOption, nestingLimit) ==
+          DeserializationError::TooDeep);
+}
+
 TEST_CASE("shrink filter") {
   JsonDocument doc;
   SpyingAllocator spy;
@@ -829,3 +896,195 @@ TEST_CASE("shrink filter") {
                            Reallocate(sizeofPool(), sizeofObject(1)),
                        });
 }
+
+static int predicateCalls;
+
+// rejects elements whose "x" is above 10, or that have no "x"
+static bool xAtMostTen(JsonVariantConst element, JsonString key) {
+  predicateCalls++;
+  if (key.isNull())
+    return element["x"].is<int>();
+  if (key == "x")
+    return element["x"].as<int>() <= 10;
+  return true;
+}
+
+TEST_CASE("Filter with an element predicate") {
+  SpyingAllocator spy;
+  JsonDocument doc(&spy);
+  JsonDocument filter;
+  filter["list"][0]["id"] = true;
+  filter["list"][0]["x"] = true;
+  DeserializationOption::Filter filterOpt(filter, filter["list"], xAtMostTen);
+  predicateCalls = 0;
+
+  SECTION("drops rejected elements") {
+    auto err = deserializeJson(doc,
+                               "{\"list\":[{\"id\":1,\"x\":5},{\"id\":2,\"x\":50},"
+                               "{\"id\":3},{\"id\":4,\"x\":7}]}",
+                               filterOpt);
+
+    REQUIRE(err == DeserializationError::Ok);
+    REQUIRE(doc.as<std::string>() ==
+            "{\"list\":[{\"id\":1,\"x\":5},{\"id\":4,\"x\":7}]}");
+  }
+
+  SECTION("stops calling the predicate after a rejection") {
+    JsonDocument arrayFilter;
+    arrayFilter[0] = true;
+    auto err = deserializeJson(
+        doc, "[{\"x\":50,\"id\":1,\"z\":{\"a\":[1,2]}}]",
+        DeserializationOption::Filter(arrayFilter, arrayFilter, xAtMostTen));
+
+    REQUIRE(err == DeserializationError::Ok);
+    REQUIRE(doc.as<std::string>() == "[]");
+    REQUIRE(predicateCalls == 1);
+  }
+
+  SECTION("still validates the skipped members") {
+    auto err = deserializeJson(doc, "{\"list\":[{\"x\":50,\"id\":1,]}",
+                               filterOpt);
+
+    REQUIRE(err == DeserializationError::InvalidInput);
+  }
+
+  SECTION("scalar elements only get the final call") {
+    filter.clear();
+    filter["list"] = true;
+    auto err =
+        deserializeJson(doc, "{\"list\":[1,{\"x\":2},3]}",
+                        DeserializationOption::Filter(filter, filter["list"],
+                                                      xAtMostTen));
+
+    REQUIRE(err == DeserializationError::Ok);
+    REQUIRE(doc.as<std::string>() == "{\"list\":[{\"x\":2}]}");
+    REQUIRE(predicateCalls == 4);
+  }
+
+  SECTION("only applies to the given array") {
+    filter["other"][0]["x"] = true;
+    auto err = deserializeJson(doc, "{\"other\":[{\"x\":50}],\"list\":[]}",
+                               filterOpt);
+
+    REQUIRE(err == DeserializationError::Ok);
+    REQUIRE(doc.as<std::string>() == "{\"other\":[{\"x\":50}],\"list\":[]}");
+    REQUIRE(predicateCalls == 0);
+  }
+
+  SECTION("releases the slots of dropped elements") {
+    std::string input = "{\"list\":[";
+    for (int i = 0; i < 1000; i++)
+      input += "{\"id\":" + std::to_string(i) + ",\"x\":99},";
+    input += "{\"id\":0,\"x\":1}]}";
+
+    auto err = deserializeJson(doc, input, filterOpt);
+
+    REQUIRE(err == DeserializationError::Ok);
+    REQUIRE(doc["list"].size() == 1);
+    REQUIRE(spy.log() ==
+            AllocatorLog{
+                Allocate(sizeofStringBuffer()),
+                Allocate(sizeofPool()),
+                Reallocate(sizeofStringBuffer(), sizeofString("list")),
+                Allocate(sizeofStringBuffer()),
+                Deallocate(sizeofStringBuffer()),
+                Reallocate(sizeofPool(), sizeofPool(7)),
+            });
+  }
+}
+
+TEST_CASE("CompiledFilter") {
+  JsonDocument doc;
+  JsonDocument filter;
+
+  SECTION("finds each key among many") {
+    std::string input = "{";
+    for (int i = 0; i < 200; i++) {
+      std::string key = "key" + std::to_string(i);
+      if (i % 3 == 0)
+        filter[key] = true;
+      input += (i ? ",\"" : "\"") + key + "\":" + std::to_string(i);
+    }
+    input += "}";
+    DeserializationOption::CompiledFilter compiled(filter);
+
+    REQUIRE(deserializeJson(doc, input, compiled) == DeserializationError::Ok);
+
+    REQUIRE(doc.size() == 67);
+    for (int i = 0; i < 200; i++) {
+      std::string key = "key" + std::to_string(i);
+      CHECK(doc[key].as<int>() == (i % 3 == 0 ? i : 0));
+    }
+  }
+
+  SECTION("keys that look alike") {
+    filter["a"] = true;
+    filter["ab"] = true;
+    filter["aab"] = true;
+    filter["abb"] = true;
+    filter[""] = true;
+    DeserializationOption::CompiledFilter compiled(filter);
+
+    REQUIRE(deserializeJson(doc,
+                            "{\"\":0,\"a\":1,\"b\":2,\"ab\":3,\"ba\":4,"
+                            "\"aab\":5,\"abb\":6,\"acb\":7,\"aabb\":8}",
+                            compiled) == DeserializationError::Ok);
+
+    REQUIRE(doc.as<std::string>() ==
+            "{\"\":0,\"a\":1,\"ab\":3,\"aab\":5,\"abb\":6}");
+  }
+
+  SECTION("works with deserializeMsgPack()") {
+    filter["a"] = true;
+    DeserializationOption::CompiledFilter compiled(filter);
+
+    REQUIRE(deserializeMsgPack(doc, "\x82\xA1\x61\x01\xA1\x62\x02", 7,
+                               compiled) == DeserializationError::Ok);
+
+    REQUIRE(doc.as<std::string>() == "{\"a\":1}");
+  }
+
+  SECTION("supports element predicates") {
+    filter["list"][0]["id"] = true;
+    filter["list"][0]["x"] = true;
+    DeserializationOption::CompiledFilter compiled(filter, filter["list"],
+                                                   xAtMostTen);
+
+    REQUIRE(deserializeJson(doc,
+                            "{\"list\":[{\"id\":1,\"x\":5},"
+                            "{\"id\":2,\"x\":50,\"y\":[{\"x\":1}]}]}",
+                            compiled) == DeserializationError::Ok);
+
+    REQUIRE(doc.as<std::string>() == "{\"list\":[{\"id\":1,\"x\":5}]}");
+  }
+
+  SECTION("allocates its tables with the allocator") {
+    SpyingAllocator spy;
+    filter["a"] = true;
+    filter["b"] = true;
+
+    size_t size;
+    {
+      DeserializationOption::CompiledFilter compiled(filter, &spy);
+      REQUIRE(compiled.overflowed() == false);
+      size = compiled.size();
+    }
+
+    REQUIRE(spy.log() == AllocatorLog{
+                             Allocate(size),
+                             Deallocate(size),
+                         });
+  }
+
+  SECTION("rejects everything when allocation fails") {
+    KillswitchAllocator killswitch;
+    killswitch.on();
+    filter["a"] = true;
+    DeserializationOption::CompiledFilter compiled(filter, &killswitch);
+
+    REQUIRE(compiled.overflowed() == true);
+    REQUIRE(deserializeJson(doc, "{\"a\":1}", compiled) ==
+            DeserializationError::Ok);
+    REQUIRE(doc.isNull());
+  }
+}
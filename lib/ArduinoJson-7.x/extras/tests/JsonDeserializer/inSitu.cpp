@@ -0,0 +1,124 @@
+// ArduinoJson - https://arduinojson.org
+// Copyright © 2014-2025, Benoit BLANCHON
+// MIT License
+
+#include <ArduinoJson.h>
+#include <catch.hpp>
+
+#include <string.h>
+
+#include "Allocators.hpp"
+#include "Literals.hpp"
+
+using ArduinoJson::detail::sizeofObject;
+
+static bool pointsInto(const char* p, const char* buffer, size_t size) {
+  return p >= buffer && p < buffer + size;
+}
+
+TEST_CASE("deserializeJson(char*, size_t, InSitu)") {
+  SpyingAllocator spy;
+  JsonDocument doc(&spy);
+  char input[128];
+
+  SECTION("strings point into the input") {
+    strcpy(input, "{\"hex\":\"4b1a2c\",\"flight\":\"SWR123  \"}");
+    size_t n = strlen(input);
+
+    DeserializationError err =
+        deserializeJson(doc, input, n, DeserializationOption::InSitu());
+
+    REQUIRE(err == DeserializationError::Ok);
+    REQUIRE(doc["hex"] == "4b1a2c");
+    REQUIRE(doc["flight"] == "SWR123  ");
+    REQUIRE(pointsInto(doc["hex"].as<const char*>(), input, n));
+    REQUIRE(pointsInto(doc["flight"].as<const char*>(), input, n));
+    auto flight = ++doc.as<JsonObject>().begin();
+    REQUIRE(pointsInto(flight->key().c_str(), input, n));
+  }
+
+  SECTION("doesn't allocate strings") {
+    strcpy(input, "{\"hello\":\"world!\"}");
+
+    deserializeJson(doc, input, strlen(input), DeserializationOption::InSitu());
+
+    REQUIRE(spy.log() == AllocatorLog{
+                             Allocate(sizeofPool()),
+                             Reallocate(sizeofPool(), sizeofObject(1)),
+                         });
+  }
+
+  SECTION("unescapes strings") {
+    strcpy(input, "[\"a\\\"b\\\\c\\u00e9\",\"\\n\\t end\"]");
+
+    deserializeJson(doc, input, strlen(input), DeserializationOption::InSitu());
+
+    REQUIRE(doc[0] == "a\"b\\c\xC3\xA9");
+    REQUIRE(doc[1] == "\n\t end");
+  }
+
+  SECTION("unquoted keys") {
+    strcpy(input, "{hello:'world',foo:[\"bar\"]}");
+
+    deserializeJson(doc, input, strlen(input), DeserializationOption::InSitu());
+
+    REQUIRE(doc.as<std::string>() == "{\"hello\":\"world\",\"foo\":[\"bar\"]}");
+  }
+
+  SECTION("tiny strings are stored in the variant") {
+    strcpy(input, "[\"abc\",\"abcd\"]");
+    size_t n = strlen(input);
+
+    deserializeJson(doc, input, n, DeserializationOption::InSitu());
+
+    REQUIRE(doc[0] == "abc");
+    REQUIRE_FALSE(pointsInto(doc[0].as<const char*>(), input, n));
+    REQUIRE(pointsInto(doc[1].as<const char*>(), input, n));
+  }
+
+  SECTION("strings with NUL are copied") {
+    strcpy(input, "[\"abc\\u0000def\"]");
+
+    deserializeJson(doc, input, strlen(input), DeserializationOption::InSitu());
+
+    REQUIRE(doc[0] == "abc\0def"_s);
+  }
+
+  SECTION("filter") {
+    strcpy(input,
+           "[{\"hex\":\"4b1a2c\",\"rssi\":-20.5,\"mlat\":[\"lat\",\"lon\"]},"
+           "{\"type\":\"adsb_icao\",\"hex\":\"3c6544\"}]");
+    JsonDocument filter;
+    filter[0]["hex"] = true;
+
+    DeserializationError err = deserializeJson(
+        doc, input, strlen(input), DeserializationOption::InSitu(),
+        DeserializationOption::Filter(filter));
+
+    REQUIRE(err == DeserializationError::Ok);
+    REQUIRE(doc.as<std::string>() ==
+            "[{\"hex\":\"4b1a2c\"},{\"hex\":\"3c6544\"}]");
+  }
+
+  SECTION("copies own their strings") {
+    strcpy(input, "{\"flight\":\"SWR123\"}");
+    deserializeJson(doc, input, strlen(input), DeserializationOption::InSitu());
+
+    JsonDocument copy(doc);
+    memset(input, 'x', sizeof(input));
+
+    REQUIRE(copy["flight"] == "SWR123");
+  }
+
+  SECTION("errors") {
+    strcpy(input, "{\"hello\":\"wor");
+    REQUIRE(deserializeJson(doc, input, strlen(input),
+                            DeserializationOption::InSitu()) ==
+            DeserializationError::IncompleteInput);
+
+    strcpy(input, "{abcdef");
+    REQUIRE(deserializeJson(doc, input, strlen(input),
+                            DeserializationOption::InSitu()) ==
+            DeserializationError::IncompleteInput);
+  }
+}
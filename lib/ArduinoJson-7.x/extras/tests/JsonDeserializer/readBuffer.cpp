@@ -0,0 +1,121 @@
+// ArduinoJson - https://arduinojson.org
+// Copyright © 2014-2025, Benoit BLANCHON
+// MIT License
+
+#include <ArduinoJson.h>
+#include <catch.hpp>
+
+#include <sstream>
+
+#include "Literals.hpp"
+
+TEST_CASE("deserializeJson(std::istream&, ReadBuffer)") {
+  JsonDocument doc;
+  char data[64];
+  DeserializationOption::ReadBuffer readBuffer(data);
+
+  SECTION("parses the input") {
+    std::istringstream json("{\"hello\":\"world\",\"n\":[1,2,3]}");
+
+    DeserializationError err = deserializeJson(doc, json, readBuffer);
+
+    REQUIRE(err == DeserializationError::Ok);
+    REQUIRE(doc.as<std::string>() == "{\"hello\":\"world\",\"n\":[1,2,3]}");
+  }
+
+  SECTION("keeps the bytes that follow the root value") {
+    std::istringstream json("{\"a\":1} [2] 3");
+
+    REQUIRE(deserializeJson(doc, json, readBuffer) == DeserializationError::Ok);
+    REQUIRE(doc.as<std::string>() == "{\"a\":1}");
+    REQUIRE(readBuffer.available() == 6);
+
+    REQUIRE(deserializeJson(doc, json, readBuffer) == DeserializationError::Ok);
+    REQUIRE(doc.as<std::string>() == "[2]");
+    REQUIRE(readBuffer.available() == 2);
+
+    char rest[8] = {};
+    REQUIRE(readBuffer.readBytes(rest, sizeof(rest)) == 2);
+    REQUIRE(rest == " 3"_s);
+    REQUIRE(readBuffer.available() == 0);
+  }
+
+  SECTION("clear() drops the remaining bytes") {
+    std::istringstream json("[1][2]");
+
+    REQUIRE(deserializeJson(doc, json, readBuffer) == DeserializationError::Ok);
+    readBuffer.clear();
+
+    REQUIRE(deserializeJson(doc, json, readBuffer) ==
+            DeserializationError::EmptyInput);
+  }
+
+  SECTION("input larger than the buffer") {
+    std::string input = "[";
+    for (int i = 0; i < 100; i++)
+      input += std::to_string(i) + (i < 99 ? "," : "]");
+    std::istringstream json(input);
+
+    DeserializationError err = deserializeJson(doc, json, readBuffer);
+
+    REQUIRE(err == DeserializationError::Ok);
+    REQUIRE(doc.size() == 100);
+    REQUIRE(doc[99] == 99);
+  }
+
+  SECTION("one-byte buffer") {
+    char tiny[1];
+    DeserializationOption::ReadBuffer tinyBuffer(tiny);
+    std::istringstream json("{\"a\":[true]}x");
+
+    REQUIRE(deserializeJson(doc, json, tinyBuffer) == DeserializationError::Ok);
+    REQUIRE(doc["a"][0] == true);
+    REQUIRE(tinyBuffer.available() == 0);
+    REQUIRE(json.get() == 'x');
+  }
+
+  SECTION("incomplete input") {
+    std::istringstream json("{\"a\":");
+
+    DeserializationError err = deserializeJson(doc, json, readBuffer);
+
+    REQUIRE(err == DeserializationError::IncompleteInput);
+  }
+
+  SECTION("with other options, in any order") {
+    JsonDocument filter;
+    filter["a"] = true;
+    std::istringstream json("{\"a\":[1],\"b\":2}{\"a\":[[1]]}");
+
+    REQUIRE(deserializeJson(doc, json, DeserializationOption::Filter(filter),
+                            readBuffer) == DeserializationError::Ok);
+    REQUIRE(doc.as<std::string>() == "{\"a\":[1]}");
+
+    REQUIRE(deserializeJson(doc, json, readBuffer,
+                            DeserializationOption::NestingLimit(1),
+                            DeserializationOption::Filter(filter)) ==
+            DeserializationError::TooDeep);
+  }
+
+  SECTION("temporary buffer") {
+    std::istringstream json("[42]");
+
+    DeserializationError err = deserializeJson(
+        doc, json, DeserializationOption::ReadBuffer(data, sizeof(data)));
+
+    REQUIRE(err == DeserializationError::Ok);
+    REQUIRE(doc[0] == 42);
+  }
+}
+
+TEST_CASE("deserializeJson(const char*, ReadBuffer)") {
+  JsonDocument doc;
+  char data[4];
+  DeserializationOption::ReadBuffer readBuffer(data);
+
+  DeserializationError err =
+      deserializeJson(doc, "{\"hello\":\"world\"}", readBuffer);
+
+  REQUIRE(err == DeserializationError::Ok);
+  REQUIRE(doc["hello"] == "world");
+}
@@ -0,0 +1,54 @@
+// ArduinoJson - https://arduinojson.org
+// Copyright © 2014-2025, Benoit BLANCHON
+// MIT License
+
+#include <ArduinoJson.h>
+#include <catch.hpp>
+
+#include "trace.hpp"
+
+TEST_CASE("JsonPullParser errors") {
+  SECTION("EmptyInput") {
+    REQUIRE(trace("") == "Error:EmptyInput");
+    REQUIRE(trace("  ") == "Error:EmptyInput");
+  }
+
+  SECTION("IncompleteInput") {
+    REQUIRE(trace("{") == "{ Error:IncompleteInput");
+    REQUIRE(trace("[1,") == "[ I:1 Error:IncompleteInput");
+    REQUIRE(trace("{\"a\":") == "{ K:a Error:IncompleteInput");
+    REQUIRE(trace("\"abc") == "Error:IncompleteInput");
+    REQUIRE(trace("tru") == "Error:IncompleteInput");
+  }
+
+  SECTION("InvalidInput") {
+    REQUIRE(trace("[1 2]") == "[ I:1 Error:InvalidInput");
+    REQUIRE(trace("{\"a\" 1}") == "{ Error:InvalidInput");
+    REQUIRE(trace("[1,]") == "[ I:1 Error:InvalidInput");
+    REQUIRE(trace("{\"a\":1,}") == "{ K:a I:1 Error:InvalidInput");
+    REQUIRE(trace("[-]") == "[ Error:InvalidInput");
+    REQUIRE(trace("[truth]") == "[ Error:InvalidInput");
+    REQUIRE(trace("\"\\q\"") == "Error:InvalidInput");
+  }
+
+  SECTION("NoMemory when a string doesn't fit in the buffer") {
+    std::string input =
+        "[\"" + std::string(ARDUINOJSON_PULL_PARSER_BUFFER_SIZE, 'x') + "\"]";
+    REQUIRE(trace(input) == "[ Error:NoMemory");
+  }
+
+  SECTION("NoMemory when a key doesn't fit in the buffer") {
+    std::string input =
+        "{\"" + std::string(ARDUINOJSON_PULL_PARSER_BUFFER_SIZE, 'x') + "\":1}";
+    REQUIRE(trace(input) == "{ Error:NoMemory");
+  }
+
+  SECTION("Error is sticky") {
+    auto parser = makeJsonPullParser("[1 2]");
+    REQUIRE(parser.next() == JsonEvent::BeginArray);
+    REQUIRE(parser.next() == JsonEvent::Number);
+    REQUIRE(parser.next() == JsonEvent::Error);
+    REQUIRE(parser.next() == JsonEvent::Error);
+    REQUIRE(parser.error() == DeserializationError::InvalidInput);
+  }
+}
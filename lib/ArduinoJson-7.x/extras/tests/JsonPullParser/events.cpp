@@ -0,0 +1,127 @@
+// ArduinoJson - https://arduinojson.org
+// Copyright © 2014-2025, Benoit BLANCHON
+// MIT License
+
+#include <ArduinoJson.h>
+#include <catch.hpp>
+
+#include "trace.hpp"
+
+TEST_CASE("JsonPullParser events") {
+  SECTION("scalar roots") {
+    REQUIRE(trace("42") == "I:42 End");
+    REQUIRE(trace("-3.5") == "F:-3.5 End");
+    REQUIRE(trace("\"hello\"") == "S:hello End");
+    REQUIRE(trace("true") == "true End");
+    REQUIRE(trace("false") == "false End");
+    REQUIRE(trace("null") == "null End");
+  }
+
+  SECTION("empty containers") {
+    REQUIRE(trace("{}") == "{ } End");
+    REQUIRE(trace("[]") == "[ ] End");
+    REQUIRE(trace(" [ ] ") == "[ ] End");
+  }
+
+  SECTION("object") {
+    REQUIRE(trace("{\"a\":1,\"b\":\"x\",\"c\":true,\"d\":null}") ==
+            "{ K:a I:1 K:b S:x K:c true K:d null } End");
+  }
+
+  SECTION("array") {
+    REQUIRE(trace("[1, 2.5, \"three\", false, null]") ==
+            "[ I:1 F:2.5 S:three false null ] End");
+  }
+
+  SECTION("nested containers") {
+    REQUIRE(trace("{\"now\":1.5,\"aircraft\":[{\"hex\":\"4b1a2c\"},{}]}") ==
+            "{ K:now F:1.5 K:aircraft [ { K:hex S:4b1a2c } { } ] } End");
+  }
+
+  SECTION("escape sequences") {
+    REQUIRE(trace("[\"a\\\"b\\\\c\\n\"]") == "[ S:a\"b\\c\n ] End");
+  }
+
+  SECTION("unicode escape") {
+    REQUIRE(trace("\"\\u00e9\"") == "S:\xC3\xA9 End");
+  }
+
+  SECTION("single quotes and unquoted keys") {
+    REQUIRE(trace("{key:'value'}") == "{ K:key S:value } End");
+  }
+
+  SECTION("End is sticky") {
+    auto parser = makeJsonPullParser("1");
+    REQUIRE(parser.next() == JsonEvent::Number);
+    REQUIRE(parser.next() == JsonEvent::End);
+    REQUIRE(parser.next() == JsonEvent::End);
+    REQUIRE(parser.error() == DeserializationError::Ok);
+  }
+
+  SECTION("depth()") {
+    auto parser = makeJsonPullParser("[{\"a\":[]}]");
+    REQUIRE(parser.depth() == 0);
+    REQUIRE(parser.next() == JsonEvent::BeginArray);
+    REQUIRE(parser.depth() == 1);
+    REQUIRE(parser.next() == JsonEvent::BeginObject);
+    REQUIRE(parser.depth() == 2);
+    REQUIRE(parser.next() == JsonEvent::Key);
+    REQUIRE(parser.next() == JsonEvent::BeginArray);
+    REQUIRE(parser.depth() == 3);
+    REQUIRE(parser.next() == JsonEvent::EndArray);
+    REQUIRE(parser.depth() == 2);
+    REQUIRE(parser.next() == JsonEvent::EndObject);
+    REQUIRE(parser.next() == JsonEvent::EndArray);
+    REQUIRE(parser.depth() == 0);
+    REQUIRE(parser.next() == JsonEvent::End);
+  }
+
+  SECTION("number<T>() converts like JsonVariant::as<T>()") {
+    auto parser = makeJsonPullParser("[300, 1.75, -1]");
+    REQUIRE(parser.next() == JsonEvent::BeginArray);
+
+    REQUIRE(parser.next() == JsonEvent::Number);
+    REQUIRE(parser.isInteger());
+    REQUIRE(parser.number<int>() == 300);
+    REQUIRE(parser.number<uint8_t>() == 0);  // out of range
+
+    REQUIRE(parser.next() == JsonEvent::Number);
+    REQUIRE_FALSE(parser.isInteger());
+    REQUIRE(parser.number<double>() == 1.75);
+    REQUIRE(parser.number<int>() == 1);
+
+    REQUIRE(parser.next() == JsonEvent::Number);
+    REQUIRE(parser.number<int>() == -1);
+    REQUIRE(parser.number<unsigned>() == 0);
+  }
+
+  SECTION("fixedPoint()") {
+    auto parser = makeJsonPullParser("[46.1234566, -7.25, 1e12, 3]");
+    int32_t x = 0;
+    REQUIRE(parser.next() == JsonEvent::BeginArray);
+
+    REQUIRE(parser.next() == JsonEvent::Number);
+    REQUIRE(parser.fixedPoint(x, 6));
+    REQUIRE(x == 46123457);
+
+    REQUIRE(parser.next() == JsonEvent::Number);
+    REQUIRE(parser.fixedPoint(x, 1));
+    REQUIRE(x == -73);
+
+    REQUIRE(parser.next() == JsonEvent::Number);
+    REQUIRE_FALSE(parser.fixedPoint(x, 0));  // out of range
+    REQUIRE(x == -73);
+
+    REQUIRE(parser.next() == JsonEvent::Number);
+    REQUIRE(parser.fixedPoint(x, 2));
+    REQUIRE(x == 300);
+  }
+
+  SECTION("string longer than the buffer") {
+    std::string input =
+        "\"" + std::string(ARDUINOJSON_PULL_PARSER_BUFFER_SIZE - 1, 'x') + "\"";
+    auto parser = makeJsonPullParser(input);
+    REQUIRE(parser.next() == JsonEvent::String);
+    REQUIRE(parser.string().size() == ARDUINOJSON_PULL_PARSER_BUFFER_SIZE - 1);
+  }
+}
@@ -0,0 +1,129 @@
+// ArduinoJson - https://arduinojson.org
+// Copyright © 2014-2025, Benoit BLANCHON
+// MIT License
+
+#include <ArduinoJson.h>
+#include <catch.hpp>
+
+#include "trace.hpp"
+
+TEST_CASE("JsonPullParser with a filter") {
+  JsonDocument filter;
+
+  SECTION("only keeps the selected members") {
+    filter["a"] = true;
+    filter["c"] = true;
+
+    REQUIRE(trace("{\"a\":1,\"b\":{\"x\":[1,2]},\"c\":\"y\",\"d\":[]}",
+                  DeserializationOption::Filter(filter)) ==
+            "{ K:a I:1 K:c S:y } End");
+  }
+
+  SECTION("applies the element filter to each array element") {
+    filter["now"] = true;
+    filter["aircraft"][0]["hex"] = true;
+    filter["aircraft"][0]["lat"] = true;
+
+    REQUIRE(trace("{\"now\":1,\"messages\":99,\"aircraft\":["
+                  "{\"hex\":\"a\",\"rssi\":-20.5,\"lat\":46.5},"
+                  "{\"mlat\":[],\"hex\":\"b\"}]}",
+                  DeserializationOption::Filter(filter)) ==
+            "{ K:now I:1 K:aircraft [ { K:hex S:a K:lat F:46.5 } "
+            "{ K:hex S:b } ] } End");
+  }
+
+  SECTION("wildcard") {
+    filter["*"]["name"] = true;
+
+    REQUIRE(trace("{\"x\":{\"name\":\"a\",\"age\":1},\"y\":{\"age\":2}}",
+                  DeserializationOption::Filter(filter)) ==
+            "{ K:x { K:name S:a } K:y { } } End");
+  }
+
+  SECTION("member of the wrong type is reported as null") {
+    filter["a"]["b"] = true;
+
+    REQUIRE(trace("{\"a\":42}", DeserializationOption::Filter(filter)) ==
+            "{ K:a null } End");
+  }
+
+  SECTION("filter rejects the root") {
+    filter.set(false);
+
+    REQUIRE(trace("{\"a\":42}", DeserializationOption::Filter(filter)) ==
+            "null End");
+  }
+
+  SECTION("filter is true") {
+    filter.set(true);
+
+    REQUIRE(trace("{\"a\":[1,{\"b\":2}]}",
+                  DeserializationOption::Filter(filter)) ==
+            "{ K:a [ I:1 { K:b I:2 } ] } End");
+  }
+
+  SECTION("skipped values are still validated") {
+    filter["a"] = true;
+
+    REQUIRE(trace("{\"a\":1,\"b\":[1,}",
+                  DeserializationOption::Filter(filter)) ==
+            "{ K:a I:1 Error:InvalidInput");
+  }
+
+  SECTION("skipped strings can be longer than the buffer") {
+    filter["a"] = true;
+    std::string longString(ARDUINOJSON_PULL_PARSER_BUFFER_SIZE * 2, 'x');
+    std::string input = "{\"b\":\"" + longString + "\",\"a\":2}";
+
+    REQUIRE(trace(input, DeserializationOption::Filter(filter)) ==
+            "{ K:a I:2 } End");
+  }
+
+  SECTION("keys longer than the buffer are skipped with their value") {
+    filter["a"] = true;
+    filter["c"] = true;
+    std::string longKey(ARDUINOJSON_PULL_PARSER_BUFFER_SIZE, 'x');
+    std::string input =
+        "{\"a\":1,\"" + longKey + "\":{\"y\":[1,\"z\"]},\"c\":2}";
+
+    REQUIRE(trace(input, DeserializationOption::Filter(filter)) ==
+            "{ K:a I:1 K:c I:2 } End");
+
+    DeserializationOption::CompiledFilter compiled(filter);
+    REQUIRE(trace(input, compiled) == "{ K:a I:1 K:c I:2 } End");
+  }
+
+  SECTION("NoMemory when a wildcard selects a key longer than the buffer") {
+    filter["*"] = true;
+    std::string longKey(ARDUINOJSON_PULL_PARSER_BUFFER_SIZE, 'x');
+    std::string input = "{\"a\":1,\"" + longKey + "\":2}";
+
+    REQUIRE(trace(input, DeserializationOption::Filter(filter)) ==
+            "{ K:a I:1 Error:NoMemory");
+
+    DeserializationOption::CompiledFilter compiled(filter);
+    REQUIRE(trace(input, compiled) == "{ K:a I:1 Error:NoMemory");
+  }
+
+  SECTION("filter and nesting limit") {
+    filter.set(true);
+
+    REQUIRE(trace("[[1]]", DeserializationOption::Filter(filter),
+                  DeserializationOption::NestingLimit(1)) ==
+            "[ Error:TooDeep");
+  }
+
+  SECTION("CompiledFilter") {
+    filter["now"] = true;
+    filter["aircraft"][0]["hex"] = true;
+    filter["aircraft"][0]["lat"] = true;
+    DeserializationOption::CompiledFilter compiled(filter);
+
+    REQUIRE(trace("{\"now\":1,\"messages\":99,\"aircraft\":["
+                  "{\"hex\":\"a\",\"rssi\":-20.5,\"lat\":46.5},"
+                  "{\"mlat\":[],\"hex\":\"b\"}]}",
+                  compiled) ==
+            "{ K:now I:1 K:aircraft [ { K:hex S:a K:lat F:46.5 } "
+            "{ K:hex S:b } ] } End");
+  }
+}
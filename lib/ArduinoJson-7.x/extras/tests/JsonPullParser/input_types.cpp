@@ -0,0 +1,56 @@
+// ArduinoJson - https://arduinojson.org
+// Copyright © 2014-2025, Benoit BLANCHON
+// MIT License
+
+#include <ArduinoJson.h>
+#include <catch.hpp>
+
+#include <sstream>
+
+#include "CustomReader.hpp"
+#include "trace.hpp"
+
+TEST_CASE("JsonPullParser input types") {
+  SECTION("const char*") {
+    REQUIRE(trace("[1]") == "[ I:1 ] End");
+  }
+
+  SECTION("char*, size_t") {
+    char input[] = "[1][2]";
+    REQUIRE(trace(input, size_t(3)) == "[ I:1 ] End");
+  }
+
+  SECTION("char*, size too short") {
+    char input[] = "[1]";
+    REQUIRE(trace(input, 2) == "[ I:1 Error:IncompleteInput");
+  }
+
+  SECTION("std::string") {
+    REQUIRE(trace(std::string("{\"a\":1}")) == "{ K:a I:1 } End");
+  }
+
+  SECTION("std::istream") {
+    std::istringstream input("[true]");
+    REQUIRE(trace(input) == "[ true ] End");
+  }
+
+  SECTION("custom reader") {
+    CustomReader reader("[null]");
+    REQUIRE(trace(reader) == "[ null ] End");
+  }
+
+  SECTION("std::istream with a ReadBuffer") {
+    std::istringstream input("{\"a\":[1,2]} [3]");
+    char data[5];
+    DeserializationOption::ReadBuffer readBuffer(data);
+
+    REQUIRE(trace(input, readBuffer) == "{ K:a [ I:1 I:2 ] } End");
+    REQUIRE(trace(input, readBuffer) == "[ I:3 ] End");
+  }
+
+  SECTION("stops reading after the root value") {
+    std::istringstream input("{\"a\":1} [2]");
+    REQUIRE(trace(input) == "{ K:a I:1 } End");
+    REQUIRE(input.get() == ' ');
+  }
+}
@@ -0,0 +1,53 @@
+// ArduinoJson - https://arduinojson.org
+// Copyright © 2014-2025, Benoit BLANCHON
+// MIT License
+
+#include <ArduinoJson.h>
+#include <catch.hpp>
+
+#include "trace.hpp"
+
+TEST_CASE("JsonPullParser nesting") {
+  SECTION("limit = 0") {
+    DeserializationOption::NestingLimit nesting(0);
+    REQUIRE(trace("\"toto\"", nesting) == "S:toto End");
+    REQUIRE(trace("123", nesting) == "I:123 End");
+    REQUIRE(trace("[]", nesting) == "Error:TooDeep");
+    REQUIRE(trace("{}", nesting) == "Error:TooDeep");
+  }
+
+  SECTION("limit = 1") {
+    DeserializationOption::NestingLimit nesting(1);
+    REQUIRE(trace("[\"toto\"]", nesting) == "[ S:toto ] End");
+    REQUIRE(trace("{\"toto\":1}", nesting) == "{ K:toto I:1 } End");
+    REQUIRE(trace("{\"toto\":{}}", nesting) == "{ K:toto Error:TooDeep");
+    REQUIRE(trace("[[\"toto\"]]", nesting) == "[ Error:TooDeep");
+  }
+
+  SECTION("skipped values count too") {
+    JsonDocument filter;
+    filter["a"] = true;
+    DeserializationOption::NestingLimit nesting(1);
+
+    REQUIRE(trace("{\"b\":[],\"a\":1}", DeserializationOption::Filter(filter),
+                  nesting) == "{ Error:TooDeep");
+  }
+
+  SECTION("default limit") {
+    std::string deep(ARDUINOJSON_DEFAULT_NESTING_LIMIT, '[');
+    deep += std::string(ARDUINOJSON_DEFAULT_NESTING_LIMIT, ']');
+    auto parser = makeJsonPullParser(deep);
+    JsonEvent event;
+    do {
+      event = parser.next();
+    } while (event != JsonEvent::End && event != JsonEvent::Error);
+    REQUIRE(parser.error() == DeserializationError::Ok);
+
+    std::string tooDeep = "[" + deep + "]";
+    auto parser2 = makeJsonPullParser(tooDeep);
+    do {
+      event = parser2.next();
+    } while (event != JsonEvent::End && event != JsonEvent::Error);
+    REQUIRE(parser2.error() == DeserializationError::TooDeep);
+  }
+}
@@ -0,0 +1,60 @@
+// ArduinoJson - https://arduinojson.org
+// Copyright © 2014-2025, Benoit BLANCHON
+// MIT License
+
+#include <ArduinoJson.h>
+#include <catch.hpp>
+
+#include "trace.hpp"
+
+TEST_CASE("JsonPullParser::skip()") {
+  SECTION("after Key, skips the value") {
+    auto parser = makeJsonPullParser("{\"a\":{\"x\":[1,2]},\"b\":2}");
+    REQUIRE(parser.next() == JsonEvent::BeginObject);
+    REQUIRE(parser.next() == JsonEvent::Key);
+    parser.skip();
+    REQUIRE(drain(parser) == "K:b I:2 } End");
+  }
+
+  SECTION("after BeginObject, skips the rest of the object") {
+    auto parser = makeJsonPullParser("[{\"a\":1,\"b\":[{}]},3]");
+    REQUIRE(parser.next() == JsonEvent::BeginArray);
+    REQUIRE(parser.next() == JsonEvent::BeginObject);
+    parser.skip();
+    REQUIRE(parser.depth() == 1);
+    REQUIRE(drain(parser) == "I:3 ] End");
+  }
+
+  SECTION("after BeginArray, skips the rest of the array") {
+    auto parser = makeJsonPullParser("{\"a\":[1,[2],\"]\"],\"b\":true}");
+    REQUIRE(parser.next() == JsonEvent::BeginObject);
+    REQUIRE(parser.next() == JsonEvent::Key);
+    REQUIRE(parser.next() == JsonEvent::BeginArray);
+    parser.skip();
+    REQUIRE(drain(parser) == "K:b true } End");
+  }
+
+  SECTION("skipping the root object") {
+    auto parser = makeJsonPullParser("{\"a\":1}");
+    REQUIRE(parser.next() == JsonEvent::BeginObject);
+    parser.skip();
+    REQUIRE(parser.next() == JsonEvent::End);
+  }
+
+  SECTION("after a scalar, does nothing") {
+    auto parser = makeJsonPullParser("[1,2]");
+    REQUIRE(parser.next() == JsonEvent::BeginArray);
+    REQUIRE(parser.next() == JsonEvent::Number);
+    parser.skip();
+    REQUIRE(drain(parser) == "I:2 ] End");
+  }
+
+  SECTION("reports errors in the skipped value") {
+    auto parser = makeJsonPullParser("{\"a\":[1,}");
+    REQUIRE(parser.next() == JsonEvent::BeginObject);
+    REQUIRE(parser.next() == JsonEvent::Key);
+    parser.skip();
+    REQUIRE(parser.next() == JsonEvent::Error);
+    REQUIRE(parser.error() == DeserializationError::InvalidInput);
+  }
+}
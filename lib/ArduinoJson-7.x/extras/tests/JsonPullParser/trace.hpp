@@ -0,0 +1,63 @@
+// ArduinoJson - https://arduinojson.org
+// Copyright © 2014-2025, Benoit BLANCHON
+// MIT License
+
+#pragma once
+
+#include <ArduinoJson.h>
+
+#include <sstream>
+#include <string>
+
+// Drains a pull parser and returns its events as a space-separated string
+template <typename TParser>
+std::string drain(TParser& parser) {
+  std::ostringstream log;
+  for (;;) {
+    JsonEvent event = parser.next();
+    switch (event) {
+      case JsonEvent::End:
+        log << "End";
+        return log.str();
+      case JsonEvent::Error:
+        log << "Error:" << parser.error().c_str();
+        return log.str();
+      case JsonEvent::BeginObject:
+        log << "{ ";
+        break;
+      case JsonEvent::EndObject:
+        log << "} ";
+        break;
+      case JsonEvent::BeginArray:
+        log << "[ ";
+        break;
+      case JsonEvent::EndArray:
+        log << "] ";
+        break;
+      case JsonEvent::Key:
+        log << "K:" << parser.key().c_str() << " ";
+        break;
+      case JsonEvent::String:
+        log << "S:" << parser.string().c_str() << " ";
+        break;
+      case JsonEvent::Number:
+        if (parser.isInteger())
+          log << "I:" << parser.template number<long>() << " ";
+        else
+          log << "F:" << parser.template number<double>() << " ";
+        break;
+      case JsonEvent::Boolean:
+        log << (parser.boolean() ? "true " : "false ");
+        break;
+      case JsonEvent::Null:
+        log << "null ";
+        break;
+    }
+  }
+}
+
+template <typename... Args>
+std::string trace(Args&&... args) {
+  auto parser = makeJsonPullParser(args...);
+  return drain(parser);
+}
@@ -172,6 +172,10 @@ class StreamStub : public Stream {
  public:
   StreamStub(const char* s) : stream_(s) {}
 
+  int available() {
+    return static_cast<int>(stream_.rdbuf()->in_avail());
+  }
+
   int read() {
     return stream_.get();
   }
@@ -225,3 +229,39 @@ TEST_CASE("Reader<Stream>") {
     REQUIRE(buffer[6] == 'g');
   }
 }
+
+TEST_CASE("BufferedReader<Reader<Stream>>") {
+  StreamStub src("ABCDEFG");
+  char data[4];
+  ArduinoJson::DeserializationOption::ReadBuffer buffer(data);
+  BufferedReader<Reader<StreamStub>> reader(Reader<StreamStub>(src), &buffer);
+
+  SECTION("read() refills by blocks") {
+    REQUIRE(reader.read() == 'A');
+    REQUIRE(buffer.available() == 3);
+    REQUIRE(reader.read() == 'B');
+    REQUIRE(reader.read() == 'C');
+    REQUIRE(reader.read() == 'D');
+    REQUIRE(buffer.available() == 0);
+    REQUIRE(reader.read() == 'E');
+    REQUIRE(buffer.available() == 2);
+    REQUIRE(reader.read() == 'F');
+    REQUIRE(reader.read() == 'G');
+    REQUIRE(reader.read() == -1);
+  }
+
+  SECTION("readBytes() drains the buffer first") {
+    REQUIRE(reader.read() == 'A');
+
+    char bytes[8] = "abcdefg";
+    REQUIRE(reader.readBytes(bytes, 5) == 5);
+
+    REQUIRE(bytes[0] == 'B');
+    REQUIRE(bytes[1] == 'C');
+    REQUIRE(bytes[2] == 'D');
+    REQUIRE(bytes[3] == 'E');
+    REQUIRE(bytes[4] == 'F');
+    REQUIRE(bytes[5] == 'f');
+    REQUIRE(reader.read() == 'G');
+  }
+}
@@ -1626,3 +1626,30 @@ TEST_CASE("Overloads") {
   }
 #endif
 }
+
+static bool xAtMostTen(JsonVariantConst element, JsonString key) {
+  if (key.isNull())
+    return element["x"].is<int>();
+  if (key == "x")
+    return element["x"].as<int>() <= 10;
+  return true;
+}
+
+TEST_CASE("deserializeMsgPack() with an element predicate") {
+  JsonDocument doc;
+  JsonDocument filter;
+  filter[0] = true;
+  DeserializationOption::Filter filterOpt(filter, filter, xAtMostTen);
+
+  // [{"x":5},{"x":50,"y":{"a":[1]}},{"y":1},{"x":7}]
+  auto error = deserializeMsgPack(doc,
+                                  "\x94"
+                                  "\x81\xA1x\x05"
+                                  "\x82\xA1x\x32\xA1y\x81\xA1" "a\x91\x01"
+                                  "\x81\xA1y\x01"
+                                  "\x81\xA1x\x07",
+                                  24, filterOpt);
+
+  REQUIRE(error == DeserializationError::Ok);
+  REQUIRE(doc.as<std::string>() == "[{\"x\":5},{\"x\":7}]");
+}
@@ -5,6 +5,8 @@
 #include <ArduinoJson.h>
 #include <catch.hpp>
 
+#include <sstream>
+
 #include "CustomReader.hpp"
 #include "Literals.hpp"
 
@@ -94,3 +96,24 @@ TEST_CASE("deserializeMsgPack(CustomReader)") {
   REQUIRE(doc[0] == "Hello");
   REQUIRE(doc[1] == "world");
 }
+
+TEST_CASE("deserializeMsgPack(std::istream&, ReadBuffer)") {
+  JsonDocument doc;
+  char data[4];
+  DeserializationOption::ReadBuffer readBuffer(data);
+
+  SECTION("strings longer than the buffer") {
+    std::istringstream input("\x92\xA5hello\xA5world\x01");
+
+    DeserializationError err = deserializeMsgPack(doc, input, readBuffer);
+
+    REQUIRE(err == DeserializationError::Ok);
+    REQUIRE(doc[0] == "hello");
+    REQUIRE(doc[1] == "world");
+
+    char next = 0;
+    if (readBuffer.readBytes(&next, 1) == 0)
+      next = char(input.get());
+    REQUIRE(next == '\x01');
+  }
+}
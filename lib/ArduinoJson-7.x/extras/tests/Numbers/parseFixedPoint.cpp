@@ -0,0 +1,123 @@
+// ArduinoJson - https://arduinojson.org
+// Copyright © 2014-2025, Benoit BLANCHON
+// MIT License
+
+#include <ArduinoJson.hpp>
+#include <stdint.h>
+#include <catch.hpp>
+
+using namespace ArduinoJson::detail;
+
+template <typename T>
+static bool parseFixedPoint(const char* s, uint8_t decimals, T& result) {
+  return parseDecimal(s).toFixedPoint(result, decimals);
+}
+
+TEST_CASE("parseDecimal().toFixedPoint()") {
+  int32_t x = 42;
+
+  SECTION("integer") {
+    REQUIRE(parseFixedPoint("12", 0, x));
+    REQUIRE(x == 12);
+    REQUIRE(parseFixedPoint("12", 3, x));
+    REQUIRE(x == 12000);
+    REQUIRE(parseFixedPoint("-12", 1, x));
+    REQUIRE(x == -120);
+  }
+
+  SECTION("exact decimal") {
+    REQUIRE(parseFixedPoint("46.123456", 6, x));
+    REQUIRE(x == 46123456);
+    REQUIRE(parseFixedPoint("-7.5", 1, x));
+    REQUIRE(x == -75);
+    REQUIRE(parseFixedPoint("0.1", 1, x));
+    REQUIRE(x == 1);
+  }
+
+  SECTION("trailing zeros") {
+    REQUIRE(parseFixedPoint("1.50000000", 1, x));
+    REQUIRE(x == 15);
+  }
+
+  SECTION("rounds to nearest") {
+    REQUIRE(parseFixedPoint("46.1234564", 6, x));
+    REQUIRE(x == 46123456);
+    REQUIRE(parseFixedPoint("46.1234566", 6, x));
+    REQUIRE(x == 46123457);
+    REQUIRE(parseFixedPoint("-46.1234566", 6, x));
+    REQUIRE(x == -46123457);
+    REQUIRE(parseFixedPoint("0.04", 1, x));
+    REQUIRE(x == 0);
+  }
+
+  SECTION("rounds halfway cases away from zero") {
+    REQUIRE(parseFixedPoint("0.25", 1, x));
+    REQUIRE(x == 3);
+    REQUIRE(parseFixedPoint("-0.25", 1, x));
+    REQUIRE(x == -3);
+    REQUIRE(parseFixedPoint("2.5", 0, x));
+    REQUIRE(x == 3);
+  }
+
+  SECTION("doesn't round twice") {
+    REQUIRE(parseFixedPoint("0.149", 1, x));
+    REQUIRE(x == 1);
+  }
+
+  SECTION("exponent") {
+    REQUIRE(parseFixedPoint("1.5e2", 0, x));
+    REQUIRE(x == 150);
+    REQUIRE(parseFixedPoint("15e-1", 1, x));
+    REQUIRE(x == 15);
+    REQUIRE(parseFixedPoint("1e-30", 6, x));
+    REQUIRE(x == 0);
+  }
+
+  SECTION("negative zero") {
+    REQUIRE(parseFixedPoint("-0.0", 3, x));
+    REQUIRE(x == 0);
+  }
+
+  SECTION("range of int32_t") {
+    REQUIRE(parseFixedPoint("2147483647", 0, x));
+    REQUIRE(x == 2147483647);
+    REQUIRE(parseFixedPoint("-2147483648", 0, x));
+    REQUIRE(x == -2147483647 - 1);
+    REQUIRE(parseFixedPoint("-214748364.8", 1, x));
+    REQUIRE(x == -2147483647 - 1);
+  }
+
+  SECTION("out of range") {
+    REQUIRE_FALSE(parseFixedPoint("2147483648", 0, x));
+    REQUIRE_FALSE(parseFixedPoint("214748364.75", 1, x));
+    REQUIRE_FALSE(parseFixedPoint("-2147483649", 0, x));
+    REQUIRE_FALSE(parseFixedPoint("1e300", 0, x));
+    REQUIRE(x == 42);
+  }
+
+  SECTION("not a number") {
+    REQUIRE_FALSE(parseFixedPoint("6a3", 0, x));
+    REQUIRE_FALSE(parseFixedPoint("NaN", 0, x));
+    REQUIRE_FALSE(parseFixedPoint("-Infinity", 0, x));
+    REQUIRE(x == 42);
+  }
+
+  SECTION("unsigned") {
+    uint16_t u = 42;
+    REQUIRE(parseFixedPoint("655.35", 2, u));
+    REQUIRE(u == 65535);
+    REQUIRE(parseFixedPoint("-0.004", 2, u));
+    REQUIRE(u == 0);
+    REQUIRE_FALSE(parseFixedPoint("-0.005", 2, u));
+    REQUIRE_FALSE(parseFixedPoint("655.355", 2, u));
+    REQUIRE(u == 0);
+  }
+
+  SECTION("int8_t") {
+    int8_t i = 42;
+    REQUIRE(parseFixedPoint("-12.8", 1, i));
+    REQUIRE(i == -128);
+    REQUIRE_FALSE(parseFixedPoint("12.8", 1, i));
+    REQUIRE(i == -128);
+  }
+}
@@ -34,6 +34,27 @@ inline VariantData* VariantImpl::addNewElement(VariantData* data,
   return slot.ptr();
 }
 
+inline void VariantImpl::removeLastElement(SlotId previous, VariantData* data,
+                                           ResourceManager* resources) {
+  ARDUINOJSON_ASSERT(data != nullptr);
+  ARDUINOJSON_ASSERT(data->isArray());
+  ARDUINOJSON_ASSERT(resources != nullptr);
+
+  auto coll = &data->content.asCollection;
+  auto last = coll->tail;
+  ARDUINOJSON_ASSERT(last != NULL_SLOT);
+
+  if (previous != NULL_SLOT) {
+    ARDUINOJSON_ASSERT(resources->getVariant(previous)->next == last);
+    resources->getVariant(previous)->next = NULL_SLOT;
+  } else {
+    coll->head = NULL_SLOT;
+  }
+  coll->tail = previous;
+
+  freeVariant({resources->getVariant(last), last}, resources);
+}
+
 inline VariantData* VariantImpl::getOrAddElement(size_t index) {
   auto it = createIterator();
   while (!it.done() && index > 0) {
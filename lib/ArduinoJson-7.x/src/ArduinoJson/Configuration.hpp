@@ -265,6 +265,12 @@
 #  define ARDUINOJSON_STRING_BUFFER_SIZE 32
 #endif
 
+// Capacity of the buffer that JsonPullParser uses for keys, strings, and
+// numbers (including the terminator)
+#ifndef ARDUINOJSON_PULL_PARSER_BUFFER_SIZE
+#  define ARDUINOJSON_PULL_PARSER_BUFFER_SIZE 64
+#endif
+
 #ifndef ARDUINOJSON_DEBUG
 #  ifdef __PLATFORMIO_BUILD_DEBUG__
 #    define ARDUINOJSON_DEBUG 1
@@ -0,0 +1,354 @@
+// ArduinoJson - https://arduinojson.org
+// Copyright © 2014-2025, Benoit BLANCHON
+// MIT License
+
+#pragma once
+
+#include <ArduinoJson/Deserialization/Filter.hpp>
+#include <ArduinoJson/Memory/Allocator.hpp>
+#include <ArduinoJson/Polyfills/type_traits.hpp>
+#include <ArduinoJson/Strings/StringAdapters.hpp>
+
+#include <string.h>  // memcmp
+
+ARDUINOJSON_BEGIN_PRIVATE_NAMESPACE
+class CompiledFilterRef;
+ARDUINOJSON_END_PRIVATE_NAMESPACE
+
+ARDUINOJSON_BEGIN_PUBLIC_NAMESPACE
+
+namespace DeserializationOption {
+// A Filter compiled once into one hash table per object of the filter
+// document, so that deserializeJson() finds the filter of a key with a
+// single probe instead of comparing it with each member of the filter.
+// A key the filter doesn't know is rejected after hashing its length and
+// three of its characters, most often without any string comparison.
+// Keys aren't copied: the filter document must outlive the CompiledFilter
+// and must not be modified.
+class CompiledFilter {
+  friend class detail::CompiledFilterRef;
+
+ public:
+  explicit CompiledFilter(
+      JsonVariantConst filter,
+      Allocator* allocator = detail::DefaultAllocator::instance())
+      : CompiledFilter(filter, JsonVariantConst(), nullptr, allocator) {}
+
+  // Same as Filter(filter, array, keep)
+  CompiledFilter(JsonVariantConst filter, JsonVariantConst array,
+                 Filter::ElementPredicate keep,
+                 Allocator* allocator = detail::DefaultAllocator::instance())
+      : allocator_(allocator),
+        block_(nullptr),
+        nodes_(nullptr),
+        slots_(nullptr),
+        keep_(keep),
+        root_(Reject),
+        nodeCount_(BuiltinNodeCount),
+        slotCount_(0) {
+    compile(filter, array);
+  }
+
+  CompiledFilter(const CompiledFilter&) = delete;
+  CompiledFilter& operator=(const CompiledFilter&) = delete;
+
+  ~CompiledFilter() {
+    if (block_)
+      allocator_->deallocate(block_);
+  }
+
+  // Returns true if the tables couldn't be allocated.
+  // The filter then rejects everything.
+  bool overflowed() const {
+    return !block_;
+  }
+
+  // Returns the number of bytes allocated for the tables
+  size_t size() const {
+    return block_ ? blockSize(nodeCount_, slotCount_) : 0;
+  }
+
+ private:
+  enum : uint8_t {
+    Allow = 1,
+    AllowValue = 2,
+    AllowArray = 4,
+    AllowObject = 8,
+    CheckElements = 16,
+    PerfectHash = 32,  // misses never need a second probe
+  };
+
+  enum : uint16_t {
+    Reject,
+    AllowAll,  // "true"
+    AllowKey,  // any other truthy value: keep the key, not the value
+    BuiltinNodeCount,
+  };
+
+  struct Node {
+    uint8_t flags;
+    uint8_t seed;
+    uint16_t child;  // object: the "*" member, array: the elements
+    uint16_t table;  // object: index of the first slot of the hash table
+    uint16_t mask;   // object: size of the hash table minus one
+  };
+
+  struct Slot {
+    const char* key;  // null if the slot is free
+    size_t length;
+    uint16_t node;
+  };
+
+  static const Node* builtinNodes() {
+    static const Node nodes[] = {
+        {0, 0, Reject, 0, 0},
+        {Allow | AllowValue | AllowArray | AllowObject, 0, AllowAll, 0, 0},
+        {Allow, 0, Reject, 0, 0},
+    };
+    return nodes;
+  }
+
+  static size_t blockSize(size_t nodes, size_t slots) {
+    return slots * sizeof(Slot) + nodes * sizeof(Node);
+  }
+
+  static uint16_t hash(const char* key, size_t length, uint8_t seed) {
+    uint32_t h = (uint32_t(seed) + 1) * 0x9e3779b1 ^ uint32_t(length);
+    if (length) {
+      h = (h ^ uint8_t(key[0])) * 0x01000193;
+      h = (h ^ uint8_t(key[length / 2])) * 0x01000193;
+      h = (h ^ uint8_t(key[length - 1])) * 0x01000193;
+    }
+    return uint16_t(h ^ (h >> 16));
+  }
+
+  // The first pass counts the nodes and slots, the second fills them
+  void compile(JsonVariantConst filter, JsonVariantConst array) {
+    build(filter, array);
+    if (nodeCount_ > 0xffff || slotCount_ > 0xffff)
+      return;
+
+    block_ = allocator_->allocate(blockSize(nodeCount_, slotCount_));
+    if (!block_)
+      return;
+
+    slots_ = reinterpret_cast<Slot*>(block_);
+    nodes_ = reinterpret_cast<Node*>(slots_ + slotCount_);
+    for (size_t i = 0; i < slotCount_; i++)
+      slots_[i].key = nullptr;
+    memcpy(nodes_, builtinNodes(), BuiltinNodeCount * sizeof(Node));
+
+    nodeCount_ = BuiltinNodeCount;
+    slotCount_ = 0;
+    root_ = build(filter, array);
+  }
+
+  // Returns the node for `filter`, after building its descendants.
+  // Only counts them during the first pass (when nodes_ is null).
+  size_t build(JsonVariantConst filter, JsonVariantConst array) {
+    bool isTarget = keep_ && !filter.isUnbound() &&
+                    detail::VariantAttorney::getData(filter) ==
+                        detail::VariantAttorney::getData(array);
+    bool isArray = filter.is<JsonArrayConst>();
+    bool isObject = filter.is<JsonObjectConst>();
+
+    if (filter == true && !isTarget)
+      return AllowAll;
+    if (!isArray && !isObject)
+      return filter == true ? AllowAll : filter ? AllowKey : Reject;
+
+    size_t index = nodeCount_++;
+    Node node = {0, 0, Reject, 0, 0};
+
+    if (filter == true) {  // the target array is filtered with "true"
+      node.flags = uint8_t(builtinNodes()[AllowAll].flags | CheckElements);
+      node.child = AllowAll;
+    } else if (isArray) {
+      node.flags = Allow | AllowArray;
+      if (isTarget)
+        node.flags |= CheckElements;
+      node.child = uint16_t(build(filter[0], array));
+    } else {
+      JsonObjectConst object = filter.as<JsonObjectConst>();
+      node.flags = Allow | AllowObject;
+      node.child = uint16_t(build(object["*"], array));
+      findPerfectHash(object, node);
+      node.table = uint16_t(slotCount_);
+      slotCount_ += size_t(node.mask) + 1;
+
+      for (JsonPairConst member : object) {
+        if (!isTableMember(member))
+          continue;
+        size_t child = build(member.value(), array);
+        if (nodes_)
+          insert(node, member.key(), uint16_t(child));
+      }
+    }
+
+    if (nodes_)
+      nodes_[index] = node;
+    return index;
+  }
+
+  // "*" is stored in Node::child, and null members fall back to it
+  static bool isTableMember(JsonPairConst member) {
+    return !member.value().isNull() && member.key() != "*";
+  }
+
+  // Picks the smallest table (at least twice the number of keys) and the seed
+  // that give each key its own slot. Linear probing handles the collisions
+  // when no such seed exists.
+  static void findPerfectHash(JsonObjectConst object, Node& node) {
+    size_t count = 0;
+    for (JsonPairConst member : object)
+      if (isTableMember(member))
+        count++;
+
+    size_t size = 1;
+    while (size < 2 * count)
+      size *= 2;
+    node.mask = uint16_t(size - 1);
+
+    const size_t maxSize = 1024;
+    for (; size <= maxSize; size *= 2) {
+      for (uint8_t seed = 0; seed < 32; seed++) {
+        if (isPerfectHash(object, seed, size - 1)) {
+          node.mask = uint16_t(size - 1);
+          node.seed = seed;
+          node.flags |= PerfectHash;
+          return;
+        }
+      }
+    }
+  }
+
+  static bool isPerfectHash(JsonObjectConst object, uint8_t seed,
+                            size_t mask) {
+    uint8_t used[1024 / 8] = {};
+    for (JsonPairConst member : object) {
+      if (!isTableMember(member))
+        continue;
+      JsonString key = member.key();
+      size_t i = hash(key.c_str(), key.size(), seed) & mask;
+      if (used[i / 8] & (1 << (i % 8)))
+        return false;
+      used[i / 8] = uint8_t(used[i / 8] | (1 << (i % 8)));
+    }
+    return true;
+  }
+
+  void insert(const Node& node, JsonString key, uint16_t child) {
+    Slot* slots = slots_ + node.table;
+    size_t i = hash(key.c_str(), key.size(), node.seed) & node.mask;
+    while (slots[i].key)
+      i = (i + 1) & node.mask;
+    slots[i].key = key.c_str();
+    slots[i].length = key.size();
+    slots[i].node = child;
+  }
+
+  uint16_t findMember(uint16_t index, const char* key, size_t length) const {
+    const Node& node = nodes_[index];
+    size_t i = hash(key, length, node.seed) & node.mask;
+    for (;;) {
+      const Slot& slot = slots_[node.table + i];
+      if (!slot.key)
+        return node.child;
+      if (slot.length == length && memcmp(slot.key, key, length) == 0)
+        return slot.node;
+      if (node.flags & PerfectHash)
+        return node.child;
+      i = (i + 1) & node.mask;
+    }
+  }
+
+  Allocator* allocator_;
+  void* block_;
+  Node* nodes_;  // null until compiled
+  Slot* slots_;
+  Filter::ElementPredicate keep_;
+  size_t root_;
+  size_t nodeCount_;
+  size_t slotCount_;
+};
+}  // namespace DeserializationOption
+
+ARDUINOJSON_END_PUBLIC_NAMESPACE
+
+ARDUINOJSON_BEGIN_PRIVATE_NAMESPACE
+
+// The filter that deserializeJson() passes down the tree: a position in a
+// CompiledFilter
+class CompiledFilterRef {
+  using CompiledFilter = DeserializationOption::CompiledFilter;
+
+ public:
+  CompiledFilterRef() : filter_(nullptr), node_(0), checkElements_(false) {}
+
+  explicit CompiledFilterRef(const CompiledFilter& filter)
+      : filter_(&filter), node_(uint16_t(filter.root_)), checkElements_(false) {}
+
+  bool allow() const {
+    return flags() & CompiledFilter::Allow;
+  }
+
+  bool allowArray() const {
+    return flags() & CompiledFilter::AllowArray;
+  }
+
+  bool allowObject() const {
+    return flags() & CompiledFilter::AllowObject;
+  }
+
+  bool allowValue() const {
+    return flags() & CompiledFilter::AllowValue;
+  }
+
+  // Filter of the elements of an array
+  template <typename TKey>
+  enable_if_t<is_integral<TKey>::value, CompiledFilterRef> operator[](
+      TKey) const {
+    if (!flags())
+      return *this;
+    return CompiledFilterRef(filter_, node().child,
+                             flags() & CompiledFilter::CheckElements);
+  }
+
+  // Filter of the member of an object
+  template <typename TKey>
+  enable_if_t<!is_integral<TKey>::value, CompiledFilterRef> operator[](
+      const TKey& key) const {
+    if (flags() & CompiledFilter::AllowValue)  // "true" allows recursively
+      return CompiledFilterRef(filter_, CompiledFilter::AllowAll, false);
+    if (!(flags() & CompiledFilter::AllowObject))
+      return CompiledFilterRef(filter_, CompiledFilter::Reject, false);
+    auto s = adaptString(key);
+    return CompiledFilterRef(filter_,
+                             filter_->findMember(node_, s.data(), s.size()),
+                             false);
+  }
+
+  bool keepElement(JsonVariantConst element, JsonString key) const {
+    return !checkElements_ || filter_->keep_(element, key);
+  }
+
+ private:
+  CompiledFilterRef(const CompiledFilter* filter, uint16_t node,
+                    bool checkElements)
+      : filter_(filter), node_(node), checkElements_(checkElements) {}
+
+  const CompiledFilter::Node& node() const {
+    return filter_->nodes_[node_];
+  }
+
+  // Zero if the filter is missing or couldn't be allocated
+  uint8_t flags() const {
+    return filter_ && filter_->nodes_ ? node().flags : 0;
+  }
+
+  const CompiledFilter* filter_;
+  uint16_t node_;
+  bool checkElements_;
+};
+
+ARDUINOJSON_END_PRIVATE_NAMESPACE
@@ -4,32 +4,145 @@
 
 #pragma once
 
+#include <ArduinoJson/Deserialization/CompiledFilter.hpp>
 #include <ArduinoJson/Deserialization/Filter.hpp>
+#include <ArduinoJson/Deserialization/InSitu.hpp>
 #include <ArduinoJson/Deserialization/NestingLimit.hpp>
+#include <ArduinoJson/Deserialization/ReadBuffer.hpp>
+#include <ArduinoJson/Polyfills/type_traits.hpp>
 
 ARDUINOJSON_BEGIN_PRIVATE_NAMESPACE
 
-template <typename TFilter>
+template <typename TFilter, typename TReadBuffer = NoReadBuffer,
+          typename TInSitu = NoInSitu>
 struct DeserializationOptions {
   TFilter filter;
   DeserializationOption::NestingLimit nestingLimit;
+  TReadBuffer readBuffer;  // NoReadBuffer or DeserializationOption::ReadBuffer*
+  TInSitu inSitu;          // NoInSitu or DeserializationOption::InSitu
 };
 
-template <typename TFilter>
-inline DeserializationOptions<TFilter> makeDeserializationOptions(
-    TFilter filter, DeserializationOption::NestingLimit nestingLimit = {}) {
-  return {filter, nestingLimit};
+// A meta-function that returns the filter type for a list of options
+template <typename...>
+struct filter_option {
+  using type = AllowAllFilter;
+};
+template <typename... TRest>
+struct filter_option<DeserializationOption::Filter, TRest...> {
+  using type = DeserializationOption::Filter;
+};
+template <typename... TRest>
+struct filter_option<DeserializationOption::CompiledFilter, TRest...> {
+  using type = CompiledFilterRef;
+};
+template <typename TFirst, typename... TRest>
+struct filter_option<TFirst, TRest...> : filter_option<TRest...> {};
+
+// A meta-function that returns the read buffer type for a list of options
+template <typename...>
+struct read_buffer_option {
+  using type = NoReadBuffer;
+};
+template <typename... TRest>
+struct read_buffer_option<DeserializationOption::ReadBuffer, TRest...> {
+  using type = DeserializationOption::ReadBuffer*;
+};
+template <typename TFirst, typename... TRest>
+struct read_buffer_option<TFirst, TRest...> : read_buffer_option<TRest...> {};
+
+// A meta-function that returns the in-situ flag type for a list of options
+template <typename...>
+struct in_situ_option {
+  using type = NoInSitu;
+};
+template <typename... TRest>
+struct in_situ_option<DeserializationOption::InSitu, TRest...> {
+  using type = DeserializationOption::InSitu;
+};
+template <typename TFirst, typename... TRest>
+struct in_situ_option<TFirst, TRest...> : in_situ_option<TRest...> {};
+
+template <typename T>
+using option_t = remove_cv_t<remove_reference_t<T>>;
+
+template <typename... TOptions>
+using deserialization_options_t = DeserializationOptions<
+    typename filter_option<option_t<TOptions>...>::type,
+    typename read_buffer_option<option_t<TOptions>...>::type,
+    typename in_situ_option<option_t<TOptions>...>::type>;
+
+template <typename TOptions>
+inline void setOptions(TOptions&) {}
+
+template <typename TOptions, typename... TRest>
+inline void setOptions(TOptions& options, DeserializationOption::Filter filter,
+                       TRest&... rest);
+
+template <typename TOptions, typename... TRest>
+inline void setOptions(TOptions& options,
+                       const DeserializationOption::CompiledFilter& filter,
+                       TRest&... rest);
+
+template <typename TOptions, typename... TRest>
+inline void setOptions(TOptions& options,
+                       DeserializationOption::NestingLimit nestingLimit,
+                       TRest&... rest);
+
+template <typename TOptions, typename... TRest>
+inline void setOptions(TOptions& options,
+                       DeserializationOption::ReadBuffer& readBuffer,
+                       TRest&... rest);
+
+template <typename TOptions, typename... TRest>
+inline void setOptions(TOptions& options, DeserializationOption::InSitu,
+                       TRest&... rest);
+
+template <typename TOptions, typename... TRest>
+inline void setOptions(TOptions& options, DeserializationOption::Filter filter,
+                       TRest&... rest) {
+  options.filter = filter;
+  setOptions(options, rest...);
+}
+
+template <typename TOptions, typename... TRest>
+inline void setOptions(TOptions& options,
+                       const DeserializationOption::CompiledFilter& filter,
+                       TRest&... rest) {
+  options.filter = CompiledFilterRef(filter);
+  setOptions(options, rest...);
+}
+
+template <typename TOptions, typename... TRest>
+inline void setOptions(TOptions& options,
+                       DeserializationOption::NestingLimit nestingLimit,
+                       TRest&... rest) {
+  options.nestingLimit = nestingLimit;
+  setOptions(options, rest...);
+}
+
+template <typename TOptions, typename... TRest>
+inline void setOptions(TOptions& options,
+                       DeserializationOption::ReadBuffer& readBuffer,
+                       TRest&... rest) {
+  options.readBuffer = &readBuffer;
+  setOptions(options, rest...);
 }
 
-template <typename TFilter>
-inline DeserializationOptions<TFilter> makeDeserializationOptions(
-    DeserializationOption::NestingLimit nestingLimit, TFilter filter) {
-  return {filter, nestingLimit};
+template <typename TOptions, typename... TRest>
+inline void setOptions(TOptions& options, DeserializationOption::InSitu,
+                       TRest&... rest) {
+  // already selected by in_situ_option
+  setOptions(options, rest...);
 }
 
-inline DeserializationOptions<AllowAllFilter> makeDeserializationOptions(
-    DeserializationOption::NestingLimit nestingLimit = {}) {
-  return {{}, nestingLimit};
+// Combines the options passed to deserializeJson() and deserializeMsgPack(),
+// in any order
+template <typename... TOptions>
+inline deserialization_options_t<TOptions...> makeDeserializationOptions(
+    TOptions&&... args) {
+  deserialization_options_t<TOptions...> options{};
+  setOptions(options, args...);
+  return options;
 }
 
 ARDUINOJSON_END_PRIVATE_NAMESPACE
@@ -12,13 +12,35 @@ ARDUINOJSON_BEGIN_PUBLIC_NAMESPACE
 namespace DeserializationOption {
 class Filter {
  public:
+  // Decides whether an array element stays in the document.
+  // It is called after each member of the element is stored, with the key of
+  // that member, and once more with a null key when the element is complete
+  // (scalar elements only get this last call). Returning false stops the
+  // parsing of the element and releases everything it allocated.
+  using ElementPredicate = bool (*)(JsonVariantConst element, JsonString key);
+
+  // Creates a filter that rejects everything
+  Filter() : keep_(nullptr), checkElements_(false) {}
+
 #if ARDUINOJSON_AUTO_SHRINK
-  explicit Filter(JsonDocument& doc) : variant_(doc) {
+  explicit Filter(JsonDocument& doc)
+      : variant_(doc), keep_(nullptr), checkElements_(false) {
     doc.shrinkToFit();
   }
 #endif
 
-  explicit Filter(JsonVariantConst variant) : variant_(variant) {}
+  explicit Filter(JsonVariantConst variant)
+      : variant_(variant), keep_(nullptr), checkElements_(false) {}
+
+  // Creates a filter that also drops the elements of `array`, a node of
+  // `variant`, for which `keep` returns false.
+  // For example: Filter(filter, filter["aircraft"], isInBox)
+  Filter(JsonVariantConst variant, JsonVariantConst array,
+         ElementPredicate keep)
+      : variant_(variant),
+        array_(array),
+        keep_(keep),
+        checkElements_(false) {}
 
   bool allow() const {
     return variant_;
@@ -38,14 +60,31 @@ class Filter {
 
   template <typename TKey>
   Filter operator[](const TKey& key) const {
-    if (variant_ == true)  // "true" means "allow recursively"
-      return *this;
-    JsonVariantConst member = variant_[key];
-    return Filter(member.isNull() ? variant_["*"] : member);
+    Filter child(*this);
+    // "true" means "allow recursively"
+    if (variant_ != true) {
+      JsonVariantConst member = variant_[key];
+      child.variant_ = member.isNull() ? variant_["*"] : member;
+    }
+    // integer keys come from arrays, string keys from objects
+    child.checkElements_ = detail::is_integral<TKey>::value && keep_ &&
+                           detail::VariantAttorney::getData(variant_) ==
+                               detail::VariantAttorney::getData(array_);
+    return child;
+  }
+
+  // Returns false if the element this filter applies to must be dropped.
+  // `key` is the member that was just stored, or null when the element is
+  // complete.
+  bool keepElement(JsonVariantConst element, JsonString key) const {
+    return !checkElements_ || keep_(element, key);
   }
 
  private:
   JsonVariantConst variant_;
+  JsonVariantConst array_;
+  ElementPredicate keep_;
+  bool checkElements_;
 };
 }  // namespace DeserializationOption
 
@@ -71,6 +110,10 @@ struct AllowAllFilter {
   AllowAllFilter operator[](const TKey&) const {
     return AllowAllFilter();
   }
+
+  bool keepElement(JsonVariantConst, JsonString) const {
+    return true;
+  }
 };
 }  // namespace detail
 
@@ -0,0 +1,58 @@
+// ArduinoJson - https://arduinojson.org
+// Copyright © 2014-2025, Benoit BLANCHON
+// MIT License
+
+#pragma once
+
+#include <ArduinoJson/Deserialization/Reader.hpp>
+
+ARDUINOJSON_BEGIN_PUBLIC_NAMESPACE
+
+namespace DeserializationOption {
+// Tells deserializeJson() to unescape strings in the input buffer and to
+// store pointers to them instead of copying them to the JsonDocument.
+// Only valid with a mutable input of known size:
+//   deserializeJson(doc, buffer, length, DeserializationOption::InSitu());
+// The buffer is modified and must outlive the JsonDocument.
+struct InSitu {};
+}  // namespace DeserializationOption
+
+ARDUINOJSON_END_PUBLIC_NAMESPACE
+
+ARDUINOJSON_BEGIN_PRIVATE_NAMESPACE
+
+// Used in place of InSitu when it wasn't given
+struct NoInSitu {};
+
+// Reads a mutable buffer that InSituStringBuilder writes strings to
+class InSituReader : public IteratorReader<const char*> {
+ public:
+  InSituReader(char* begin, size_t size)
+      : IteratorReader<const char*>(begin, begin + size),
+        begin_(begin),
+        end_(begin + size) {}
+
+  char* begin() const {
+    return begin_;
+  }
+
+  char* end() const {
+    return end_;
+  }
+
+ private:
+  char* begin_;
+  char* end_;
+};
+
+template <typename TChar>
+BoundedReader<TChar*> makeReader(TChar* input, size_t inputSize, NoInSitu) {
+  return makeReader(input, inputSize);
+}
+
+inline InSituReader makeReader(char* input, size_t inputSize,
+                               DeserializationOption::InSitu) {
+  return InSituReader(input, inputSize);
+}
+
+ARDUINOJSON_END_PRIVATE_NAMESPACE
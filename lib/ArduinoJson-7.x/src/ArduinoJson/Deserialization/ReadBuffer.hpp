@@ -0,0 +1,134 @@
+// ArduinoJson - https://arduinojson.org
+// Copyright © 2014-2025, Benoit BLANCHON
+// MIT License
+
+#pragma once
+
+#include <ArduinoJson/Namespace.hpp>
+#include <ArduinoJson/Polyfills/assert.hpp>
+
+#include <stddef.h>  // size_t
+#include <string.h>  // memcpy
+
+ARDUINOJSON_BEGIN_PRIVATE_NAMESPACE
+template <typename TReader>
+class BufferedReader;
+ARDUINOJSON_END_PRIVATE_NAMESPACE
+
+ARDUINOJSON_BEGIN_PUBLIC_NAMESPACE
+
+namespace DeserializationOption {
+// A caller-owned window that lets the deserializer read the input by blocks
+// instead of one byte at a time.
+// The parser stops right after the root value, but the window may already
+// contain the bytes that follow; they remain in the ReadBuffer and are
+// consumed first by the next call that uses the same ReadBuffer, or can be
+// retrieved with readBytes(). The window must outlive the parser.
+class ReadBuffer {
+ public:
+  ReadBuffer(char* data, size_t capacity)
+      : data_(data), capacity_(capacity), begin_(0), end_(0) {
+    ARDUINOJSON_ASSERT(capacity > 0);
+  }
+
+  template <size_t N>
+  explicit ReadBuffer(char (&data)[N]) : ReadBuffer(data, N) {}
+
+  ReadBuffer(const ReadBuffer&) = delete;
+  ReadBuffer& operator=(const ReadBuffer&) = delete;
+
+  // Returns the number of bytes read from the input but not consumed
+  size_t available() const {
+    return end_ - begin_;
+  }
+
+  // Moves up to length unconsumed bytes to buffer
+  size_t readBytes(char* buffer, size_t length) {
+    if (length > available())
+      length = available();
+    memcpy(buffer, data_ + begin_, length);
+    begin_ += length;
+    return length;
+  }
+
+  // Drops the unconsumed bytes
+  void clear() {
+    begin_ = end_ = 0;
+  }
+
+ private:
+  template <typename>
+  friend class detail::BufferedReader;
+
+  char* data_;
+  size_t capacity_;
+  size_t begin_;
+  size_t end_;
+};
+}  // namespace DeserializationOption
+
+ARDUINOJSON_END_PUBLIC_NAMESPACE
+
+ARDUINOJSON_BEGIN_PRIVATE_NAMESPACE
+
+// Used in place of a ReadBuffer when none was given
+struct NoReadBuffer {};
+
+// Serves read() from a ReadBuffer, refilling it by blocks from the reader
+template <typename TReader>
+class BufferedReader {
+ public:
+  BufferedReader(TReader reader, DeserializationOption::ReadBuffer* buffer)
+      : reader_(reader), buffer_(buffer) {}
+
+  int read() {
+    if (buffer_->begin_ == buffer_->end_ && !refill())
+      return -1;
+    return static_cast<unsigned char>(buffer_->data_[buffer_->begin_++]);
+  }
+
+  size_t readBytes(char* buffer, size_t length) {
+    size_t n = buffer_->readBytes(buffer, length);
+    if (n < length)
+      n += reader_.readBytes(buffer + n, length - n);
+    return n;
+  }
+
+ private:
+  bool refill() {
+    size_t n = readAvailable(reader_, buffer_->data_, buffer_->capacity_, 0);
+    buffer_->begin_ = 0;
+    buffer_->end_ = n;
+    return n > 0;
+  }
+
+  // Streams that can tell how many bytes are ready implement readAvailable()
+  // so a refill never waits for more than what is already there.
+  template <typename TSource>
+  static auto readAvailable(TSource& source, char* buffer, size_t length, int)
+      -> decltype(source.readAvailable(buffer, length)) {
+    return source.readAvailable(buffer, length);
+  }
+
+  template <typename TSource>
+  static size_t readAvailable(TSource& source, char* buffer, size_t length,
+                              long) {
+    return source.readBytes(buffer, length);
+  }
+
+  TReader reader_;
+  DeserializationOption::ReadBuffer* buffer_;
+};
+
+template <typename TReader>
+TReader makeBufferedReader(TReader reader, NoReadBuffer) {
+  return reader;
+}
+
+template <typename TReader>
+BufferedReader<TReader> makeBufferedReader(
+    TReader reader, DeserializationOption::ReadBuffer* buffer) {
+  return BufferedReader<TReader>(reader, buffer);
+}
+
+ARDUINOJSON_END_PRIVATE_NAMESPACE
@@ -23,6 +23,15 @@ struct Reader<TSource, enable_if_t<is_base_of<Stream, TSource>::value>> {
     return stream_->readBytes(buffer, length);
   }
 
+  // Reads what the stream already holds, or waits for at least one byte
+  size_t readAvailable(char* buffer, size_t length) {
+    size_t n = 1;
+    int available = stream_->available();
+    if (available > 1)
+      n = static_cast<size_t>(available);
+    return stream_->readBytes(buffer, n < length ? n : length);
+  }
+
  private:
   Stream* stream_;
 };
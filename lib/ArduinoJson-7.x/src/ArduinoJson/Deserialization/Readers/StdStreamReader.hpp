@@ -22,6 +22,15 @@ struct Reader<TSource, enable_if_t<is_base_of<std::istream, TSource>::value>> {
     return static_cast<size_t>(stream_->gcount());
   }
 
+  // Reads what the stream already holds, or waits for at least one byte
+  size_t readAvailable(char* buffer, size_t length) {
+    std::streamsize n =
+        stream_->readsome(buffer, static_cast<std::streamsize>(length));
+    if (n > 0)
+      return static_cast<size_t>(n);
+    return readBytes(buffer, 1);
+  }
+
  private:
   std::istream* stream_;
 };
@@ -47,9 +47,16 @@ DeserializationError doDeserialize(TDestination&& dst, TReader reader,
   auto data = VariantAttorney::getOrCreateData(dst);
   if (!data)
     return DeserializationError::NoMemory;
+  static_assert(is_same<decltype(options.inSitu), NoInSitu>::value ||
+                    is_same<TReader, InSituReader>::value,
+                "InSitu requires a mutable char* and a size");
+  static_assert(is_same<decltype(options.inSitu), NoInSitu>::value ||
+                    is_same<decltype(options.readBuffer), NoReadBuffer>::value,
+                "InSitu can't be combined with ReadBuffer");
   auto resources = VariantAttorney::getResourceManager(dst);
   dst.clear();
-  auto err = TDeserializer<TReader>(resources, reader)
+  auto bufferedReader = makeBufferedReader(reader, options.readBuffer);
+  auto err = TDeserializer<decltype(bufferedReader)>(resources, bufferedReader)
                  .parse(data, options.filter, options.nestingLimit);
   shrinkJsonDocument(dst);
   return err;
@@ -59,9 +66,11 @@ template <
     template <typename> class TDeserializer, typename TDestination,
     typename TStream, typename... Args,
     enable_if_t<  // issue #1897
-        !is_integral<typename first_or_void<Args...>::type>::value, int> = 0>
+        !is_integral<remove_reference_t<
+            typename first_or_void<Args...>::type>>::value,
+        int> = 0>
 DeserializationError deserialize(TDestination&& dst, TStream&& input,
-                                 Args... args) {
+                                 Args&&... args) {
   return doDeserialize<TDeserializer>(
       dst, makeReader(detail::forward<TStream>(input)),
       makeDeserializationOptions(args...));
@@ -71,9 +80,10 @@ template <template <typename> class TDeserializer, typename TDestination,
           typename TChar, typename Size, typename... Args,
           enable_if_t<is_integral<Size>::value, int> = 0>
 DeserializationError deserialize(TDestination&& dst, TChar* input,
-                                 Size inputSize, Args... args) {
-  return doDeserialize<TDeserializer>(dst, makeReader(input, size_t(inputSize)),
-                                      makeDeserializationOptions(args...));
+                                 Size inputSize, Args&&... args) {
+  auto options = makeDeserializationOptions(args...);
+  return doDeserialize<TDeserializer>(
+      dst, makeReader(input, size_t(inputSize), options.inSitu), options);
 }
 
 ARDUINOJSON_END_PRIVATE_NAMESPACE
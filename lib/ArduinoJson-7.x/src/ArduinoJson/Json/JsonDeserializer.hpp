@@ -9,6 +9,7 @@
 #include <ArduinoJson/Json/Latch.hpp>
 #include <ArduinoJson/Json/Utf16.hpp>
 #include <ArduinoJson/Json/Utf8.hpp>
+#include <ArduinoJson/Memory/InSituStringBuilder.hpp>
 #include <ArduinoJson/Memory/ResourceManager.hpp>
 #include <ArduinoJson/Numbers/parseNumber.hpp>
 #include <ArduinoJson/Polyfills/assert.hpp>
@@ -22,8 +23,9 @@ template <typename TReader>
 class JsonDeserializer {
  public:
   JsonDeserializer(ResourceManager* resources, TReader reader)
-      : stringBuilder_(resources),
+      : stringBuilder_(resources, reader),
         foundSomething_(false),
+        elementDropped_(false),
         latch_(reader),
         resources_(resources) {}
 
@@ -173,6 +175,8 @@ class JsonDeserializer {
     // Read each value
     for (;;) {
       if (elementFilter.allow()) {
+        SlotId previous = VariantImpl::lastElement(array);
+
         // Allocate slot in array
         VariantData* value = VariantImpl::addNewElement(array, resources_);
         if (!value)
@@ -182,6 +186,13 @@ class JsonDeserializer {
         err = parseVariant(value, elementFilter, nestingLimit.decrement());
         if (err)
           return err;
+
+        bool keep = !elementDropped_ &&
+                    elementFilter.keepElement(
+                        JsonVariantConst(value, resources_), JsonString());
+        elementDropped_ = false;
+        if (!keep)
+          VariantImpl::removeLastElement(previous, array, resources_);
       } else {
         err = skipVariant(nestingLimit.decrement());
         if (err)
@@ -279,8 +290,9 @@ class JsonDeserializer {
       if (memberFilter.allow()) {
         auto member =
             VariantImpl::getMember(adaptString(key), object, resources_);
+        VariantData* keyVariant = nullptr;
         if (!member) {
-          auto keyVariant = VariantImpl::addPair(&member, object, resources_);
+          keyVariant = VariantImpl::addPair(&member, object, resources_);
           if (!keyVariant)
             return DeserializationError::NoMemory;
 
@@ -293,6 +305,15 @@ class JsonDeserializer {
         err = parseVariant(member, memberFilter, nestingLimit.decrement());
         if (err)
           return err;
+
+        // Give the element predicate a chance to reject the object early.
+        // Duplicate keys are only seen by the final call, in parseArray().
+        if (keyVariant &&
+            !filter.keepElement(JsonVariantConst(object, resources_),
+                                keyVariant->asString())) {
+          elementDropped_ = true;
+          return skipRemainingMembers(nestingLimit);
+        }
       } else {
         err = skipVariant(nestingLimit.decrement());
         if (err)
@@ -337,27 +358,19 @@ class JsonDeserializer {
     if (eat('}'))
       return DeserializationError::Ok;
 
-    // Read each key value pair
-    for (;;) {
-      // Skip key
-      err = skipKey();
-      if (err)
-        return err;
-
-      // Skip spaces
-      err = skipSpacesAndComments();
-      if (err)
-        return err;
+    err = skipMember(nestingLimit);
+    if (err)
+      return err;
 
-      // Colon
-      if (!eat(':'))
-        return DeserializationError::InvalidInput;
+    return skipRemainingMembers(nestingLimit);
+  }
 
-      // Skip value
-      err = skipVariant(nestingLimit.decrement());
-      if (err)
-        return err;
+  // Skips the rest of an object, starting right after a member's value
+  DeserializationError::Code skipRemainingMembers(
+      DeserializationOption::NestingLimit nestingLimit) {
+    DeserializationError::Code err;
 
+    for (;;) {
       // Skip spaces
       err = skipSpacesAndComments();
       if (err)
@@ -372,9 +385,35 @@ class JsonDeserializer {
       err = skipSpacesAndComments();
       if (err)
         return err;
+
+      err = skipMember(nestingLimit);
+      if (err)
+        return err;
     }
   }
 
+  DeserializationError::Code skipMember(
+      DeserializationOption::NestingLimit nestingLimit) {
+    DeserializationError::Code err;
+
+    // Skip key
+    err = skipKey();
+    if (err)
+      return err;
+
+    // Skip spaces
+    err = skipSpacesAndComments();
+    if (err)
+      return err;
+
+    // Colon
+    if (!eat(':'))
+      return DeserializationError::InvalidInput;
+
+    // Skip value
+    return skipVariant(nestingLimit.decrement());
+  }
+
   DeserializationError::Code parseKey() {
     stringBuilder_.startString();
     if (isQuote(current())) {
@@ -687,8 +726,9 @@ class JsonDeserializer {
     return DeserializationError::Ok;
   }
 
-  StringBuilder stringBuilder_;
+  string_builder_t<TReader> stringBuilder_;
   bool foundSomething_;
+  bool elementDropped_;  // an element predicate rejected the current object
   Latch<TReader> latch_;
   ResourceManager* resources_;
   char buffer_[64];  // using a member instead of a local variable because it
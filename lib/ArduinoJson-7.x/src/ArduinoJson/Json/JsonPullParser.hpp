@@ -0,0 +1,815 @@
+// ArduinoJson - https://arduinojson.org
+// Copyright © 2014-2025, Benoit BLANCHON
+// MIT License
+
+#pragma once
+
+#include <ArduinoJson/Deserialization/DeserializationError.hpp>
+#include <ArduinoJson/Deserialization/deserialize.hpp>
+#include <ArduinoJson/Json/EscapeSequence.hpp>
+#include <ArduinoJson/Json/Latch.hpp>
+#include <ArduinoJson/Json/Utf16.hpp>
+#include <ArduinoJson/Json/Utf8.hpp>
+#include <ArduinoJson/Numbers/parseNumber.hpp>
+#include <ArduinoJson/Polyfills/assert.hpp>
+#include <ArduinoJson/Polyfills/utility.hpp>
+#include <ArduinoJson/Strings/JsonString.hpp>
+
+ARDUINOJSON_BEGIN_PUBLIC_NAMESPACE
+
+// An event returned by the pull parser.
+enum class JsonEvent : uint8_t {
+  End,    // the root value is complete
+  Error,  // see error()
+  BeginObject,
+  EndObject,
+  BeginArray,
+  EndArray,
+  Key,  // see key()
+  String,  // see string()
+  Number,  // see number<T>()
+  Boolean,  // see boolean()
+  Null,
+};
+
+ARDUINOJSON_END_PUBLIC_NAMESPACE
+
+ARDUINOJSON_BEGIN_PRIVATE_NAMESPACE
+
+// A fixed-size buffer used for keys, strings, and numbers.
+// It never allocates: strings that don't fit are reported as NoMemory, and
+// keys that don't fit are treated as matching no member of the filter.
+class PullParserBuffer {
+ public:
+  PullParserBuffer() : size_(0), overflowed_(false) {}
+
+  void reset() {
+    size_ = 0;
+    overflowed_ = false;
+  }
+
+  void append(char c) {
+    if (size_ < capacity) {
+      data_[size_++] = c;
+    } else {
+      overflowed_ = true;
+    }
+  }
+
+  bool isValid() const {
+    return !overflowed_;
+  }
+
+  const char* c_str() {
+    data_[size_] = 0;
+    return data_;
+  }
+
+  size_t size() const {
+    return size_;
+  }
+
+ private:
+  static const size_t capacity = ARDUINOJSON_PULL_PARSER_BUFFER_SIZE - 1;
+  char data_[ARDUINOJSON_PULL_PARSER_BUFFER_SIZE];
+  size_t size_;
+  bool overflowed_;
+};
+
+// An allocation-free, event-based JSON parser.
+// Events are produced one at a time by next(); values excluded by the filter
+// are skipped without producing events.
+template <typename TReader, typename TFilter>
+class JsonPullParser {
+ public:
+  JsonPullParser(TReader reader, TFilter filter,
+                 DeserializationOption::NestingLimit nestingLimit)
+      : latch_(reader),
+        valueFilter_(filter),
+        valueNesting_(nestingLimit),
+        depth_(0),
+        expectValue_(true),
+        done_(false),
+        foundSomething_(false),
+        boolean_(false),
+        last_(JsonEvent::End),
+        error_(DeserializationError::Ok) {}
+
+  // Reads the input until the next event
+  JsonEvent next() {
+    last_ = advance();
+    return last_;
+  }
+
+  // Skips the value that follows the last Key event, or the remainder of the
+  // container opened by the last BeginObject/BeginArray event.
+  void skip() {
+    DeserializationError::Code err = DeserializationError::Ok;
+
+    switch (last_) {
+      case JsonEvent::Key:
+        ARDUINOJSON_ASSERT(expectValue_);
+        expectValue_ = false;
+        err = skipVariant(valueNesting_);
+        break;
+
+      case JsonEvent::BeginObject:
+      case JsonEvent::BeginArray:
+        ARDUINOJSON_ASSERT(depth_ > 0);
+        depth_--;
+        err = skipContainerBody(stack_[depth_].isObject, stack_[depth_].nesting,
+                                stack_[depth_].hasElements);
+        break;
+
+      default:
+        return;
+    }
+
+    last_ = JsonEvent::Null;
+    if (err)
+      fail(err);
+  }
+
+  // Returns the key of the last Key event
+  JsonString key() {
+    ARDUINOJSON_ASSERT(last_ == JsonEvent::Key);
+    return JsonString(buffer_.c_str(), buffer_.size());
+  }
+
+  // Returns the value of the last String event
+  JsonString string() {
+    ARDUINOJSON_ASSERT(last_ == JsonEvent::String);
+    return JsonString(buffer_.c_str(), buffer_.size());
+  }
+
+  // Returns the value of the last Number event, converted like
+  // JsonVariant::as<T>() would
+  template <typename T>
+  T number() const {
+    ARDUINOJSON_ASSERT(last_ == JsonEvent::Number);
+    return number_.toNumber().template convertTo<T>();
+  }
+
+  // Stores the value of the last Number event multiplied by 10^decimals,
+  // rounded to the nearest integer, without any floating-point math.
+  // For example, fixedPoint(x, 6) stores 46.123456789 as 46123457.
+  // Returns false, leaving result untouched, if the value doesn't fit in T.
+  template <typename T>
+  bool fixedPoint(T& result, uint8_t decimals) const {
+    ARDUINOJSON_ASSERT(last_ == JsonEvent::Number);
+    return number_.toFixedPoint(result, decimals);
+  }
+
+  // Returns true if the last Number event was an integer
+  bool isInteger() const {
+    return number_.kind == DecimalNumber::Kind::Integer;
+  }
+
+  // Returns the value of the last Boolean event
+  bool boolean() const {
+    ARDUINOJSON_ASSERT(last_ == JsonEvent::Boolean);
+    return boolean_;
+  }
+
+  // Returns the number of open objects and arrays
+  uint8_t depth() const {
+    return depth_;
+  }
+
+  DeserializationError error() const {
+    return error_;
+  }
+
+ private:
+  struct Frame {
+    TFilter filter;
+    DeserializationOption::NestingLimit nesting;  // for the children
+    bool isObject;
+    bool hasElements;
+  };
+
+  JsonEvent advance() {
+    if (error_)
+      return JsonEvent::Error;
+    if (done_)
+      return JsonEvent::End;
+
+    DeserializationError::Code err;
+
+    for (;;) {
+      if (expectValue_) {
+        expectValue_ = false;
+        return parseValue();
+      }
+
+      if (depth_ == 0) {
+        done_ = true;
+        return JsonEvent::End;
+      }
+
+      Frame& frame = stack_[depth_ - 1];
+
+      err = skipSpacesAndComments();
+      if (err)
+        return fail(err);
+
+      if (eat(frame.isObject ? '}' : ']')) {
+        depth_--;
+        return frame.isObject ? JsonEvent::EndObject : JsonEvent::EndArray;
+      }
+
+      if (frame.hasElements) {
+        if (!eat(','))
+          return fail(DeserializationError::InvalidInput);
+
+        err = skipSpacesAndComments();
+        if (err)
+          return fail(err);
+      }
+      frame.hasElements = true;
+
+      if (frame.isObject) {
+        // A key longer than the buffer can't be any of the filter's keys:
+        // only a wildcard may still want its value
+        err = parseKey();
+        bool keyTooLong = err == DeserializationError::NoMemory;
+        if (err && !keyTooLong)
+          return fail(err);
+
+        err = skipSpacesAndComments();
+        if (err)
+          return fail(err);
+
+        if (!eat(':'))
+          return fail(DeserializationError::InvalidInput);
+
+        TFilter memberFilter =
+            keyTooLong
+                ? frame.filter["*"]
+                : frame.filter[JsonString(buffer_.c_str(), buffer_.size())];
+
+        if (memberFilter.allow()) {
+          if (keyTooLong)
+            return fail(DeserializationError::NoMemory);
+          valueFilter_ = memberFilter;
+          valueNesting_ = frame.nesting;
+          expectValue_ = true;
+          return JsonEvent::Key;
+        }
+      } else {
+        TFilter elementFilter = frame.filter[0UL];
+
+        if (elementFilter.allow()) {
+          valueFilter_ = elementFilter;
+          valueNesting_ = frame.nesting;
+          expectValue_ = true;
+          continue;
+        }
+      }
+
+      err = skipVariant(frame.nesting);
+      if (err)
+        return fail(err);
+    }
+  }
+
+  // Parses the value following a key, an array separator, or the root value.
+  // Values rejected by the filter are skipped and reported as Null, like
+  // deserializeJson() would leave them null.
+  JsonEvent parseValue() {
+    DeserializationError::Code err;
+
+    err = skipSpacesAndComments();
+    if (err)
+      return fail(err);
+
+    switch (current()) {
+      case '[':
+        if (valueFilter_.allowArray())
+          return beginContainer(false);
+        err = skipVariant(valueNesting_);
+        break;
+
+      case '{':
+        if (valueFilter_.allowObject())
+          return beginContainer(true);
+        err = skipVariant(valueNesting_);
+        break;
+
+      case '\"':
+      case '\'':
+        if (valueFilter_.allowValue()) {
+          buffer_.reset();
+          err = parseQuotedString();
+          if (err)
+            return fail(err);
+          return JsonEvent::String;
+        }
+        err = skipQuotedString();
+        break;
+
+      case 't':
+        err = skipKeyword("true");
+        if (!err && valueFilter_.allowValue()) {
+          boolean_ = true;
+          return JsonEvent::Boolean;
+        }
+        break;
+
+      case 'f':
+        err = skipKeyword("false");
+        if (!err && valueFilter_.allowValue()) {
+          boolean_ = false;
+          return JsonEvent::Boolean;
+        }
+        break;
+
+      case 'n':
+        err = skipKeyword("null");
+        break;
+
+      default:
+        if (valueFilter_.allowValue()) {
+          err = parseNumericValue();
+          if (err)
+            return fail(err);
+          return JsonEvent::Number;
+        }
+        err = skipNumericValue();
+        break;
+    }
+
+    if (err)
+      return fail(err);
+    return JsonEvent::Null;
+  }
+
+  JsonEvent beginContainer(bool isObject) {
+    if (valueNesting_.reached() || depth_ >= maxDepth)
+      return fail(DeserializationError::TooDeep);
+
+    move();  // skip '[' or '{'
+
+    Frame& frame = stack_[depth_++];
+    frame.filter = valueFilter_;
+    frame.nesting = valueNesting_.decrement();
+    frame.isObject = isObject;
+    frame.hasElements = false;
+
+    return isObject ? JsonEvent::BeginObject : JsonEvent::BeginArray;
+  }
+
+  JsonEvent fail(DeserializationError::Code err) {
+    error_ = err;
+    return JsonEvent::Error;
+  }
+
+  char current() {
+    return latch_.current();
+  }
+
+  void move() {
+    latch_.clear();
+  }
+
+  bool eat(char charToSkip) {
+    if (current() != charToSkip)
+      return false;
+    move();
+    return true;
+  }
+
+  DeserializationError::Code skipVariant(
+      DeserializationOption::NestingLimit nestingLimit) {
+    DeserializationError::Code err;
+
+    err = skipSpacesAndComments();
+    if (err)
+      return err;
+
+    switch (current()) {
+      case '[':
+      case '{':
+        if (nestingLimit.reached())
+          return DeserializationError::TooDeep;
+        {
+          bool isObject = current() == '{';
+          move();
+          return skipContainerBody(isObject, nestingLimit.decrement(), false);
+        }
+
+      case '\"':
+      case '\'':
+        return skipQuotedString();
+
+      case 't':
+        return skipKeyword("true");
+
+      case 'f':
+        return skipKeyword("false");
+
+      case 'n':
+        return skipKeyword("null");
+
+      default:
+        return skipNumericValue();
+    }
+  }
+
+  // Skips the members or elements of a container whose opening brace was
+  // already consumed, up to and including the closing brace.
+  DeserializationError::Code skipContainerBody(
+      bool isObject, DeserializationOption::NestingLimit nestingLimit,
+      bool hasElements) {
+    DeserializationError::Code err;
+    const char closingChar = isObject ? '}' : ']';
+
+    for (;;) {
+      err = skipSpacesAndComments();
+      if (err)
+        return err;
+
+      if (eat(closingChar))
+        return DeserializationError::Ok;
+
+      if (hasElements) {
+        if (!eat(','))
+          return DeserializationError::InvalidInput;
+        err = skipSpacesAndComments();
+        if (err)
+          return err;
+      }
+      hasElements = true;
+
+      if (isObject) {
+        err = skipKey();
+        if (err)
+          return err;
+
+        err = skipSpacesAndComments();
+        if (err)
+          return err;
+
+        if (!eat(':'))
+          return DeserializationError::InvalidInput;
+      }
+
+      err = skipVariant(nestingLimit);
+      if (err)
+        return err;
+    }
+  }
+
+  DeserializationError::Code parseKey() {
+    buffer_.reset();
+    if (isQuote(current())) {
+      return parseQuotedString();
+    } else {
+      return parseNonQuotedString();
+    }
+  }
+
+  DeserializationError::Code parseQuotedString() {
+#if ARDUINOJSON_DECODE_UNICODE
+    Utf16::Codepoint codepoint;
+    DeserializationError::Code err;
+#endif
+    const char stopChar = current();
+
+    move();
+    for (;;) {
+      char c = current();
+      move();
+      if (c == stopChar)
+        break;
+
+      if (c == '\0')
+        return DeserializationError::IncompleteInput;
+
+      if (c == '\\') {
+        c = current();
+
+        if (c == '\0')
+          return DeserializationError::IncompleteInput;
+
+        if (c == 'u') {
+#if ARDUINOJSON_DECODE_UNICODE
+          move();
+          uint16_t codeunit;
+          err = parseHex4(codeunit);
+          if (err)
+            return err;
+          if (codepoint.append(codeunit))
+            Utf8::encodeCodepoint(codepoint.value(), buffer_);
+#else
+          buffer_.append('\\');
+#endif
+          continue;
+        }
+
+        // replace char
+        c = EscapeSequence::unescapeChar(c);
+        if (c == '\0')
+          return DeserializationError::InvalidInput;
+        move();
+      }
+
+      buffer_.append(c);
+    }
+
+    if (!buffer_.isValid())
+      return DeserializationError::NoMemory;
+
+    return DeserializationError::Ok;
+  }
+
+  DeserializationError::Code parseNonQuotedString() {
+    char c = current();
+    ARDUINOJSON_ASSERT(c);
+
+    if (canBeInNonQuotedString(c)) {  // no quotes
+      do {
+        move();
+        buffer_.append(c);
+        c = current();
+      } while (canBeInNonQuotedString(c));
+    } else {
+      return DeserializationError::InvalidInput;
+    }
+
+    if (!buffer_.isValid())
+      return DeserializationError::NoMemory;
+
+    return DeserializationError::Ok;
+  }
+
+  DeserializationError::Code skipKey() {
+    if (isQuote(current())) {
+      return skipQuotedString();
+    } else {
+      return skipNonQuotedString();
+    }
+  }
+
+  DeserializationError::Code skipQuotedString() {
+    const char stopChar = current();
+
+    move();
+    for (;;) {
+      char c = current();
+      move();
+      if (c == stopChar)
+        break;
+      if (c == '\0')
+        return DeserializationError::IncompleteInput;
+      if (c == '\\') {
+        if (current() != '\0')
+          move();
+      }
+    }
+
+    return DeserializationError::Ok;
+  }
+
+  DeserializationError::Code skipNonQuotedString() {
+    char c = current();
+    while (canBeInNonQuotedString(c)) {
+      move();
+      c = current();
+    }
+    return DeserializationError::Ok;
+  }
+
+  DeserializationError::Code parseNumericValue() {
+    buffer_.reset();
+
+    char c = current();
+    while (canBeInNumber(c)) {
+      move();
+      buffer_.append(c);
+      c = current();
+    }
+
+    if (!buffer_.isValid())
+      return DeserializationError::InvalidInput;
+
+    number_ = parseDecimal(buffer_.c_str());
+    if (number_.kind == DecimalNumber::Kind::Invalid)
+      return DeserializationError::InvalidInput;
+
+    return DeserializationError::Ok;
+  }
+
+  DeserializationError::Code skipNumericValue() {
+    char c = current();
+    while (canBeInNumber(c)) {
+      move();
+      c = current();
+    }
+    return DeserializationError::Ok;
+  }
+
+  DeserializationError::Code parseHex4(uint16_t& result) {
+    result = 0;
+    for (uint8_t i = 0; i < 4; ++i) {
+      char digit = current();
+      if (!digit)
+        return DeserializationError::IncompleteInput;
+      uint8_t value = decodeHex(digit);
+      if (value > 0x0F)
+        return DeserializationError::InvalidInput;
+      result = uint16_t((result << 4) | value);
+      move();
+    }
+    return DeserializationError::Ok;
+  }
+
+  static inline bool isBetween(char c, char min, char max) {
+    return min <= c && c <= max;
+  }
+
+  static inline bool canBeInNumber(char c) {
+    return isBetween(c, '0', '9') || c == '+' || c == '-' || c == '.' ||
+#if ARDUINOJSON_ENABLE_NAN || ARDUINOJSON_ENABLE_INFINITY
+           isBetween(c, 'A', 'Z') || isBetween(c, 'a', 'z');
+#else
+           c == 'e' || c == 'E';
+#endif
+  }
+
+  static inline bool canBeInNonQuotedString(char c) {
+    return isBetween(c, '0', '9') || isBetween(c, '_', 'z') ||
+           isBetween(c, 'A', 'Z');
+  }
+
+  static inline bool isQuote(char c) {
+    return c == '\'' || c == '\"';
+  }
+
+  static inline uint8_t decodeHex(char c) {
+    if (c < 'A')
+      return uint8_t(c - '0');
+    c = char(c & ~0x20);  // uppercase
+    return uint8_t(c - 'A' + 10);
+  }
+
+  DeserializationError::Code skipSpacesAndComments() {
+    for (;;) {
+      switch (current()) {
+        // end of string
+        case '\0':
+          return foundSomething_ ? DeserializationError::IncompleteInput
+                                 : DeserializationError::EmptyInput;
+
+        // spaces
+        case ' ':
+        case '\t':
+        case '\r':
+        case '\n':
+          move();
+          continue;
+
+#if ARDUINOJSON_ENABLE_COMMENTS
+        // comments
+        case '/':
+          move();  // skip '/'
+          switch (current()) {
+            // block comment
+            case '*': {
+              move();  // skip '*'
+              bool wasStar = false;
+              for (;;) {
+                char c = current();
+                if (c == '\0')
+                  return DeserializationError::IncompleteInput;
+                if (c == '/' && wasStar) {
+                  move();
+                  break;
+                }
+                wasStar = c == '*';
+                move();
+              }
+              break;
+            }
+
+            // trailing comment
+            case '/':
+              // no need to skip "//"
+              for (;;) {
+                move();
+                char c = current();
+                if (c == '\0')
+                  return DeserializationError::IncompleteInput;
+                if (c == '\n')
+                  break;
+              }
+              break;
+
+            // not a comment, just a '/'
+            default:
+              return DeserializationError::InvalidInput;
+          }
+          break;
+#endif
+
+        default:
+          foundSomething_ = true;
+          return DeserializationError::Ok;
+      }
+    }
+  }
+
+  DeserializationError::Code skipKeyword(const char* s) {
+    while (*s) {
+      char c = current();
+      if (c == '\0')
+        return DeserializationError::IncompleteInput;
+      if (*s != c)
+        return DeserializationError::InvalidInput;
+      ++s;
+      move();
+    }
+    return DeserializationError::Ok;
+  }
+
+  static const uint8_t maxDepth = ARDUINOJSON_DEFAULT_NESTING_LIMIT;
+
+  Latch<TReader> latch_;
+  TFilter valueFilter_;  // filter for the next value
+  DeserializationOption::NestingLimit valueNesting_;
+  Frame stack_[maxDepth];
+  uint8_t depth_;
+  bool expectValue_;
+  bool done_;
+  bool foundSomething_;
+  bool boolean_;
+  JsonEvent last_;
+  DeserializationError error_;
+  DecimalNumber number_;
+  PullParserBuffer buffer_;
+};
+
+template <typename TReader, typename TOptions>
+using pull_parser_t =
+    JsonPullParser<decltype(makeBufferedReader(declval<TReader>(),
+                                               declval<TOptions>().readBuffer)),
+                   decltype(TOptions::filter)>;
+
+template <typename TReader, typename TOptions>
+pull_parser_t<TReader, TOptions> makeJsonPullParserImpl(TReader reader,
+                                                        TOptions options) {
+  static_assert(is_same<decltype(options.inSitu), NoInSitu>::value,
+                "JsonPullParser doesn't support InSitu");
+  return pull_parser_t<TReader, TOptions>(
+      makeBufferedReader(reader, options.readBuffer), options.filter,
+      options.nestingLimit);
+}
+
+ARDUINOJSON_END_PRIVATE_NAMESPACE
+
+ARDUINOJSON_BEGIN_PUBLIC_NAMESPACE
+
+// Creates an event-based parser for a JSON input.
+// Accepts the same inputs and options as deserializeJson().
+template <typename TInput, typename... Args,
+          detail::enable_if_t<
+              !detail::is_integral<detail::remove_reference_t<
+                  typename detail::first_or_void<Args...>::type>>::value,
+              int> = 0>
+inline auto makeJsonPullParser(TInput&& input, Args&&... args)
+    -> decltype(detail::makeJsonPullParserImpl(
+        detail::makeReader(detail::forward<TInput>(input)),
+        detail::makeDeserializationOptions(args...))) {
+  using namespace detail;
+  return makeJsonPullParserImpl(makeReader(detail::forward<TInput>(input)),
+                                makeDeserializationOptions(args...));
+}
+
+// Creates an event-based parser for a null-terminated JSON input.
+template <typename TChar, typename... Args,
+          detail::enable_if_t<
+              !detail::is_integral<detail::remove_reference_t<
+                  typename detail::first_or_void<Args...>::type>>::value,
+              int> = 0>
+inline auto makeJsonPullParser(TChar* input, Args&&... args)
+    -> decltype(detail::makeJsonPullParserImpl(
+        detail::makeReader(input),
+        detail::makeDeserializationOptions(args...))) {
+  using namespace detail;
+  return makeJsonPullParserImpl(makeReader(input),
+                                makeDeserializationOptions(args...));
+}
+
+// Creates an event-based parser for a JSON input of known size.
+template <typename TChar, typename Size, typename... Args,
+          detail::enable_if_t<detail::is_integral<Size>::value, int> = 0>
+inline auto makeJsonPullParser(TChar* input, Size inputSize, Args&&... args)
+    -> decltype(detail::makeJsonPullParserImpl(
+        detail::makeReader(input, size_t(inputSize)),
+        detail::makeDeserializationOptions(args...))) {
+  using namespace detail;
+  return makeJsonPullParserImpl(makeReader(input, size_t(inputSize)),
+                                makeDeserializationOptions(args...));
+}
+
+ARDUINOJSON_END_PUBLIC_NAMESPACE
@@ -0,0 +1,95 @@
+// ArduinoJson - https://arduinojson.org
+// Copyright © 2014-2025, Benoit BLANCHON
+// MIT License
+
+#pragma once
+
+#include <ArduinoJson/Deserialization/InSitu.hpp>
+#include <ArduinoJson/Memory/ResourceManager.hpp>
+#include <ArduinoJson/Memory/StringBuilder.hpp>
+#include <ArduinoJson/Variant/VariantData.hpp>
+
+ARDUINOJSON_BEGIN_PRIVATE_NAMESPACE
+
+// A StringBuilder that writes strings back to the input buffer.
+// Strings are packed at the beginning of the buffer, one after the other.
+// Each string is shorter than its JSON representation (quotes or, for
+// unquoted keys, the opening brace), so the write position never passes the
+// read position.
+class InSituStringBuilder {
+ public:
+  InSituStringBuilder(ResourceManager* resources, const InSituReader& reader)
+      : resources_(resources),
+        end_(reader.end()),
+        saved_(reader.begin()),
+        ptr_(reader.begin()),
+        containsNul_(false) {}
+
+  void startString() {
+    ptr_ = saved_;
+    containsNul_ = false;
+  }
+
+  void save(VariantData* variant) {
+    ARDUINOJSON_ASSERT(variant != nullptr);
+
+    size_t n = size();
+    if (isTinyString(saved_, n)) {
+      variant->setTinyString(adaptString(saved_, n));
+      return;
+    }
+
+    if (containsNul_ || ptr_ == end_) {
+      // can't be NUL-terminated in place, fall back to a copy
+      StringNode* node = resources_->saveString(adaptString(saved_, n));
+      if (node)
+        variant->setLongString(node);
+      return;
+    }
+
+    *ptr_++ = 0;
+    variant->setLinkedString(saved_);
+    saved_ = ptr_;
+  }
+
+  void append(char c) {
+    ARDUINOJSON_ASSERT(ptr_ < end_);
+    containsNul_ |= c == 0;
+    *ptr_++ = c;
+  }
+
+  bool isValid() const {
+    return true;
+  }
+
+  size_t size() const {
+    return size_t(ptr_ - saved_);
+  }
+
+  JsonString str() const {
+    return JsonString(saved_, size());
+  }
+
+ private:
+  ResourceManager* resources_;
+  char* end_;
+  char* saved_;  // end of the last saved string
+  char* ptr_;
+  bool containsNul_;
+};
+
+// Selects the string builder for a reader
+template <typename TReader>
+struct string_builder {
+  using type = StringBuilder;
+};
+
+template <>
+struct string_builder<InSituReader> {
+  using type = InSituStringBuilder;
+};
+
+template <typename TReader>
+using string_builder_t = typename string_builder<TReader>::type;
+
+ARDUINOJSON_END_PRIVATE_NAMESPACE
@@ -15,6 +15,12 @@ class StringBuilder {
 
   StringBuilder(ResourceManager* resources) : resources_(resources) {}
 
+  // Lets JsonDeserializer construct any builder from its reader
+  // (see InSituStringBuilder)
+  template <typename TReader>
+  StringBuilder(ResourceManager* resources, const TReader&)
+      : StringBuilder(resources) {}
+
   ~StringBuilder() {
     if (node_)
       resources_->destroyString(node_);
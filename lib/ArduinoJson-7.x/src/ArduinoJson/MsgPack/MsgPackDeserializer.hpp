@@ -21,7 +21,8 @@ class MsgPackDeserializer {
       : resources_(resources),
         reader_(reader),
         stringBuffer_(resources),
-        foundSomething_(false) {}
+        foundSomething_(false),
+        elementDropped_(false) {}
 
   template <typename TFilter>
   DeserializationError parse(VariantData* variant, TFilter filter,
@@ -358,8 +359,10 @@ class MsgPackDeserializer {
 
     for (; n; --n) {
       VariantData* value;
+      SlotId previous = NULL_SLOT;
 
       if (elementFilter.allow()) {
+        previous = VariantImpl::lastElement(variant);
         value = VariantImpl::addNewElement(variant, resources_);
         if (!value)
           return DeserializationError::NoMemory;
@@ -370,6 +373,15 @@ class MsgPackDeserializer {
       err = parseVariant(value, elementFilter, nestingLimit.decrement());
       if (err)
         return err;
+
+      if (value) {
+        bool keep = !elementDropped_ &&
+                    elementFilter.keepElement(
+                        JsonVariantConst(value, resources_), JsonString());
+        elementDropped_ = false;
+        if (!keep)
+          VariantImpl::removeLastElement(previous, variant, resources_);
+      }
     }
 
     return DeserializationError::Ok;
@@ -389,6 +401,10 @@ class MsgPackDeserializer {
       variant->toObject();
     }
 
+    // An element predicate can reject the object before its end, but the
+    // remaining members must still be read; the caller drops the object.
+    bool dropped = false;
+
     for (; n; --n) {
       err = readKey();
       if (err)
@@ -397,9 +413,10 @@ class MsgPackDeserializer {
       JsonString key = stringBuffer_.str();
       TFilter memberFilter = filter[key.c_str()];
       VariantData* member = 0;
+      VariantData* keyVariant = 0;
 
       if (memberFilter.allow()) {
-        auto keyVariant = VariantImpl::addPair(&member, variant, resources_);
+        keyVariant = VariantImpl::addPair(&member, variant, resources_);
         if (!keyVariant)
           return DeserializationError::NoMemory;
 
@@ -409,8 +426,13 @@ class MsgPackDeserializer {
       err = parseVariant(member, memberFilter, nestingLimit.decrement());
       if (err)
         return err;
+
+      if (keyVariant && !dropped)
+        dropped = !filter.keepElement(JsonVariantConst(variant, resources_),
+                                      keyVariant->asString());
     }
 
+    elementDropped_ = dropped;
     return DeserializationError::Ok;
   }
 
@@ -444,6 +466,7 @@ class MsgPackDeserializer {
   TReader reader_;
   StringBuffer stringBuffer_;
   bool foundSomething_;
+  bool elementDropped_;  // an element predicate rejected the last object
 };
 
 ARDUINOJSON_END_PRIVATE_NAMESPACE
@@ -9,6 +9,7 @@
 #include <ArduinoJson/Numbers/convertNumber.hpp>
 #include <ArduinoJson/Polyfills/assert.hpp>
 #include <ArduinoJson/Polyfills/ctype.hpp>
+#include <ArduinoJson/Polyfills/limits.hpp>
 #include <ArduinoJson/Polyfills/math.hpp>
 #include <ArduinoJson/Polyfills/type_traits.hpp>
 
@@ -102,17 +103,127 @@ class Number {
 #endif
 };
 
-inline Number parseNumber(const char* s) {
+// A number as written in the text: mantissa * 10^exponent, with a sign.
+// Parsing into this form only uses integer arithmetic; floating-point math
+// happens in toNumber().
+class DecimalNumber {
   using traits = FloatTraits<JsonFloat>;
+
+ public:
   using mantissa_t = largest_type<traits::mantissa_type, JsonUInt>;
+
+  enum class Kind : uint8_t {
+    Invalid,
+    Integer,  // fits in JsonInteger or JsonUInt, exponent is 0
+    Decimal,
+    NaN,
+    Infinity,
+  };
+
+  DecimalNumber()
+      : kind(Kind::Invalid), negative(false), mantissa(0), exponent(0) {}
+
+  Number toNumber() const {
+    switch (kind) {
+      case Kind::Integer:
+        if (negative)
+          return Number(JsonInteger(~mantissa + 1));
+        else
+          return Number(JsonUInt(mantissa));
+
+      case Kind::NaN:
+        return Number(traits::nan());
+
+      case Kind::Infinity:
+        return Number(negative ? -traits::inf() : traits::inf());
+
+      case Kind::Decimal:
+        break;
+
+      default:
+        return Number();
+    }
+
+#if ARDUINOJSON_USE_DOUBLE
+    bool isDouble = exponent < -FloatTraits<float>::exponent_max ||
+                    exponent > FloatTraits<float>::exponent_max ||
+                    mantissa > FloatTraits<float>::mantissa_max;
+    if (isDouble) {
+      auto final_result = make_float(double(mantissa), exponent);
+      return Number(negative ? -final_result : final_result);
+    } else
+#endif
+    {
+      auto final_result = make_float(float(mantissa), exponent);
+      return Number(negative ? -final_result : final_result);
+    }
+  }
+
+  // Stores the value multiplied by 10^decimals and rounded to the nearest
+  // integer, halfway cases away from zero.
+  // The result is exact as long as it has fewer significant digits than
+  // JsonFloat's mantissa (15 for double, 7 for float).
+  // Returns false, leaving result untouched, if the value isn't finite or
+  // doesn't fit in T.
+  template <typename T>
+  bool toFixedPoint(T& result, uint8_t decimals) const {
+    static_assert(is_integral<T>::value, "T must be an integer type");
+
+    if (kind != Kind::Integer && kind != Kind::Decimal)
+      return false;
+
+    mantissa_t limit = mantissa_t(numeric_limits<T>::highest());
+    if (negative)
+      limit = is_signed<T>::value ? limit + 1 : 0;
+
+    mantissa_t m = mantissa;
+    int e = exponent + decimals;
+
+    for (; e > 0 && m != 0; e--) {
+      if (m > limit / 10)
+        return false;
+      m *= 10;
+    }
+
+    // Only the first dropped digit matters: ties round away from zero.
+    bool roundUp = false;
+    for (; e < 0 && m != 0; e++) {
+      roundUp = m % 10 >= 5;
+      m /= 10;
+    }
+    if (e < 0)  // dropped only zeros after the last digit
+      roundUp = false;
+    if (roundUp)
+      m++;
+
+    if (m > limit)
+      return false;
+
+    if (negative && m != 0)
+      result = T(-T(m - 1) - 1);
+    else
+      result = T(m);
+    return true;
+  }
+
+  Kind kind;
+  bool negative;
+  mantissa_t mantissa;
+  int exponent;
+};
+
+inline DecimalNumber parseDecimal(const char* s) {
+  using traits = FloatTraits<JsonFloat>;
+  using mantissa_t = DecimalNumber::mantissa_t;
   using exponent_t = traits::exponent_type;
 
   ARDUINOJSON_ASSERT(s != 0);
 
-  bool is_negative = false;
+  DecimalNumber result;
+
   switch (*s) {
     case '-':
-      is_negative = true;
+      result.negative = true;
       s++;
       break;
     case '+':
@@ -122,18 +233,20 @@ inline Number parseNumber(const char* s) {
 
 #if ARDUINOJSON_ENABLE_NAN
   if (*s == 'n' || *s == 'N') {
-    return Number(traits::nan());
+    result.kind = DecimalNumber::Kind::NaN;
+    return result;
   }
 #endif
 
 #if ARDUINOJSON_ENABLE_INFINITY
   if (*s == 'i' || *s == 'I') {
-    return Number(is_negative ? -traits::inf() : traits::inf());
+    result.kind = DecimalNumber::Kind::Infinity;
+    return result;
   }
 #endif
 
   if (!isdigit(*s) && *s != '.')
-    return Number();
+    return result;
 
   mantissa_t mantissa = 0;
   exponent_t exponent_offset = 0;
@@ -151,14 +264,12 @@ inline Number parseNumber(const char* s) {
   }
 
   if (*s == '\0') {
-    if (is_negative) {
-      const mantissa_t sintMantissaMax = mantissa_t(1)
-                                         << (sizeof(JsonInteger) * 8 - 1);
-      if (mantissa <= sintMantissaMax) {
-        return Number(JsonInteger(~mantissa + 1));
-      }
-    } else {
-      return Number(JsonUInt(mantissa));
+    const mantissa_t sintMantissaMax = mantissa_t(1)
+                                       << (sizeof(JsonInteger) * 8 - 1);
+    if (!result.negative || mantissa <= sintMantissaMax) {
+      result.kind = DecimalNumber::Kind::Integer;
+      result.mantissa = mantissa;
+      return result;
     }
   }
 
@@ -199,10 +310,10 @@ inline Number parseNumber(const char* s) {
     while (isdigit(*s)) {
       exponent = exponent * 10 + (*s - '0');
       if (exponent + exponent_offset > traits::exponent_max) {
-        if (negative_exponent)
-          return Number(is_negative ? -0.0f : 0.0f);
-        else
-          return Number(is_negative ? -traits::inf() : traits::inf());
+        // too small: keep the sign of zero; too large: infinity
+        result.kind = negative_exponent ? DecimalNumber::Kind::Decimal
+                                        : DecimalNumber::Kind::Infinity;
+        return result;
       }
       s++;
     }
@@ -213,21 +324,16 @@ inline Number parseNumber(const char* s) {
 
   // we should be at the end of the string, otherwise it's an error
   if (*s != '\0')
-    return Number();
+    return result;
 
-#if ARDUINOJSON_USE_DOUBLE
-  bool isDouble = exponent < -FloatTraits<float>::exponent_max ||
-                  exponent > FloatTraits<float>::exponent_max ||
-                  mantissa > FloatTraits<float>::mantissa_max;
-  if (isDouble) {
-    auto final_result = make_float(double(mantissa), exponent);
-    return Number(is_negative ? -final_result : final_result);
-  } else
-#endif
-  {
-    auto final_result = make_float(float(mantissa), exponent);
-    return Number(is_negative ? -final_result : final_result);
-  }
+  result.kind = DecimalNumber::Kind::Decimal;
+  result.mantissa = mantissa;
+  result.exponent = exponent;
+  return result;
+}
+
+inline Number parseNumber(const char* s) {
+  return parseDecimal(s).toNumber();
 }
 
 template <typename T>
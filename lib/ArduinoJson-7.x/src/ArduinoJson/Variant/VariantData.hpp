@@ -49,6 +49,8 @@ struct VariantData {
     switch (type) {
       case VariantType::TinyString:
         return JsonString(content.asTinyString);
+      case VariantType::LinkedString:
+        return JsonString(content.asLinkedString);
       case VariantType::LongString:
         return JsonString(content.asStringNode->data,
                           content.asStringNode->length);
@@ -82,7 +84,9 @@ struct VariantData {
   }
 
   bool isString() const {
-    return type == VariantType::LongString || type == VariantType::TinyString;
+    return type == VariantType::LongString ||
+           type == VariantType::TinyString ||
+           type == VariantType::LinkedString;
   }
 
   void setBoolean(bool value) {
@@ -115,6 +119,14 @@ struct VariantData {
     content.asTinyString[n] = 0;
   }
 
+  // Points to a string owned by someone else (see InSituStringBuilder)
+  void setLinkedString(const char* s) {
+    ARDUINOJSON_ASSERT(type == VariantType::Null);
+    ARDUINOJSON_ASSERT(s);
+    type = VariantType::LinkedString;
+    content.asLinkedString = s;
+  }
+
   void setLongString(StringNode* s) {
     ARDUINOJSON_ASSERT(type == VariantType::Null);
     ARDUINOJSON_ASSERT(s);
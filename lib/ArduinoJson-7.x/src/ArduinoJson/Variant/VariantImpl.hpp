@@ -66,6 +66,9 @@ class VariantImpl {
       case VariantType::TinyString:
         return visit.visit(JsonString(data->content.asTinyString));
 
+      case VariantType::LinkedString:
+        return visit.visit(JsonString(data->content.asLinkedString));
+
       case VariantType::LongString:
         return visit.visit(JsonString(data->content.asStringNode->data,
                                       data->content.asStringNode->length));
@@ -107,6 +110,17 @@ class VariantImpl {
   static void addElement(Slot<VariantData> slot, VariantData*,
                          ResourceManager*);
 
+  // Returns the slot of the last element, or NULL_SLOT if the array is empty
+  static SlotId lastElement(const VariantData* data) {
+    ARDUINOJSON_ASSERT(data != nullptr);
+    ARDUINOJSON_ASSERT(data->isArray());
+    return data->content.asCollection.tail;
+  }
+
+  // Removes the last element in O(1), given the slot of the one before
+  static void removeLastElement(SlotId previous, VariantData*,
+                                ResourceManager*);
+
   template <typename TAdaptedString>
   VariantData* addMember(TAdaptedString key) {
     if (!isObject())
@@ -193,6 +207,9 @@ class VariantImpl {
       case VariantType::TinyString:
         str = data->content.asTinyString;
         break;
+      case VariantType::LinkedString:
+        str = data->content.asLinkedString;
+        break;
       case VariantType::LongString:
         str = data->content.asStringNode->data;
         break;
@@ -241,6 +258,9 @@ class VariantImpl {
       case VariantType::TinyString:
         str = data->content.asTinyString;
         break;
+      case VariantType::LinkedString:
+        str = data->content.asLinkedString;
+        break;
       case VariantType::LongString:
         str = data->content.asStringNode->data;
         break;
@@ -0,0 +1,298 @@
+#pragma once
+#include <ArduinoJson.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+
+// Single-pass decoder for tar1090 / dump1090 aircraft.json.
+//
+// Instead of materializing the whole document into a JsonDocument and then
+// looking up a["lat"], a["alt_baro"], ... on every aircraft object, the
+// decoder drives ArduinoJson's JsonPullParser over the stream once and writes
+// the fields we care about straight into an AircraftFields struct. Which JSON
+// key lands in which member is described by a constexpr table
+// (AIRCRAFT_FIELD_MAP). Unknown keys are skipped in place without being
+// stored anywhere, so memory use does not grow with the number of aircraft.
+// The parser is given the field map as a CompiledFilter, so that it rejects
+// them with a hash lookup before they reach the decoder.
+//
+// Decimal fields are decoded into scaled integers (micro-degrees, tenths of
+// a second, ...) straight from the digits, so decoding an aircraft never goes
+// through double, which is soft-float on the ESP32.
+//
+// Errors are reported with ArduinoJson's DeserializationError so the caller
+// can keep printing err.c_str() as before.
+
+// ===================== Destination struct =====================
+// Presence bits: a member is only meaningful if its bit is set in `present`.
+enum AircraftFieldBit : uint16_t
+{
+  AF_HEX = 1u << 0,
+  AF_FLIGHT = 1u << 1,
+  AF_LAT = 1u << 2,
+  AF_LON = 1u << 3,
+  AF_TRACK = 1u << 4,
+  AF_SEEN = 1u << 5,
+  AF_SEEN_POS = 1u << 6,
+  AF_ALT_BARO = 1u << 7,
+};
+
+struct AircraftFields
+{
+  char hex[7];    // 6 hex chars + null (longer ids are truncated)
+  char flight[9]; // up to 8 + null (not trimmed)
+
+  int32_t lat_e6;       // micro-degrees
+  int32_t lon_e6;       // micro-degrees
+  int32_t track_d10;    // tenths of a degree
+  int32_t seen_d10;     // tenths of a second since any message
+  int32_t seen_pos_d10; // tenths of a second since last position
+
+  int32_t alt_baro; // feet; absent when "ground" or not an integer
+
+  uint16_t present; // AF_* bits
+};
+
+// ===================== Field map =====================
+enum class JsonFieldKind : uint8_t
+{
+  Text,    // JSON string -> char[], truncated to the member size
+  Fixed,   // any JSON number -> int32_t scaled by 10^decimals, rounded
+  Integer, // integral JSON number -> int32_t (floats are ignored)
+};
+
+struct JsonFieldSpec
+{
+  const char *key;
+  uint8_t keyLen;
+  JsonFieldKind kind;
+  uint16_t offset; // offsetof() in the destination struct
+  uint8_t size;    // capacity of the destination member (bytes)
+  uint16_t bit;    // presence bit set when the field was decoded
+  uint8_t decimals; // Fixed only: digits kept after the decimal point
+};
+
+template <size_t N>
+static constexpr JsonFieldSpec jsonField(const char (&key)[N], JsonFieldKind kind,
+                                         size_t offset, size_t size, uint16_t bit, uint8_t decimals = 0)
+{
+  return {key, (uint8_t)(N - 1), kind, (uint16_t)offset, (uint8_t)size, bit, decimals};
+}
+
+static constexpr JsonFieldSpec AIRCRAFT_FIELD_MAP[] = {
+    jsonField("hex", JsonFieldKind::Text, offsetof(AircraftFields, hex), sizeof(AircraftFields::hex), AF_HEX),
+    jsonField("flight", JsonFieldKind::Text, offsetof(AircraftFields, flight), sizeof(AircraftFields::flight), AF_FLIGHT),
+    jsonField("lat", JsonFieldKind::Fixed, offsetof(AircraftFields, lat_e6), sizeof(int32_t), AF_LAT, 6),
+    jsonField("lon", JsonFieldKind::Fixed, offsetof(AircraftFields, lon_e6), sizeof(int32_t), AF_LON, 6),
+    jsonField("track", JsonFieldKind::Fixed, offsetof(AircraftFields, track_d10), sizeof(int32_t), AF_TRACK, 1),
+    jsonField("seen", JsonFieldKind::Fixed, offsetof(AircraftFields, seen_d10), sizeof(int32_t), AF_SEEN, 1),
+    jsonField("seen_pos", JsonFieldKind::Fixed, offsetof(AircraftFields, seen_pos_d10), sizeof(int32_t), AF_SEEN_POS, 1),
+    jsonField("alt_baro", JsonFieldKind::Integer, offsetof(AircraftFields, alt_baro), sizeof(int32_t), AF_ALT_BARO),
+};
+
+static const size_t AIRCRAFT_FIELD_COUNT = sizeof(AIRCRAFT_FIELD_MAP) / sizeof(AIRCRAFT_FIELD_MAP[0]);
+
+// Longest key in the map; the parser's key buffer must be able to hold it
+static constexpr size_t maxFieldKeyLen(const JsonFieldSpec *f, size_t n)
+{
+  return n == 0 ? 0 : (f->keyLen > maxFieldKeyLen(f + 1, n - 1) ? f->keyLen : maxFieldKeyLen(f + 1, n - 1));
+}
+
+static const size_t AIRCRAFT_MAX_KEY_LEN = maxFieldKeyLen(AIRCRAFT_FIELD_MAP, AIRCRAFT_FIELD_COUNT);
+
+static_assert(AIRCRAFT_MAX_KEY_LEN < ARDUINOJSON_PULL_PARSER_BUFFER_SIZE, "key buffer too small for AIRCRAFT_FIELD_MAP");
+
+static inline const JsonFieldSpec *findAircraftField(const char *key, size_t len)
+{
+  for (size_t i = 0; i < AIRCRAFT_FIELD_COUNT; i++)
+  {
+    const JsonFieldSpec &f = AIRCRAFT_FIELD_MAP[i];
+    if (f.keyLen == len && f.key[0] == key[0] && memcmp(f.key, key, len) == 0)
+      return &f;
+  }
+  return nullptr;
+}
+
+// The members of AIRCRAFT_FIELD_MAP, as a filter compiled into a hash table.
+// The parser skips the ~35 other members of each aircraft by itself, so the
+// decoder never sees their keys.
+static const DeserializationOption::CompiledFilter &aircraftJsonFilter()
+{
+  static JsonDocument filter;
+  if (filter.isNull())
+  {
+    filter["now"] = true;
+    JsonObject fields = filter["aircraft"].add<JsonObject>();
+    for (size_t i = 0; i < AIRCRAFT_FIELD_COUNT; i++)
+      fields[AIRCRAFT_FIELD_MAP[i].key] = true;
+  }
+  static DeserializationOption::CompiledFilter compiled(filter);
+  return compiled;
+}
+
+// ===================== Decoder =====================
+template <typename TParser>
+class AircraftJsonDecoder
+{
+public:
+  explicit AircraftJsonDecoder(TParser &parser) : parser_(parser) {}
+
+  // Decodes a whole aircraft.json document.
+  // `now` receives the top-level "now" (0 if absent); onAircraft(const AircraftFields&)
+  // is called once per element of the "aircraft" array, as soon as it has
+  // been parsed. On an error, the elements before it have been delivered.
+  template <typename TCallback>
+  DeserializationError decode(double &now, TCallback onAircraft)
+  {
+    now = 0;
+
+    JsonEvent ev = parser_.next();
+    if (ev == JsonEvent::Error)
+      return parser_.error();
+    if (ev != JsonEvent::BeginObject)
+      return DeserializationError::InvalidInput;
+
+    for (;;)
+    {
+      ev = parser_.next();
+      if (ev == JsonEvent::EndObject)
+        return DeserializationError::Ok;
+      if (ev != JsonEvent::Key)
+        return parser_.error();
+
+      if (keyIs("now"))
+      {
+        if (parser_.next() == JsonEvent::Number)
+          now = parser_.template number<double>();
+        else
+          parser_.skip(); // rest of a container, no-op after a scalar
+      }
+      else if (keyIs("aircraft"))
+      {
+        if (parser_.next() == JsonEvent::BeginArray)
+          decodeAircraftArray(onAircraft);
+        else
+          parser_.skip();
+      }
+      else
+      {
+        parser_.skip();
+      }
+
+      if (parser_.error())
+        return parser_.error();
+    }
+  }
+
+private:
+  template <typename TCallback>
+  void decodeAircraftArray(TCallback &onAircraft)
+  {
+    for (;;)
+    {
+      JsonEvent ev = parser_.next();
+      if (ev == JsonEvent::EndArray || ev == JsonEvent::Error)
+        return;
+
+      if (ev == JsonEvent::BeginObject)
+      {
+        AircraftFields f;
+        if (!decodeAircraft(f))
+          return;
+        onAircraft(f);
+      }
+      else
+      {
+        parser_.skip();
+      }
+    }
+  }
+
+  bool decodeAircraft(AircraftFields &f)
+  {
+    memset(&f, 0, sizeof(f));
+    uint8_t *base = (uint8_t *)&f;
+
+    for (;;)
+    {
+      JsonEvent ev = parser_.next();
+      if (ev == JsonEvent::EndObject)
+        return true;
+      if (ev != JsonEvent::Key)
+        return false;
+
+      JsonString key = parser_.key();
+      const JsonFieldSpec *spec = findAircraftField(key.c_str(), key.size());
+      if (spec)
+        decodeField(*spec, parser_.next(), base, f.present);
+      else
+        parser_.skip();
+    }
+  }
+
+  // Writes one value into its destination member if the JSON type matches,
+  // otherwise consumes it and leaves the field absent.
+  void decodeField(const JsonFieldSpec &spec, JsonEvent ev, uint8_t *base, uint16_t &present)
+  {
+    switch (spec.kind)
+    {
+    case JsonFieldKind::Text:
+      if (ev == JsonEvent::String)
+      {
+        JsonString s = parser_.string();
+        size_t n = s.size() < spec.size ? s.size() : spec.size - 1u;
+        char *dst = (char *)(base + spec.offset);
+        memcpy(dst, s.c_str(), n);
+        dst[n] = 0;
+        present |= spec.bit;
+        return;
+      }
+      break;
+
+    case JsonFieldKind::Fixed:
+    case JsonFieldKind::Integer:
+      if (ev == JsonEvent::Number)
+      {
+        // out-of-range values leave the field absent
+        int32_t v;
+        bool ok = spec.kind == JsonFieldKind::Fixed || parser_.isInteger();
+        if (ok && parser_.fixedPoint(v, spec.decimals))
+        {
+          memcpy(base + spec.offset, &v, sizeof(v));
+          present |= spec.bit;
+        }
+        return;
+      }
+      break;
+    }
+
+    parser_.skip();
+  }
+
+  template <size_t N>
+  bool keyIs(const char (&name)[N])
+  {
+    JsonString key = parser_.key();
+    return key.size() == N - 1 && memcmp(key.c_str(), name, N - 1) == 0;
+  }
+
+  TParser &parser_;
+};
+
+// Decodes aircraft.json from any input accepted by deserializeJson()
+// (Stream, String, const char*, ...). Extra arguments are passed to the
+// parser as deserialization options (e.g. a DeserializationOption::ReadBuffer).
+template <typename TInput, typename TCallback, typename... TOptions>
+static DeserializationError decodeAircraftJson(TInput &&input, double &now, TCallback onAircraft, TOptions &&...options)
+{
+  auto parser = makeJsonPullParser(input, aircraftJsonFilter(), options...);
+  return AircraftJsonDecoder<decltype(parser)>(parser).decode(now, onAircraft);
+}
+
+// Same, for an input of known size
+template <typename TCallback>
+static DeserializationError decodeAircraftJson(const char *input, size_t size, double &now, TCallback onAircraft)
+{
+  auto parser = makeJsonPullParser(input, size, aircraftJsonFilter());
+  return AircraftJsonDecoder<decltype(parser)>(parser).decode(now, onAircraft);
+}
@@ -0,0 +1,51 @@
+#include "HB9IIU_Brightness.h"
+
+static const char *PREF_KEY_BL = "bl";
+
+uint8_t BrightnessSetting::load()
+{
+  level_ = storage_.getUChar(PREF_KEY_BL, level_);
+  saved_ = level_;
+  return level_;
+}
+
+bool BrightnessSetting::touch(bool brighter)
+{
+  const uint32_t now = clock_.millis();
+  bool changed = false;
+
+  if (now - lastStepMs_ >= BL_STEP_MS)
+  {
+    lastStepMs_ = now;
+
+    const uint8_t old = level_;
+    if (brighter)
+      level_ = (level_ + BL_STEP > 100) ? 100 : (level_ + BL_STEP);
+    else
+      level_ = (level_ < BL_STEP) ? 0 : (level_ - BL_STEP);
+
+    if (level_ != old)
+    {
+      dirty_ = true;
+      changed = true;
+    }
+  }
+  lastTouchMs_ = now; // update "activity"
+  return changed;
+}
+
+bool BrightnessSetting::saveIfIdle()
+{
+  if (!dirty_)
+    return false;
+  if ((clock_.millis() - lastTouchMs_) < BL_SAVE_IDLE_MS)
+    return false;
+
+  dirty_ = false;
+  // only write if different from last saved value
+  if (level_ == saved_)
+    return false;
+  storage_.putUChar(PREF_KEY_BL, level_);
+  saved_ = level_;
+  return true;
+}
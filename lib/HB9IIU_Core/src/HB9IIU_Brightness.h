@@ -0,0 +1,38 @@
+#pragma once
+#include <stdint.h>
+#include "HB9IIU_Platform.h"
+
+// Backlight level set by touch, saved to Storage once the panel hasn't been
+// touched for BL_SAVE_IDLE_MS (limits flash wear while the finger slides)
+class BrightnessSetting
+{
+public:
+  static const uint32_t BL_SAVE_IDLE_MS = 5000; // save after 5s no touch
+  static const uint32_t BL_STEP_MS = 180;       // repeat rate while finger is down
+  static const uint8_t BL_STEP = 5;             // percent per step
+
+  BrightnessSetting(Storage &storage, Clock &clock, uint8_t defaultPercent)
+      : storage_(storage), clock_(clock), level_(defaultPercent), saved_(255),
+        dirty_(false), lastTouchMs_(0), lastStepMs_(0) {}
+
+  // Reads the saved level (the default if none was saved)
+  uint8_t load();
+
+  uint8_t percent() const { return level_; }
+
+  // Call for every touch sample; upper half => brighter, lower half => dimmer.
+  // Returns true if the level changed.
+  bool touch(bool brighter);
+
+  // Returns true if the level was written to Storage
+  bool saveIfIdle();
+
+private:
+  Storage &storage_;
+  Clock &clock_;
+  uint8_t level_;  // current brightness
+  uint8_t saved_;  // last saved value (255 = nothing saved yet)
+  bool dirty_;
+  uint32_t lastTouchMs_;
+  uint32_t lastStepMs_;
+};
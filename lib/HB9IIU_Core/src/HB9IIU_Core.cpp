@@ -0,0 +1,127 @@
+#include "HB9IIU_Core.h"
+#include <string.h>
+
+AdsbCore::AdsbCore(Clock &clock, Display &display, Network &network,
+                   const MapView &view, const RenderAssets &assets)
+    : clock_(clock),
+      display_(display),
+      network_(network),
+      tracks_(view),
+      renderer_(display, assets),
+      bar_(display),
+      overlay_(nullptr),
+      current_(nullptr),
+      nDraw_(0)
+{
+}
+
+// ===================== Network fetch + parse =====================
+bool AdsbCore::fetchAndUpdateTracks(FetchReport &report)
+{
+  report = FetchReport();
+
+  if (!network_.connected())
+    return false;
+
+  const uint32_t t0 = clock_.millis();
+  report.httpCode = network_.get();
+  const uint32_t t1 = clock_.millis();
+  report.httpMs = t1 - t0;
+
+  if (report.httpCode != 200)
+  {
+    network_.end();
+    return false;
+  }
+
+  current_ = &report.stats;
+  report.error = network_.decode(report.now, *this);
+  current_ = nullptr;
+  network_.end();
+
+  report.parseMs = clock_.millis() - t1;
+
+  if (report.error)
+    return false;
+
+  last_ = report.stats;
+  return true;
+}
+
+// Applies one decoded aircraft object to the track table
+void AdsbCore::onAircraft(const AircraftFields &a)
+{
+  FetchStats &st = *current_;
+
+  TrackFix fix;
+  if (!tracks_.accept(a, st, fix))
+    return;
+
+  const int idx = tracks_.slotFor(a.hex);
+  Track &t = tracks_[idx];
+
+  if (t.used && strncmp(t.hex, a.hex, 6) != 0)
+  {
+    display_.startWrite();
+    renderer_.eraseTrackIfDrawn(t);
+    display_.endWrite();
+  }
+
+  tracks_.assign(idx, a, fix, clock_.millis());
+
+  st.updated++;
+}
+
+// ===================== Render =====================
+void AdsbCore::expireOldTracks()
+{
+  const uint32_t now = clock_.millis();
+  display_.startWrite();
+  for (int i = 0; i < MAX_TRACKS; i++)
+  {
+    if (!tracks_[i].used)
+      continue;
+    if (tracks_.isExpired(i, now))
+    {
+      renderer_.eraseTrackIfDrawn(tracks_[i]);
+      tracks_[i].used = false;
+    }
+  }
+  display_.endWrite();
+}
+
+void AdsbCore::renderTracks()
+{
+  // expire old ones (erases the whole sprite area)
+  expireOldTracks();
+
+  nDraw_ = tracks_.buildDrawList(clock_.millis(), drawIdx_, MAX_DRAW);
+
+  Rect dirty[MAX_DIRTY + MAX_OVERLAY_RECTS];
+  int nDirty = planDirtyRects(tracks_, drawIdx_, nDraw_, dirty);
+  if (overlay_)
+    nDirty += overlay_->takeDirtyRects(dirty + nDirty, MAX_OVERLAY_RECTS);
+
+  char line[96];
+  formatBottomBar(line, sizeof(line), tracks_, drawIdx_, nDraw_, last_);
+
+  display_.startWrite();
+  renderer_.drawDirtyRegions(tracks_, dirty, nDirty, drawIdx_, nDraw_);
+  bar_.drawTextDiff(line);
+  display_.endWrite();
+}
+
+void AdsbCore::setOverlay(OverlayLayer *overlay)
+{
+  overlay_ = overlay;
+  renderer_.setOverlay(overlay);
+  if (overlay)
+    overlay->invalidate();
+}
+
+void AdsbCore::showStatus(const char *text)
+{
+  display_.startWrite();
+  bar_.drawTextDiff(text);
+  display_.endWrite();
+}
@@ -0,0 +1,84 @@
+#pragma once
+#include "HB9IIU_CoreConfig.h"
+#include "HB9IIU_DirtyRects.h"
+#include "HB9IIU_Geo.h"
+#include "HB9IIU_Overlay.h"
+#include "HB9IIU_Platform.h"
+#include "HB9IIU_Renderer.h"
+#include "HB9IIU_StatusBar.h"
+#include "HB9IIU_TrackStore.h"
+
+// Ingest -> track store -> draw list -> dirty regions -> panel, independent
+// of the board: time, pixels and aircraft.json all come through the
+// interfaces of HB9IIU_Platform.h.
+
+// What happened during one fetch (printed with DEBUG_FETCH)
+struct FetchReport
+{
+  int httpCode = 0;
+  DeserializationError error;
+  double now = 0;       // "now" of the document
+  uint32_t httpMs = 0;  // request until headers
+  uint32_t parseMs = 0; // body decode + track updates
+  FetchStats stats;
+};
+
+class AdsbCore : private AircraftSink
+{
+public:
+  AdsbCore(Clock &clock, Display &display, Network &network,
+           const MapView &view, const RenderAssets &assets);
+
+  // GETs aircraft.json and updates the tracks from it. Returns false if the
+  // network is down, the request failed or the JSON was invalid; `report`
+  // is filled as far as the fetch went. Tracks are updated while the body
+  // is decoded, so after invalid or truncated JSON the aircraft before the
+  // error have been applied and lastStats() is left as it was.
+  bool fetchAndUpdateTracks(FetchReport &report);
+
+  // Expires old tracks, then restores and redraws the regions that changed
+  // and updates the bottom bar
+  void renderTracks();
+
+  // Replaces the text of the bottom bar (startup / Wi-Fi messages)
+  void showStatus(const char *text);
+
+  // Font of the bottom bar, e.g. GLCD_FONT_PROPORTIONAL (default GLCD_FONT)
+  void setBarFont(const BitmapFont &font) { bar_.setFont(font); }
+
+  // Call inside startWrite()/endWrite()
+  void drawLegendBar() { renderer_.drawLegendBar(); }
+
+  // Annotation layer drawn under the planes (nullptr: none). Its dirty tiles
+  // are redrawn by renderTracks(), at most MAX_OVERLAY_RECTS rects a frame.
+  static const int MAX_OVERLAY_RECTS = 16;
+  void setOverlay(OverlayLayer *overlay);
+
+  const TrackStore &tracks() const { return tracks_; }
+
+  // Counters of the last successful fetch
+  const FetchStats &lastStats() const { return last_; }
+
+  // The planes drawn by the last renderTracks()
+  const int *drawList() const { return drawIdx_; }
+  int drawCount() const { return nDraw_; }
+
+private:
+  void onAircraft(const AircraftFields &a) override;
+  void expireOldTracks();
+
+  Clock &clock_;
+  Display &display_;
+  Network &network_;
+
+  TrackStore tracks_;
+  Renderer renderer_;
+  StatusBar bar_;
+  OverlayLayer *overlay_;
+
+  FetchStats last_;
+  FetchStats *current_; // counters of the fetch in progress
+
+  int drawIdx_[MAX_DRAW];
+  int nDraw_;
+};
@@ -0,0 +1,76 @@
+#pragma once
+#include <stdint.h>
+
+// Tuning shared by the firmware and the host build. Everything here is plain
+// C++: no Arduino, TFT_eSPI or ESP-IDF header may be included by the core.
+
+// Track storage limit
+static const int MAX_TRACKS = 200;
+
+// How many planes to actually DRAW each refresh (performance knob)
+static const int MAX_DRAW = 99;
+
+// Ignore stale positions older than this (seconds, from JSON seen_pos)
+static const double MAX_SEEN_POS_S = 30.0;
+// "Total aircraft" count uses JSON field "seen" (can be older than position)
+static const double MAX_SEEN_S = 60.0;
+// Same limits in the decoder's units (tenths of a second)
+static const int32_t MAX_SEEN_POS_D10 = (int32_t)(MAX_SEEN_POS_S * 10);
+static const int32_t MAX_SEEN_D10 = (int32_t)(MAX_SEEN_S * 10);
+
+// Remove/erase planes if not updated for this long (ms)
+static const uint32_t TRACK_TTL_MS = 15000;
+
+// Refresh interval (ms)
+static const uint32_t FETCH_PERIOD_MS = 1000;
+
+// Range filter (km) just to reject far aircraft early (optional)
+static const double RANGE_KM = 500.0;
+
+// ===================== Screen / sprites =====================
+static const int SW = 480;
+static const int SH = 320;
+
+// plane sprite size (must match plane32_360.h)
+static const int PW = 32;
+static const int PH = 32;
+
+// sprite mapping (your working fix)
+static const bool SPRITE_CCW = true;
+static const int SPRITE_OFFSET_DEG = 0;
+static const bool SPRITE_FLIP_180 = false;
+
+// ===================== RGB565 colors =====================
+// Same values as TFT_eSPI's TFT_* macros
+static const uint16_t RGB565_BLACK = 0x0000;
+static const uint16_t RGB565_WHITE = 0xFFFF;
+static const uint16_t RGB565_RED = 0xF800;
+static const uint16_t RGB565_GREEN = 0x07E0;
+static const uint16_t RGB565_YELLOW = 0xFFE0;
+static const uint16_t RGB565_CYAN = 0x07FF;
+static const uint16_t RGB565_DARKGREY = 0x7BEF;
+
+// ===================== Altitude color layers (meters) =====================
+// altitude_m == -1 means "unknown"
+static const int ALT_L1_M = 1000; // < 1 km
+static const int ALT_L2_M = 5000; // 1..5 km
+static const int ALT_L3_M = 9000; // 5..9 km
+// >= 9 km is the highest band
+
+// Colors per band
+static const uint16_t ALT_COLOR_UNKNOWN = RGB565_DARKGREY;
+static const uint16_t ALT_COLOR_L1 = RGB565_RED;    // low
+static const uint16_t ALT_COLOR_L2 = RGB565_GREEN;  // medium-low
+static const uint16_t ALT_COLOR_L3 = RGB565_YELLOW; // medium-high
+static const uint16_t ALT_COLOR_L4 = RGB565_CYAN;   // high
+
+// ===================== Legend bar tuning =====================
+static const int LEGEND_H = 18;               // bar height
+static const int LEGEND_LEFT_MARGIN = 50;     // shift legend row left/right
+static const int LEGEND_TEXT_Y_OFFSET = 0;    // text vertical tweak
+static const int LEGEND_SWATCH_Y_OFFSET = -1; // swatch vertical tweak
+
+// ===================== Bottom status bar =====================
+static const int BOTTOM_H = 18;            // pixels reserved at bottom
+static const int BOTTOM_LEFT_MARGIN = 25;  // horizontal offset
+static const int BOTTOM_TEXT_Y_OFFSET = 2; // vertical tweak for text
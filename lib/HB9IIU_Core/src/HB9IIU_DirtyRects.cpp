@@ -0,0 +1,90 @@
+#include "HB9IIU_DirtyRects.h"
+
+Rect rectClampToScreen(Rect r)
+{
+  if (r.x < 0)
+  {
+    r.w += r.x;
+    r.x = 0;
+  }
+  if (r.y < 0)
+  {
+    r.h += r.y;
+    r.y = 0;
+  }
+  if (r.x + r.w > SW)
+    r.w = SW - r.x;
+  if (r.y + r.h > SH)
+    r.h = SH - r.y;
+  if (r.w < 0)
+    r.w = 0;
+  if (r.h < 0)
+    r.h = 0;
+  return r;
+}
+
+bool isInDrawList(int idx, const int list[], int n)
+{
+  for (int i = 0; i < n; i++)
+    if (list[i] == idx)
+      return true;
+  return false;
+}
+
+int planDirtyRects(TrackStore &tracks, const int drawIdx[], int nDraw, Rect dirty[])
+{
+  int nDirty = 0;
+
+  // removed-from-draw-list: mark their old rect dirty so they get erased
+  for (int i = 0; i < MAX_TRACKS; i++)
+  {
+    if (!tracks[i].used)
+      continue;
+    if (tracks[i].drawn && !isInDrawList(i, drawIdx, nDraw))
+    {
+      dirty[nDirty++] = trackRectOld(tracks[i]);
+      tracks[i].drawn = false; // will be gone after redraw pass
+    }
+  }
+
+  // old + new rects for the ones we will draw
+  for (int k = 0; k < nDraw; k++)
+  {
+    Track &t = tracks[drawIdx[k]];
+    if (t.drawn)
+    {
+      dirty[nDirty++] = trackRectOld(t);
+    }
+    dirty[nDirty++] = trackRectCurrent(t);
+  }
+
+  // clamp dirty rects to screen and drop empties
+  int wptr = 0;
+  for (int i = 0; i < nDirty; i++)
+  {
+    Rect r = rectClampToScreen(dirty[i]);
+    if (r.w > 0 && r.h > 0)
+      dirty[wptr++] = r;
+  }
+  nDirty = wptr;
+
+  // Merge overlapping dirty rects (simple O(n^2); n is small)
+  for (int i = 0; i < nDirty; i++)
+  {
+    for (int j = i + 1; j < nDirty;)
+    {
+      if (rectIntersects(dirty[i], dirty[j]))
+      {
+        dirty[i] = rectClampToScreen(rectUnion(dirty[i], dirty[j]));
+        dirty[j] = dirty[nDirty - 1];
+        nDirty--;
+      }
+      else
+      {
+        j++;
+      }
+    }
+  }
+
+  return nDirty;
+}
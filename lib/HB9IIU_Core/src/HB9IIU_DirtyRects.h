@@ -0,0 +1,47 @@
+#pragma once
+#include "HB9IIU_TrackStore.h"
+
+// ===================== Dirty-rect planning (handles overlaps) =====================
+struct Rect
+{
+  int x, y, w, h;
+};
+
+// enough for old+new of each drawn plane + the planes removed from the list
+static const int MAX_DIRTY = 2 * MAX_DRAW + MAX_DRAW;
+
+Rect rectClampToScreen(Rect r);
+
+inline bool rectIntersects(const Rect &a, const Rect &b)
+{
+  return !(a.x + a.w <= b.x || b.x + b.w <= a.x ||
+           a.y + a.h <= b.y || b.y + b.h <= a.y);
+}
+
+inline Rect rectUnion(const Rect &a, const Rect &b)
+{
+  int x1 = a.x < b.x ? a.x : b.x;
+  int y1 = a.y < b.y ? a.y : b.y;
+  int x2 = a.x + a.w > b.x + b.w ? a.x + a.w : b.x + b.w;
+  int y2 = a.y + a.h > b.y + b.h ? a.y + a.h : b.y + b.h;
+  return {x1, y1, x2 - x1, y2 - y1};
+}
+
+inline Rect trackRectCurrent(const Track &t)
+{
+  return {t.cx - PW / 2, t.cy - PH / 2, PW, PH};
+}
+
+inline Rect trackRectOld(const Track &t)
+{
+  return {t.oldDrawX, t.oldDrawY, PW, PH};
+}
+
+bool isInDrawList(int idx, const int list[], int n);
+
+// Fills `dirty` (MAX_DIRTY entries) with the screen regions to restore:
+// - for each plane we will draw: its old rect (if previously drawn) and its new rect
+// - for planes that were drawn but are no longer in draw list: their old rect
+// Those planes are marked as not drawn. The regions are clamped to the screen
+// and merged until none overlap. Returns their number.
+int planDirtyRects(TrackStore &tracks, const int drawIdx[], int nDraw, Rect dirty[]);
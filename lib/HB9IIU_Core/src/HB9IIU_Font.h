@@ -0,0 +1,36 @@
+#pragma once
+#include <stdint.h>
+
+// ===================== Bitmap fonts =====================
+// Fonts for text the core renders in RAM (the bottom bar). Glyphs are stored
+// like the GLCD font of TFT_eSPI / Adafruit GFX: `width` bytes per glyph, one
+// per column, bit 0 at the top.
+struct BitmapFont
+{
+  const uint8_t *columns; // glyphs first..last
+  char first, last;       // others are drawn as a space
+  uint8_t width;          // columns per glyph
+  uint8_t height;         // rows, at most 8
+  uint8_t spacing;        // blank columns after a glyph
+  bool proportional;      // advance by the inked columns instead of `width`
+};
+
+// The 5x7 GLCD font (TFT_eSPI font 1) for printable ASCII: a fixed 6 pixel
+// cell, same pixels as drawString(), and a proportional variant
+extern const BitmapFont GLCD_FONT;
+extern const BitmapFont GLCD_FONT_PROPORTIONAL;
+
+// Pixels from the pen position to the first column drawn, and to the next pen
+// position
+int fontInkOffset(const BitmapFont &font, char c);
+int fontAdvance(const BitmapFont &font, char c);
+
+int fontTextWidth(const BitmapFont &font, const char *text);
+
+// Column `i` of glyph `c` (bit 0 at the top)
+inline uint8_t fontColumn(const BitmapFont &font, char c, int i)
+{
+  if (c < font.first || c > font.last)
+    return 0;
+  return font.columns[(c - font.first) * font.width + i];
+}
@@ -0,0 +1,65 @@
+#include "HB9IIU_Geo.h"
+#include "HB9IIU_CoreConfig.h"
+#include <math.h>
+
+// Arduino's PI, which the host doesn't have
+static const double GEO_PI = 3.1415926535897932384626433832795;
+
+double deg2rad(double d) { return d * (GEO_PI / 180.0); }
+double rad2deg(double r) { return r * (180.0 / GEO_PI); }
+
+double haversine_km(double lat1, double lon1, double lat2, double lon2)
+{
+  const double R = 6371.0;
+  const double dLat = deg2rad(lat2 - lat1);
+  const double dLon = deg2rad(lon2 - lon1);
+  const double a = sin(dLat / 2) * sin(dLat / 2) +
+                   cos(deg2rad(lat1)) * cos(deg2rad(lat2)) *
+                       sin(dLon / 2) * sin(dLon / 2);
+  const double c = 2.0 * atan2(sqrt(a), sqrt(1 - a));
+  return R * c;
+}
+
+double bearing_deg(double lat1, double lon1, double lat2, double lon2)
+{
+  const double phi1 = deg2rad(lat1);
+  const double phi2 = deg2rad(lat2);
+  const double dLon = deg2rad(lon2 - lon1);
+
+  const double y = sin(dLon) * cos(phi2);
+  const double x = cos(phi1) * sin(phi2) - sin(phi1) * cos(phi2) * cos(dLon);
+  double brng = rad2deg(atan2(y, x));
+  if (brng < 0)
+    brng += 360.0;
+  return brng;
+}
+
+void latlon_to_global_pixels(double lat_deg, double lon_deg, int zoom, double &x, double &y)
+{
+  if (lat_deg > 85.05112878)
+    lat_deg = 85.05112878;
+  if (lat_deg < -85.05112878)
+    lat_deg = -85.05112878;
+
+  const double lat = deg2rad(lat_deg);
+  const double n = (double)(1UL << zoom); // 2^zoom
+  x = (lon_deg + 180.0) / 360.0 * (256.0 * n);
+  y = (1.0 - log(tan(lat) + (1.0 / cos(lat))) / GEO_PI) / 2.0 * (256.0 * n);
+}
+
+bool latlon_to_screen_xy(const MapView &view, double lat, double lon, int &sx, int &sy)
+{
+  double gx, gy;
+  latlon_to_global_pixels(lat, lon, view.zoom, gx, gy);
+  const double fx = gx - view.px0;
+  const double fy = gy - view.py0;
+
+  sx = (int)lround(fx);
+  sy = (int)lround(fy);
+
+  if (sx < -PW || sx > SW + PW)
+    return false;
+  if (sy < -PH || sy > SH + PH)
+    return false;
+  return true;
+}
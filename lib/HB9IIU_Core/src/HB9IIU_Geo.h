@@ -0,0 +1,24 @@
+#pragma once
+
+// Home position and the slippy-map window the background was rendered from
+// (see Config.h: HOME_LAT/HOME_LON, MAP_ZOOM, MAP_PX0/MAP_PY0)
+struct MapView
+{
+  double homeLat;
+  double homeLon;
+  int zoom;
+  double px0; // global pixel of the screen's top-left corner
+  double py0;
+};
+
+double deg2rad(double d);
+double rad2deg(double r);
+
+double haversine_km(double lat1, double lon1, double lat2, double lon2);
+double bearing_deg(double lat1, double lon1, double lat2, double lon2);
+
+// Slippy-map global pixels (same math as your Python)
+void latlon_to_global_pixels(double lat_deg, double lon_deg, int zoom, double &x, double &y);
+
+// Screen position of the sprite center; false if the sprite can't be visible
+bool latlon_to_screen_xy(const MapView &view, double lat, double lon, int &sx, int &sy);
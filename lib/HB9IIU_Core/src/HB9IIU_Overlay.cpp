@@ -0,0 +1,199 @@
+#include "HB9IIU_Overlay.h"
+#include <string.h>
+
+OverlayLayer::OverlayLayer(uint8_t *pixels) : pixels_(pixels)
+{
+  memset(pixels_, 0, BYTES);
+  for (int i = 0; i < 16; i++)
+    palette_[i] = RGB565_WHITE;
+  memset(dirty_, 0, sizeof(dirty_));
+}
+
+void OverlayLayer::setPalette(uint8_t index, uint16_t color)
+{
+  index &= 0x0F;
+  if (palette_[index] == color)
+    return;
+  palette_[index] = color;
+  invalidate();
+}
+
+uint8_t OverlayLayer::pixel(int x, int y) const
+{
+  if (!inside(x, y))
+    return CLEAR;
+  const uint8_t b = pixels_[offset(x, y)];
+  return (x & 1) ? b & 0x0F : b >> 4;
+}
+
+// ===================== Drawing =====================
+void OverlayLayer::setPixel(int x, int y, uint8_t index)
+{
+  if (!inside(x, y))
+    return;
+  uint8_t &b = pixels_[offset(x, y)];
+  const uint8_t old = b;
+  if (x & 1)
+    b = (b & 0xF0) | (index & 0x0F);
+  else
+    b = (b & 0x0F) | (uint8_t)(index << 4);
+  if (b != old)
+    dirty_[y / TILE] |= 1UL << (x / TILE);
+}
+
+void OverlayLayer::fillRect(int x, int y, int w, int h, uint8_t index)
+{
+  Rect r = rectClampToScreen({x, y, w, h});
+  if (r.y < TOP)
+  {
+    r.h -= TOP - r.y;
+    r.y = TOP;
+  }
+  if (r.y + r.h > BOTTOM)
+    r.h = BOTTOM - r.y;
+  if (r.w <= 0 || r.h <= 0)
+    return;
+
+  index &= 0x0F;
+  const uint8_t both = (uint8_t)(index << 4 | index);
+  for (int row = r.y; row < r.y + r.h; row++)
+  {
+    int x0 = r.x;
+    int x1 = r.x + r.w; // exclusive
+    if (x0 & 1)
+      setPixel(x0++, row, index);
+    if ((x1 & 1) && x1 > x0)
+      setPixel(--x1, row, index);
+    if (x1 > x0)
+      memset(pixels_ + offset(x0, row), both, (x1 - x0) >> 1);
+  }
+  markDirty(r.x, r.y, r.w, r.h);
+}
+
+void OverlayLayer::drawLine(int x0, int y0, int x1, int y1, uint8_t index)
+{
+  const int dx = x1 > x0 ? x1 - x0 : x0 - x1;
+  const int dy = y1 > y0 ? y0 - y1 : y1 - y0; // negative
+  const int sx = x0 < x1 ? 1 : -1;
+  const int sy = y0 < y1 ? 1 : -1;
+  int err = dx + dy;
+
+  for (;;)
+  {
+    setPixel(x0, y0, index);
+    if (x0 == x1 && y0 == y1)
+      break;
+    const int e2 = 2 * err;
+    if (e2 >= dy)
+    {
+      err += dy;
+      x0 += sx;
+    }
+    if (e2 <= dx)
+    {
+      err += dx;
+      y0 += sy;
+    }
+  }
+}
+
+void OverlayLayer::drawCircle(int cx, int cy, int r, uint8_t index)
+{
+  int x = r, y = 0, err = 1 - r;
+  while (x >= y)
+  {
+    setPixel(cx + x, cy + y, index);
+    setPixel(cx + y, cy + x, index);
+    setPixel(cx - y, cy + x, index);
+    setPixel(cx - x, cy + y, index);
+    setPixel(cx - x, cy - y, index);
+    setPixel(cx - y, cy - x, index);
+    setPixel(cx + y, cy - x, index);
+    setPixel(cx + x, cy - y, index);
+
+    y++;
+    if (err < 0)
+    {
+      err += 2 * y + 1;
+    }
+    else
+    {
+      x--;
+      err += 2 * (y - x) + 1;
+    }
+  }
+}
+
+// ===================== Dirty tiles =====================
+void OverlayLayer::markDirty(int x, int y, int w, int h)
+{
+  const int tx0 = x / TILE, tx1 = (x + w - 1) / TILE;
+  const uint32_t bits = (tx1 - tx0 == 31 ? 0xFFFFFFFFUL : (1UL << (tx1 - tx0 + 1)) - 1) << tx0;
+  for (int ty = y / TILE; ty <= (y + h - 1) / TILE; ty++)
+    dirty_[ty] |= bits;
+}
+
+void OverlayLayer::invalidate()
+{
+  markDirty(0, TOP, SW, BOTTOM - TOP);
+}
+
+int OverlayLayer::takeDirtyRects(Rect out[], int max)
+{
+  int n = 0;
+  for (int ty = 0; ty < TILES_Y; ty++)
+  {
+    int tx = 0;
+    while (dirty_[ty] && tx < TILES_X)
+    {
+      if (!(dirty_[ty] & (1UL << tx)))
+      {
+        tx++;
+        continue;
+      }
+
+      // The run of dirty tiles from tx
+      int end = tx;
+      while (end < TILES_X && (dirty_[ty] & (1UL << end)))
+        end++;
+      const uint32_t run = ((end - tx == 32 ? 0xFFFFFFFFUL : (1UL << (end - tx)) - 1)) << tx;
+
+      if (n == max)
+        return n;
+
+      // Rows below with the same tiles dirty join it
+      int ty1 = ty + 1;
+      while (ty1 < TILES_Y && (dirty_[ty1] & run) == run)
+        dirty_[ty1++] &= ~run;
+      dirty_[ty] &= ~run;
+
+      const int y0 = ty * TILE > TOP ? ty * TILE : TOP;
+      const int y1 = ty1 * TILE < BOTTOM ? ty1 * TILE : BOTTOM;
+      out[n++] = {tx * TILE, y0, (end - tx) * TILE, y1 - y0};
+      tx = end;
+    }
+  }
+  return n;
+}
+
+// ===================== Compositing =====================
+void OverlayLayer::composite(uint16_t *band, const Rect &b) const
+{
+  for (int row = 0; row < b.h; row++)
+  {
+    const int y = b.y + row;
+    if (y < TOP || y >= BOTTOM)
+      continue;
+    const uint8_t *src = pixels_ + offset(0, y);
+    uint16_t *dst = band + row * b.w;
+    for (int x = b.x; x < b.x + b.w; x++)
+    {
+      const uint8_t pair = src[x >> 1];
+      if (!pair)
+        continue;
+      const uint8_t v = (x & 1) ? pair & 0x0F : pair >> 4;
+      if (v)
+        dst[x - b.x] = palette_[v];
+    }
+  }
+}
@@ -0,0 +1,60 @@
+#pragma once
+#include <stdint.h>
+#include "HB9IIU_DirtyRects.h"
+
+// ===================== Overlay layer =====================
+// A 4-bit layer over the map (labels, trails, range rings, markers) that the
+// renderer composites over the background, under the planes, when it draws a
+// region. Index 0 is transparent; 1..15 are looked up in the palette.
+// Drawing only marks the TILE x TILE tiles it touches; the core redraws them
+// on the next renderTracks(), so annotations cost RAM instead of SPI writes
+// of their own. It covers rows TOP..BOTTOM-1, between the legend and the
+// bottom bar, which its redraws leave alone.
+class OverlayLayer
+{
+public:
+  static const int TOP = LEGEND_H;
+  static const int BOTTOM = SH - BOTTOM_H;
+  static const int BYTES = SW * (BOTTOM - TOP) / 2; // two pixels per byte, left one in the high nibble
+  static const int TILE = 16;
+  static const int TILES_X = SW / TILE;
+  static const int TILES_Y = SH / TILE;
+  static const uint8_t CLEAR = 0;
+
+  // `pixels` holds BYTES bytes and is owned by the caller
+  explicit OverlayLayer(uint8_t *pixels);
+
+  // Colors of indices 1..15; a change redraws the whole layer
+  void setPalette(uint8_t index, uint16_t color);
+  uint16_t paletteColor(uint8_t index) const { return palette_[index & 0x0F]; }
+
+  uint8_t pixel(int x, int y) const;
+
+  // Clipped to the layer
+  void setPixel(int x, int y, uint8_t index);
+  void fillRect(int x, int y, int w, int h, uint8_t index);
+  void drawLine(int x0, int y0, int x1, int y1, uint8_t index);
+  void drawCircle(int cx, int cy, int r, uint8_t index);
+  void clear() { fillRect(0, TOP, SW, BOTTOM - TOP, CLEAR); }
+
+  // Marks every tile, e.g. after the background was redrawn
+  void invalidate();
+
+  // Moves up to `max` rects of dirty tiles into `out` (tile runs of a row,
+  // merged with the same run of the rows below, cut to the layer's rows)
+  // and returns their number.
+  // Tiles that don't fit stay dirty for the next call.
+  int takeDirtyRects(Rect out[], int max);
+
+  // Draws the layer over band `b` (b.w x b.h pixels on screen at b.x,b.y)
+  void composite(uint16_t *band, const Rect &b) const;
+
+private:
+  void markDirty(int x, int y, int w, int h);
+  static bool inside(int x, int y) { return x >= 0 && x < SW && y >= TOP && y < BOTTOM; }
+  static int offset(int x, int y) { return ((y - TOP) * SW + x) >> 1; }
+
+  uint8_t *pixels_;
+  uint16_t palette_[16];
+  uint32_t dirty_[TILES_Y]; // bit tx of row ty
+};
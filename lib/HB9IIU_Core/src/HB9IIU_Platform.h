@@ -0,0 +1,92 @@
+#pragma once
+#include <stdint.h>
+#include <HB9IIU_AircraftDecoder.h>
+
+// The four things the core needs from the board. The firmware implements
+// them on top of millis(), TFT_eSPI, WiFi/HTTPClient and Preferences
+// (src/HB9IIU_ArduinoPlatform.h); the host build has its own versions
+// (host/platform) so the core can be tested and profiled on a desktop.
+
+// ===================== Clock =====================
+class Clock
+{
+public:
+  virtual ~Clock() {}
+
+  // Milliseconds since an arbitrary origin; wraps like Arduino's millis()
+  virtual uint32_t millis() = 0;
+};
+
+// ===================== Display =====================
+// The subset of TFT_eSPI the renderer uses. Colors are RGB565.
+class Display
+{
+public:
+  virtual ~Display() {}
+
+  // Brackets a batch of drawing calls (keeps CS asserted on the panel)
+  virtual void startWrite() = 0;
+  virtual void endWrite() = 0;
+
+  virtual void pushImage(int32_t x, int32_t y, int32_t w, int32_t h, const uint16_t *data) = 0;
+  virtual void drawFastHLine(int32_t x, int32_t y, int32_t w, uint16_t color) = 0;
+  virtual void fillRect(int32_t x, int32_t y, int32_t w, int32_t h, uint16_t color) = 0;
+  virtual void drawRect(int32_t x, int32_t y, int32_t w, int32_t h, uint16_t color) = 0;
+
+  // Composited drawing: the renderer assembles up to BAND_PIXELS pixels in
+  // RAM and draws them with pushBand(). bandBuffer() lends a buffer for that
+  // (nullptr: the renderer uses its own); a buffer lent out may still be
+  // read after pushBand() returns, until it is lent again or endWrite().
+  // Bands are on screen, and pushBand() may byte swap them in place.
+  static const int BAND_PIXELS = 2048;
+  virtual uint16_t *bandBuffer() { return nullptr; }
+  virtual void pushBand(int32_t x, int32_t y, int32_t w, int32_t h, uint16_t *band)
+  {
+    pushImage(x, y, w, h, band);
+  }
+
+  // Default 6x8 font, top-left datum
+  virtual void drawString(const char *text, int32_t x, int32_t y, uint16_t fg, uint16_t bg) = 0;
+};
+
+// ===================== Network =====================
+// Receives the aircraft of one aircraft.json document
+class AircraftSink
+{
+public:
+  virtual ~AircraftSink() {}
+
+  virtual void onAircraft(const AircraftFields &a) = 0;
+};
+
+// One GET of aircraft.json, split like HTTPClient so the caller can time
+// the request and the decoding separately.
+class Network
+{
+public:
+  virtual ~Network() {}
+
+  virtual bool connected() = 0;
+
+  // Sends the request; returns the HTTP status code (or a negative error)
+  virtual int get() = 0;
+
+  // Decodes the body of a successful get() with decodeAircraftJson(). The
+  // sink sees each aircraft as it is parsed, so on an error it has already
+  // received the ones before it.
+  virtual DeserializationError decode(double &now, AircraftSink &sink) = 0;
+
+  // Releases the connection; called after every get()
+  virtual void end() = 0;
+};
+
+// ===================== Storage =====================
+// Small persistent settings (Preferences on the ESP32)
+class Storage
+{
+public:
+  virtual ~Storage() {}
+
+  virtual uint8_t getUChar(const char *key, uint8_t defaultValue) = 0;
+  virtual void putUChar(const char *key, uint8_t value) = 0;
+};
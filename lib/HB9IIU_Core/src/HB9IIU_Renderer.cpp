@@ -0,0 +1,172 @@
+#include "HB9IIU_Renderer.h"
+#include <string.h>
+
+int mapHeadingToSprite(int headingDeg)
+{
+  int h = headingDeg % 360;
+  if (h < 0)
+    h += 360;
+
+  if (SPRITE_CCW)
+    h = (360 - h) % 360;
+  h = (h + SPRITE_OFFSET_DEG) % 360;
+  if (SPRITE_FLIP_180)
+    h = (h + 180) % 360;
+  return h;
+}
+
+// ===================== Background =====================
+void Renderer::restoreBackground(int x, int y, int w, int h)
+{
+  if (x < 0)
+  {
+    w += x;
+    x = 0;
+  }
+  if (y < 0)
+  {
+    h += y;
+    y = 0;
+  }
+  if (x + w > SW)
+    w = SW - x;
+  if (y + h > SH)
+    h = SH - y;
+  if (w <= 0 || h <= 0)
+    return;
+
+  drawRegion({x, y, w, h}, nullptr, nullptr, 0);
+}
+
+// ===================== Bands =====================
+// r is on screen. Each band of rows is assembled in RAM, background first,
+// then the overlay and the planes over it in draw order, and pushed once.
+void Renderer::drawRegion(const Rect &r, const TrackStore *tracks, const int drawIdx[], int nDraw)
+{
+  const int rows = Display::BAND_PIXELS / r.w;
+  for (int y = r.y; y < r.y + r.h; y += rows)
+  {
+    const Rect b = {r.x, y, r.w, r.y + r.h - y < rows ? r.y + r.h - y : rows};
+    uint16_t *band = display_.bandBuffer();
+    if (!band)
+      band = bandBuf_;
+
+    for (int row = 0; row < b.h; row++)
+    {
+      const uint16_t *src = assets_.background + ((y + row) * SW + r.x);
+      memcpy(band + row * b.w, src, b.w * sizeof(uint16_t));
+    }
+    if (overlay_)
+      overlay_->composite(band, b);
+
+    for (int k = 0; k < nDraw; k++)
+    {
+      const Track &t = (*tracks)[drawIdx[k]];
+      if (rectIntersects(b, trackRectCurrent(t)))
+        compositePlane(band, b, t);
+    }
+
+    display_.pushBand(b.x, b.y, b.w, b.h, band);
+  }
+}
+
+// The part of the plane mask that falls in band b
+void Renderer::compositePlane(uint16_t *band, const Rect &b, const Track &t)
+{
+  const Rect cr = trackRectCurrent(t);
+  const uint8_t *mask = assets_.planeMasks + assets_.planeOffsets[mapHeadingToSprite(t.headingDeg)];
+
+  const int x0 = b.x > cr.x ? b.x - cr.x : 0;
+  const int y0 = b.y > cr.y ? b.y - cr.y : 0;
+  const int x1 = b.x + b.w < cr.x + PW ? b.x + b.w - cr.x : PW;
+  const int y1 = b.y + b.h < cr.y + PH ? b.y + b.h - cr.y : PH;
+
+  for (int y = y0; y < y1; y++)
+  {
+    const uint8_t *m = mask + y * assets_.planeStride;
+    uint16_t *dst = band + (cr.y + y - b.y) * b.w + (cr.x - b.x);
+    for (int x = x0; x < x1; x++)
+    {
+      if (m[x >> 3] & (0x80 >> (x & 7)))
+        dst[x] = t.color;
+    }
+  }
+}
+
+// ===================== Plane draw =====================
+void Renderer::eraseTrackIfDrawn(Track &t)
+{
+  if (!t.drawn)
+    return;
+  restoreBackground(t.oldDrawX, t.oldDrawY, PW, PH);
+  t.drawn = false;
+}
+
+// ===================== Dirty regions =====================
+void Renderer::markPlanesIntersecting(TrackStore &tracks, const Rect &r, const int drawIdx[], int nDraw)
+{
+  for (int k = 0; k < nDraw; k++)
+  {
+    Track &t = tracks[drawIdx[k]];
+    Rect cr = trackRectCurrent(t);
+    if (!rectIntersects(r, cr))
+      continue;
+
+    t.oldDrawX = cr.x;
+    t.oldDrawY = cr.y;
+    t.drawn = true;
+  }
+}
+
+void Renderer::drawDirtyRegions(TrackStore &tracks, const Rect dirty[], int nDirty,
+                                const int drawIdx[], int nDraw)
+{
+  // Each drawn plane lies inside one of the regions, so compositing them gives
+  // the frame that restoring them and drawing the planes over them did
+  for (int i = 0; i < nDirty; i++)
+  {
+    if (dirty[i].w <= 0 || dirty[i].h <= 0)
+      continue;
+    drawRegion(dirty[i], &tracks, drawIdx, nDraw);
+    markPlanesIntersecting(tracks, dirty[i], drawIdx, nDraw);
+  }
+}
+
+// ===================== Legend bar =====================
+void Renderer::drawLegendBar()
+{
+  // Background strip
+  display_.fillRect(0, 0, SW, LEGEND_H, RGB565_BLACK);
+
+  // Swatch size
+  const int sw = 10;
+  const int sh = 10;
+
+  // Compute "centered" Y positions with optional offsets
+  const int yText = (LEGEND_H - 8) / 2 + LEGEND_TEXT_Y_OFFSET; // ~8px font height
+  const int ySwatch = (LEGEND_H - sh) / 2 + LEGEND_SWATCH_Y_OFFSET;
+
+  int x = LEGEND_LEFT_MARGIN;
+
+  display_.drawString("ALT m:", x, yText, RGB565_WHITE, RGB565_BLACK);
+  x += 46; // spacing after "ALT m:"
+
+  // Draw one legend item: swatch + label
+  auto item = [&](uint16_t col, const char *label)
+  {
+    display_.fillRect(x, ySwatch, sw, sh, col);
+    display_.drawRect(x, ySwatch, sw, sh, RGB565_WHITE);
+    x += sw + 3;
+
+    display_.drawString(label, x, yText, RGB565_WHITE, RGB565_BLACK);
+
+    // crude width estimate for default font: ~6 px per char
+    x += (int)strlen(label) * 6 + 10;
+  };
+
+  item(ALT_COLOR_L1, "0-1000");
+  item(ALT_COLOR_L2, "1000-5000");
+  item(ALT_COLOR_L3, "5000-9000");
+  item(ALT_COLOR_L4, "9000+");
+  item(ALT_COLOR_UNKNOWN, "UNKNOWN");
+}
@@ -0,0 +1,50 @@
+#pragma once
+#include <stdint.h>
+#include "HB9IIU_DirtyRects.h"
+#include "HB9IIU_Overlay.h"
+#include "HB9IIU_Platform.h"
+
+// Images the renderer copies from. On the ESP32 they live in flash
+// (PROGMEM), which is memory mapped, so they are read like normal arrays.
+struct RenderAssets
+{
+  const uint16_t *background;   // SW x SH, RGB565 (bg565)
+  const uint8_t *planeMasks;    // 1-bit masks, PW x PH each (plane32_masks)
+  const uint16_t *planeOffsets; // offset of the mask of each heading (plane32_offset)
+  int planeStride;              // bytes per mask row (plane32_stride)
+};
+
+// Sprite heading for an ADS-B track, with the SPRITE_* mapping applied
+int mapHeadingToSprite(int headingDeg);
+
+class Renderer
+{
+public:
+  Renderer(Display &display, const RenderAssets &assets)
+      : display_(display), assets_(assets), overlay_(nullptr) {}
+
+  // Composited over the background of every region (nullptr: none)
+  void setOverlay(const OverlayLayer *overlay) { overlay_ = overlay; }
+
+  // General restore for any width up to SW (used for dirty regions)
+  void restoreBackground(int x, int y, int w, int h);
+
+  void eraseTrackIfDrawn(Track &t);
+
+  // For each dirty region: the background and the planes that intersect it,
+  // composited in bands so each pixel is sent once
+  void drawDirtyRegions(TrackStore &tracks, const Rect dirty[], int nDirty,
+                        const int drawIdx[], int nDraw);
+
+  void drawLegendBar();
+
+private:
+  void drawRegion(const Rect &r, const TrackStore *tracks, const int drawIdx[], int nDraw);
+  void compositePlane(uint16_t *band, const Rect &b, const Track &t);
+  void markPlanesIntersecting(TrackStore &tracks, const Rect &r, const int drawIdx[], int nDraw);
+
+  Display &display_;
+  RenderAssets assets_;
+  const OverlayLayer *overlay_;
+  uint16_t bandBuf_[Display::BAND_PIXELS]; // when the display lends none
+};
@@ -0,0 +1,158 @@
+#include "HB9IIU_StatusBar.h"
+#include <stdio.h>
+#include <string.h>
+
+void formatBottomBar(char *line, size_t cap, const TrackStore &tracks,
+                     const int drawIdx[], int nDraw, const FetchStats &counts)
+{
+  // Compute NEAR / FAR over the planes we are actually drawing
+  const MapView &view = tracks.view();
+  double nearKm = 1e9;
+  double farKm = 0.0;
+  int nearSlot = -1;
+
+  int maxAltM = -1;
+
+  for (int k = 0; k < nDraw; k++)
+  {
+    const Track &t = tracks[drawIdx[k]];
+    double dkm = haversine_km(view.homeLat, view.homeLon, t.lat, t.lon);
+
+    if (dkm < nearKm)
+    {
+      nearKm = dkm;
+      nearSlot = drawIdx[k];
+    }
+    if (dkm > farKm)
+      farKm = dkm;
+
+    // max altitude among drawn planes
+    if (t.altitude_m >= 0 && t.altitude_m > maxAltM)
+      maxAltM = t.altitude_m;
+  }
+
+  if (nDraw <= 0)
+  {
+    snprintf(line, cap,
+             "Tot %d  Pos %d  Drw 0 | NEAR --- --.-km | FAR --.-km | MAX ALT ---",
+             counts.totalRaw, counts.withPos);
+  }
+  else
+  {
+    const Track &tn = tracks[nearSlot];
+    const char *nearName = trackLabel(tn);
+
+    if (maxAltM >= 0)
+    {
+      snprintf(line, cap,
+               "Tot %d  Pos %d  Drw %d | NEAR %s %.1fkm | FAR %.1fkm | MAX ALT %dm",
+               counts.totalShown, counts.withPos, nDraw,
+               nearName, nearKm, farKm, maxAltM);
+    }
+    else
+    {
+      snprintf(line, cap,
+               "Tot %d  Pos %d  Drw %d | NEAR %s %.1fkm | FAR %.1fkm | MAX ALT ---",
+               counts.totalShown, counts.withPos, nDraw,
+               nearName, nearKm, farKm);
+    }
+  }
+}
+
+// ===================== Bottom bar =====================
+// Top row of the text in the bar; glyphs are at most 8 rows
+static const int TEXT_Y = (BOTTOM_H - 8) / 2 + BOTTOM_TEXT_Y_OFFSET;
+
+// `text` into next_, white pixels set
+void StatusBar::render(const char *text)
+{
+  memset(next_, 0, sizeof(next_));
+
+  int x = BOTTOM_LEFT_MARGIN;
+  for (; *text && x < SW; text++)
+  {
+    const char c = *text;
+    const int x0 = x + fontInkOffset(*font_, c);
+    for (int i = 0; i < font_->width; i++)
+    {
+      const uint8_t col = fontColumn(*font_, c, i);
+      const int px = x0 + i;
+      if (!col || px < 0 || px >= SW)
+        continue;
+      for (int j = 0; j < font_->height; j++)
+      {
+        const int py = TEXT_Y + j;
+        if ((col >> j & 1) && py >= 0 && py < BOTTOM_H)
+          next_[py][px >> 3] |= 0x80 >> (px & 7);
+      }
+    }
+    x += fontAdvance(*font_, c);
+  }
+}
+
+// Columns x..x+w-1 of next_ rows y0..y1-1, in bands of as many rows as fit
+void StatusBar::pushColumns(int x, int w, int y0, int y1)
+{
+  for (int row = y0; row < y1;)
+  {
+    uint16_t *band = display_.bandBuffer();
+    int rows = 1;
+    if (band)
+      rows = Display::BAND_PIXELS / w;
+    else
+      band = line_;
+    if (rows > y1 - row)
+      rows = y1 - row;
+
+    for (int r = 0; r < rows; r++)
+    {
+      const uint8_t *bits = next_[row + r];
+      uint16_t *dst = band + r * w;
+      for (int i = 0; i < w; i++)
+        dst[i] = (bits[(x + i) >> 3] & (0x80 >> ((x + i) & 7))) ? RGB565_WHITE : RGB565_BLACK;
+    }
+    display_.pushBand(x, SH - BOTTOM_H + row, w, rows, band);
+    row += rows;
+  }
+}
+
+void StatusBar::drawTextDiff(const char *text)
+{
+  render(text);
+
+  // First time: the whole bar
+  if (!hasPrev_)
+  {
+    pushColumns(0, SW, 0, BOTTOM_H);
+    memcpy(shown_, next_, sizeof(shown_));
+    hasPrev_ = true;
+    return;
+  }
+
+  // Only the rows of the text can differ
+  const int y0 = TEXT_Y > 0 ? TEXT_Y : 0;
+  const int y1 = TEXT_Y + 8 < BOTTOM_H ? TEXT_Y + 8 : BOTTOM_H;
+
+  // Runs of blocks that differ from the screen
+  const int bytes = BLOCK / 8;
+  const int nBlocks = SW / BLOCK;
+  int run = -1; // first block of the current run
+  for (int b = 0; b <= nBlocks; b++)
+  {
+    bool changed = false;
+    for (int y = y0; b < nBlocks && y < y1 && !changed; y++)
+      changed = memcmp(&next_[y][b * bytes], &shown_[y][b * bytes], bytes) != 0;
+
+    if (changed && run < 0)
+    {
+      run = b;
+    }
+    else if (!changed && run >= 0)
+    {
+      pushColumns(run * BLOCK, (b - run) * BLOCK, y0, y1);
+      run = -1;
+    }
+  }
+
+  memcpy(shown_, next_, sizeof(shown_));
+}
@@ -0,0 +1,41 @@
+#pragma once
+#include <stddef.h>
+#include "HB9IIU_Font.h"
+#include "HB9IIU_Platform.h"
+#include "HB9IIU_TrackStore.h"
+
+// ===================== Bottom status bar =====================
+// Writes the bottom bar line: counters of the last fetch, then the NEAR/FAR
+// distances and the highest altitude among the planes being drawn
+void formatBottomBar(char *line, size_t cap, const TrackStore &tracks,
+                     const int drawIdx[], int nDraw, const FetchStats &counts);
+
+// The bar is rendered into a 1-bit bitmap and compared with the one on
+// screen in blocks of BLOCK columns; only the blocks that changed are sent,
+// as bands, so text doesn't interrupt a display list.
+class StatusBar
+{
+public:
+  static const int BLOCK = 8;       // columns compared and pushed together
+  static const int STRIDE = SW / 8; // bytes per bitmap row
+
+  explicit StatusBar(Display &display) : display_(display), font_(&GLCD_FONT), hasPrev_(false) {}
+
+  // GLCD_FONT by default (6 pixels per character); used from the next draw
+  void setFont(const BitmapFont &font) { font_ = &font; }
+
+  // Draws `text` in the bar; after the first call, only the column blocks
+  // whose pixels differ from the bar on screen are redrawn
+  void drawTextDiff(const char *text);
+
+private:
+  void render(const char *text);
+  void pushColumns(int x, int w, int y0, int y1);
+
+  Display &display_;
+  const BitmapFont *font_;
+  uint8_t next_[BOTTOM_H][STRIDE];  // the text being drawn
+  uint8_t shown_[BOTTOM_H][STRIDE]; // the bar on screen
+  bool hasPrev_;
+  uint16_t line_[SW]; // one row, when the display lends no band
+};
@@ -0,0 +1,82 @@
+#include "HB9IIU_Touch.h"
+
+uint16_t touchMedian(uint16_t v[], int n)
+{
+  // insertion sort: n is a handful of samples
+  for (int i = 1; i < n; i++)
+  {
+    const uint16_t s = v[i];
+    int j = i;
+    while (j > 0 && v[j - 1] > s)
+    {
+      v[j] = v[j - 1];
+      j--;
+    }
+    v[j] = s;
+  }
+  return v[n / 2];
+}
+
+static TouchEvent makeEvent(TouchEvent::Type type, int x, int y, int dx, int dy)
+{
+  TouchEvent e;
+  e.type = type;
+  e.x = (int16_t)x;
+  e.y = (int16_t)y;
+  e.dx = (int16_t)dx;
+  e.dy = (int16_t)dy;
+  return e;
+}
+
+bool TouchGestures::down(uint32_t ms, int x, int y, TouchEvent &e)
+{
+  if (!pressed_)
+  {
+    pressed_ = true;
+    dragging_ = false;
+    held_ = false;
+    nextHoldMs_ = ms + LONG_PRESS_MS;
+    x0_ = lastX_ = x;
+    y0_ = lastY_ = y;
+    return false;
+  }
+
+  if (!dragging_)
+  {
+    const int dx = x - x0_, dy = y - y0_;
+    if (dx * dx + dy * dy > DRAG_SLOP * DRAG_SLOP)
+      dragging_ = true; // from here on no LongPress / Tap
+  }
+
+  if (dragging_)
+  {
+    if (x == lastX_ && y == lastY_)
+      return false;
+    e = makeEvent(TouchEvent::Drag, x, y, x - lastX_, y - lastY_);
+    lastX_ = x;
+    lastY_ = y;
+    return true;
+  }
+
+  if ((int32_t)(ms - nextHoldMs_) >= 0)
+  {
+    nextHoldMs_ = ms + REPEAT_MS;
+    held_ = true;
+    e = makeEvent(TouchEvent::LongPress, x, y, 0, 0);
+    return true;
+  }
+  return false;
+}
+
+bool TouchGestures::up(TouchEvent &e)
+{
+  if (!pressed_)
+    return false;
+  pressed_ = false;
+
+  // A tap is neither dragged nor long pressed
+  if (dragging_ || held_)
+    return false;
+  e = makeEvent(TouchEvent::Tap, x0_, y0_, 0, 0);
+  return true;
+}
@@ -0,0 +1,50 @@
+#pragma once
+#include <stdint.h>
+
+// ===================== Touch gestures =====================
+struct TouchEvent
+{
+  enum Type : uint8_t
+  {
+    Tap,       // lifted before LONG_PRESS_MS without moving
+    LongPress, // held still for LONG_PRESS_MS, then again every REPEAT_MS
+    Drag,      // moved more than DRAG_SLOP; one per sample that moves
+  };
+
+  Type type;
+  int16_t x, y;   // screen position (for Tap, where the finger went down)
+  int16_t dx, dy; // Drag: movement since the last event
+};
+
+// Median of n samples; reorders v. Used per axis to drop the outliers of
+// a resistive panel (the first reads after the finger lands, noise spikes).
+uint16_t touchMedian(uint16_t v[], int n);
+
+// Turns the filtered samples of one finger into TouchEvents
+class TouchGestures
+{
+public:
+  static const uint32_t LONG_PRESS_MS = 500;
+  static const uint32_t REPEAT_MS = 180;
+  static const int DRAG_SLOP = 12; // px
+
+  TouchGestures()
+      : pressed_(false), dragging_(false), held_(false), nextHoldMs_(0),
+        x0_(0), y0_(0), lastX_(0), lastY_(0) {}
+
+  // A sample while the finger is down; true if it produced `e`
+  bool down(uint32_t ms, int x, int y, TouchEvent &e);
+
+  // The finger was lifted; true if that produced `e`
+  bool up(TouchEvent &e);
+
+  bool pressed() const { return pressed_; }
+
+private:
+  bool pressed_;
+  bool dragging_;
+  bool held_;           // a LongPress was sent
+  uint32_t nextHoldMs_; // next LongPress while held still
+  int x0_, y0_;         // where the finger went down
+  int lastX_, lastY_;   // last Drag position
+};
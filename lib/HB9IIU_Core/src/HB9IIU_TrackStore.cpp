@@ -0,0 +1,195 @@
+#include "HB9IIU_TrackStore.h"
+#include <string.h>
+
+uint16_t colorFromAltitudeM(int alt_m)
+{
+  if (alt_m < 0)
+    return ALT_COLOR_UNKNOWN;
+  if (alt_m < ALT_L1_M)
+    return ALT_COLOR_L1;
+  if (alt_m < ALT_L2_M)
+    return ALT_COLOR_L2;
+  if (alt_m < ALT_L3_M)
+    return ALT_COLOR_L3;
+  return ALT_COLOR_L4;
+}
+
+void trimFlightInto(char *dst, size_t cap, const char *flight)
+{
+  while (*flight == ' ')
+    flight++;
+  size_t n = strlen(flight);
+  while (n > 0 && flight[n - 1] == ' ')
+    n--;
+  if (n >= cap)
+    n = cap - 1;
+  memcpy(dst, flight, n);
+  dst[n] = 0;
+}
+
+const char *trackLabel(const Track &t)
+{
+  return (t.flight[0] != 0) ? t.flight : t.hex;
+}
+
+int TrackStore::findTrackByHex(const char *hex) const
+{
+  for (int i = 0; i < MAX_TRACKS; i++)
+  {
+    if (tracks_[i].used && strncmp(tracks_[i].hex, hex, 6) == 0)
+      return i;
+  }
+  return -1;
+}
+
+int TrackStore::allocTrackSlot() const
+{
+  for (int i = 0; i < MAX_TRACKS; i++)
+  {
+    if (!tracks_[i].used)
+      return i;
+  }
+  uint32_t oldest = 0xFFFFFFFF;
+  int idx = 0;
+  for (int i = 0; i < MAX_TRACKS; i++)
+  {
+    if (tracks_[i].lastUpdateMs < oldest)
+    {
+      oldest = tracks_[i].lastUpdateMs;
+      idx = i;
+    }
+  }
+  return idx;
+}
+
+bool TrackStore::accept(const AircraftFields &a, FetchStats &st, TrackFix &fix) const
+{
+  st.totalRaw++;
+
+  if (!(a.present & AF_HEX) || !a.hex[0])
+    return false;
+
+  const int32_t seen = (a.present & AF_SEEN) ? a.seen_d10 : INT32_MAX;
+  if (seen <= MAX_SEEN_D10)
+    st.totalShown++;
+
+  if ((a.present & (AF_LAT | AF_LON)) != (AF_LAT | AF_LON))
+    return false;
+  st.withPos++;
+
+  const int32_t seen_pos = (a.present & AF_SEEN_POS) ? a.seen_pos_d10 : INT32_MAX;
+  if (seen_pos > MAX_SEEN_POS_D10)
+    return false;
+
+  st.fresh++;
+
+  // Geometry below still works in degrees
+  fix.lat = a.lat_e6 * 1e-6;
+  fix.lon = a.lon_e6 * 1e-6;
+
+  const double dkm = haversine_km(view_.homeLat, view_.homeLon, fix.lat, fix.lon);
+  if (dkm > RANGE_KM)
+    return false;
+  st.within++;
+
+  return latlon_to_screen_xy(view_, fix.lat, fix.lon, fix.sx, fix.sy);
+}
+
+void TrackStore::assign(int idx, const AircraftFields &a, const TrackFix &fix, uint32_t nowMs)
+{
+  Track &t = tracks_[idx];
+
+  t.used = true;
+  memcpy(t.hex, a.hex, sizeof(t.hex)); // a.hex is null-terminated
+  t.hex[6] = 0;
+
+  if (a.present & AF_FLIGHT)
+    trimFlightInto(t.flight, sizeof(t.flight), a.flight);
+  else
+    t.flight[0] = 0;
+
+  t.lat = fix.lat;
+  t.lon = fix.lon;
+
+  t.cx = fix.sx;
+  t.cy = fix.sy;
+
+  // track heading (degrees)
+  int32_t trk = (a.present & AF_TRACK) ? a.track_d10 : 0;
+  int hdg = (int)(trk >= 0 ? (trk + 5) / 10 : (trk - 5) / 10); // round half away, like lround()
+  hdg %= 360;
+  if (hdg < 0)
+    hdg += 360;
+  t.headingDeg = hdg;
+
+  // --- barometric altitude (feet) ---
+  if (a.present & AF_ALT_BARO)
+    t.altitude_m = (int)(a.alt_baro >= 0 ? (a.alt_baro * 3048 + 5000) / 10000
+                                         : (a.alt_baro * 3048 - 5000) / 10000); // ft -> m, rounded
+  else
+    t.altitude_m = -1;
+
+  t.color = colorFromAltitudeM(t.altitude_m);
+
+  t.lastUpdateMs = nowMs;
+}
+
+int TrackStore::buildDrawList(uint32_t nowMs, int outIdx[], int maxOut) const
+{
+  int count = 0;
+
+  // Step 1: collect all drawable tracks
+  for (int i = 0; i < MAX_TRACKS && count < maxOut; i++)
+  {
+    if (!tracks_[i].used)
+      continue;
+
+    // must be fresh enough
+    if ((nowMs - tracks_[i].lastUpdateMs) >
+        (uint32_t)(MAX_SEEN_POS_S * 1000.0))
+      continue;
+
+    // must be on screen (using sprite top-left)
+    int x0 = tracks_[i].cx - PW / 2;
+    int y0 = tracks_[i].cy - PH / 2;
+
+    // skip anything that would enter the legend bar
+    if (y0 < LEGEND_H)
+      continue;
+    // skip anything that would enter the bottom bar
+    if (y0 + PH > (SH - BOTTOM_H))
+      continue;
+
+    if (x0 < -PW || x0 > SW)
+      continue;
+    if (y0 < -PH || y0 > SH)
+      continue;
+
+    outIdx[count++] = i;
+  }
+
+  // Step 2: sort by altitude (ascending → highest drawn last)
+  for (int i = 0; i < count - 1; i++)
+  {
+    for (int j = i + 1; j < count; j++)
+    {
+      int ai = tracks_[outIdx[i]].altitude_m;
+      int aj = tracks_[outIdx[j]].altitude_m;
+
+      // unknown altitude goes first
+      if (ai < 0)
+        ai = -1000000;
+      if (aj < 0)
+        aj = -1000000;
+
+      if (ai > aj)
+      {
+        int tmp = outIdx[i];
+        outIdx[i] = outIdx[j];
+        outIdx[j] = tmp;
+      }
+    }
+  }
+
+  return count;
+}
@@ -0,0 +1,101 @@
+#pragma once
+#include <stdint.h>
+#include <HB9IIU_AircraftDecoder.h>
+#include "HB9IIU_CoreConfig.h"
+#include "HB9IIU_Geo.h"
+
+// ===================== Track table =====================
+struct Track
+{
+  bool used = false;
+
+  char hex[7] = {0};    // 6 hex chars + null
+  char flight[9] = {0}; // up to 8 + null
+
+  double lat = 0;
+  double lon = 0;
+
+  int cx = 0, cy = 0; // center screen position
+  int oldDrawX = 0, oldDrawY = 0;
+
+  int headingDeg = 0; // 0..359 from ADS-B track
+
+  int altitude_m = -1; // barometric altitude (meters), -1 = unknown
+
+  uint16_t color = RGB565_WHITE;
+
+  uint32_t lastUpdateMs = 0; // Clock::millis() when updated
+  bool drawn = false;
+};
+
+// Per-fetch counters (printed with DEBUG_FETCH, some feed the bottom bar)
+struct FetchStats
+{
+  int totalRaw = 0;
+  int totalShown = 0; // PiAware/PlaneFinder-like
+  int withPos = 0;
+  int fresh = 0;
+  int within = 0;
+  int updated = 0;
+};
+
+// Position of an aircraft that passed TrackStore::accept()
+struct TrackFix
+{
+  double lat;
+  double lon;
+  int sx; // sprite center on screen
+  int sy;
+};
+
+uint16_t colorFromAltitudeM(int alt_m);
+
+// Copies `flight` without leading/trailing blanks (callsigns are space padded)
+void trimFlightInto(char *dst, size_t cap, const char *flight);
+
+// Prefer callsign, else fall back to hex
+const char *trackLabel(const Track &t);
+
+class TrackStore
+{
+public:
+  explicit TrackStore(const MapView &view) : view_(view) {}
+
+  const MapView &view() const { return view_; }
+
+  Track &operator[](int i) { return tracks_[i]; }
+  const Track &operator[](int i) const { return tracks_[i]; }
+
+  int findTrackByHex(const char *hex) const;
+
+  // A free slot, else the least recently updated one
+  int allocTrackSlot() const;
+
+  // Counts one decoded aircraft in `st` and checks it is fresh, in range and
+  // near the screen. Only then may it update a track.
+  bool accept(const AircraftFields &a, FetchStats &st, TrackFix &fix) const;
+
+  // The slot of `hex`, or the one to recycle for it
+  int slotFor(const char *hex) const
+  {
+    const int idx = findTrackByHex(hex);
+    return idx >= 0 ? idx : allocTrackSlot();
+  }
+
+  // Stores an accepted aircraft in slot `idx`. The caller erases the sprite
+  // of the previous owner first if the slot is being recycled.
+  void assign(int idx, const AircraftFields &a, const TrackFix &fix, uint32_t nowMs);
+
+  bool isExpired(int idx, uint32_t nowMs) const
+  {
+    return (nowMs - tracks_[idx].lastUpdateMs) > TRACK_TTL_MS;
+  }
+
+  // Picks up to maxOut fresh tracks that fit between the legend and the
+  // bottom bar, sorted by altitude (highest drawn last)
+  int buildDrawList(uint32_t nowMs, int outIdx[], int maxOut) const;
+
+private:
+  MapView view_;
+  Track tracks_[MAX_TRACKS];
+};
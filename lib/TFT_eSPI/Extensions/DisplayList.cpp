@@ -0,0 +1,379 @@
+// Display lists: the address windows and pixels of a frame are recorded into a
+// buffer and sent a block at a time, as chained DMA transactions on ESP32 SPI.
+
+// See license in root directory.
+
+#if defined (TFT_DL_DMA)
+  // Transactions in flight, reused in turn: at most TFT_DMA_QUEUE are queued
+  static spi_transaction_t dl_trans[TFT_DMA_QUEUE];
+  static tft_dl_job_t dl_jobs[TFT_DMA_QUEUE]; // dlImage() completions, run by dl_job_callback()
+  static uint32_t dl_next = 0;
+#endif
+
+/***************************************************************************************
+** Function name:           dlBegin
+** Description:             start recording into buffer, false if not supported
+***************************************************************************************/
+bool TFT_eSPI::dlBegin(void *buffer, uint32_t bytes)
+{
+#if defined (ILI9225_DRIVER) || defined (SSD1351_DRIVER) || defined (SSD1963_DRIVER) || \
+    defined (ARDUINO_ARCH_RP2040) || defined (ARDUINO_ARCH_MBED)
+  // These interfaces address the window differently, draw directly
+  (void)buffer;
+  (void)bytes;
+  return false;
+#else
+  uint8_t *start = (uint8_t *)(((uintptr_t)buffer + 3) & ~(uintptr_t)3);
+  if (!buffer || bytes < (uint32_t)(start - (uint8_t *)buffer) + 512) return false;
+
+  DMA_BUSY_CHECK; // The last list may still be streaming out of this buffer
+
+  dl_buf  = start;
+  dl_half = ((bytes - (start - (uint8_t *)buffer)) / 2) & ~3;
+  dl_cur  = 0;
+  dl_queued[0] = dl_queued[1] = 0;
+  #if defined (TFT_DL_DMA)
+    dl_dma = DMA_Enabled;
+  #else
+    dl_dma = false;
+  #endif
+  dlClear();
+  return true;
+#endif
+}
+
+/***************************************************************************************
+** Function name:           dlWindow
+** Description:             record a setWindow()
+***************************************************************************************/
+void TFT_eSPI::dlWindow(int32_t x0, int32_t y0, int32_t x1, int32_t y1)
+{
+#ifdef CGRAM_OFFSET
+  x0+=colstart;
+  x1+=colstart;
+  y0+=rowstart;
+  y1+=rowstart;
+#endif
+
+#if defined (MULTI_TFT_SUPPORT) || defined (GC9A01_DRIVER)
+  win_xs = win_ys = -1; // Always send the address, as setWindow() does
+#endif
+
+  uint8_t cmds = DL_RAMWR;
+  if (x0 != win_xs || x1 != win_xe) { cmds |= DL_CASET; win_sent += 5; }
+  else win_saved += 5;
+  if (y0 != win_ys || y1 != win_ye) { cmds |= DL_PASET; win_sent += 5; }
+  else win_saved += 5;
+
+  dlAddress(cmds, x0, x1, y0, y1);
+
+  // A one pixel wide or high window is also drawPixel()'s cached address
+  if (x0 == x1) addr_col = x0;
+  if (y0 == y1) addr_row = y0;
+}
+
+/***************************************************************************************
+** Function name:           dlPixels
+** Description:             record pixels for the window, copied into the buffer
+***************************************************************************************/
+void TFT_eSPI::dlPixels(const uint16_t *data, uint32_t len)
+{
+  while (len) {
+    dl_op_t *op = dlOp(len);
+    uint16_t *dst = op->data;
+    // DMA sends the buffer as it is, so keep the bytes in wire order (as pushPixelsDMA())
+    bool swap = dl_dma ? _swapBytes : !_swapBytes;
+    if (swap) {
+      for (uint32_t i = 0; i < op->len; i++) dst[i] = data[i] << 8 | data[i] >> 8;
+    }
+    else memcpy(dst, data, op->len * 2);
+    data += op->len;
+    len  -= op->len;
+  }
+}
+
+/***************************************************************************************
+** Function name:           dlFill
+** Description:             record len pixels of one colour for the window
+***************************************************************************************/
+void TFT_eSPI::dlFill(uint32_t color, uint32_t len)
+{
+  uint16_t c = dl_dma ? (uint16_t)(color << 8 | (color & 0xFFFF) >> 8) : (uint16_t)color;
+  while (len) {
+    dl_op_t *op = dlOp(len);
+    for (uint32_t i = 0; i < op->len; i++) op->data[i] = c;
+    len -= op->len;
+  }
+}
+
+/***************************************************************************************
+** Function name:           dlImage
+** Description:             send pixels in place, done(ctx) is called when they are sent
+***************************************************************************************/
+void TFT_eSPI::dlImage(uint16_t *data, uint32_t len, tft_dl_done_t done, void *ctx)
+{
+  if (!len) {
+    if (done) done(ctx);
+    return;
+  }
+
+  // DMA sends the pixels as they are, the polled writes swap them as pushPixels()
+  if (dl_dma && _swapBytes) {
+    for (uint32_t i = 0; i < len; i++) data[i] = data[i] << 8 | data[i] >> 8;
+  }
+
+  dl_op_t *op = dlOp(0);
+  op->data = data;
+  op->len  = len;
+  op->cmds = DL_IMAGE;
+  op->job.done = done;
+  op->job.ctx  = ctx;
+  dlSend();
+}
+
+/***************************************************************************************
+** Function name:           dlSpans
+** Description:             record a drawSpans()
+***************************************************************************************/
+void TFT_eSPI::dlSpans(tft_span_t *spans, uint32_t n, uint32_t color)
+{
+  if (_vpOoB || !n) return;
+
+  // Sort by row, then column (as drawSpans())
+  for (uint32_t i = 1; i < n; i++) {
+    tft_span_t s = spans[i];
+    uint32_t j = i;
+    while (j > 0 && (spans[j - 1].y > s.y || (spans[j - 1].y == s.y && spans[j - 1].x > s.x))) {
+      spans[j] = spans[j - 1];
+      j--;
+    }
+    spans[j] = s;
+  }
+
+  int32_t lastY = -2;
+  for (uint32_t i = 0; i < n; i++) {
+    int32_t x = spans[i].x + _xDatum;
+    int32_t y = spans[i].y + _yDatum;
+    int32_t w = spans[i].w;
+
+    // Clipping, as drawFastHLine()
+    if ((y < _vpY) || (x >= _vpW) || (y >= _vpH)) continue;
+    if (x < _vpX) { w += x - _vpX; x = _vpX; }
+    if ((x + w) > _vpW) w = _vpW - x;
+    if (w < 1) continue;
+
+    // The page ends on the last row, so the next row with the same columns needs no command
+    int32_t cx0 = x, cx1 = x + w - 1, cy0 = y, cy1 = _height - 1;
+    #ifdef CGRAM_OFFSET
+      cx0 += colstart; cx1 += colstart;
+      cy0 += rowstart; cy1 += rowstart;
+    #endif
+    bool sameCols = (cx0 == win_xs) && (cx1 == win_xe);
+
+    if (!sameCols || y != lastY + 1) {
+      uint8_t cmds = DL_RAMWR;
+      if (!sameCols) cmds |= DL_CASET;
+      if (cy0 != win_ys || cy1 != win_ye) cmds |= DL_PASET;
+      dlAddress(cmds, cx0, cx1, cy0, cy1);
+    }
+
+    dlFill(color, w);
+    lastY = y;
+  }
+}
+
+/***************************************************************************************
+** Function name:           dlEnd
+** Description:             send what is left and stop recording
+***************************************************************************************/
+void TFT_eSPI::dlEnd(void)
+{
+  if (!dl_buf) return;
+  if (dl_nops) dlSend();
+  dl_buf = nullptr;
+}
+
+/***************************************************************************************
+** Function name:           dlOp
+** Description:             add an op with up to "pixels" pixels, sending the block if full
+***************************************************************************************/
+TFT_eSPI::dl_op_t* TFT_eSPI::dlOp(uint32_t pixels)
+{
+  // Pixels that fit once the op is added, kept even so runs stay 4 byte aligned for DMA
+  int32_t room = (((uint8_t *)dl_pix - (uint8_t *)(dl_ops + dl_nops + 1)) / 2) & ~1;
+  if (room < 0 || (room < (int32_t)pixels && room < 32)) {
+    dlSend();
+    room = (((uint8_t *)dl_pix - (uint8_t *)(dl_ops + 1)) / 2) & ~1;
+  }
+  if (pixels > (uint32_t)room) pixels = room; // The caller records the rest in another op
+
+  dl_op_t *op = &dl_ops[dl_nops++];
+  op->data = nullptr;
+  op->len  = pixels;
+  op->cmds = 0;
+  if (pixels) {
+    dl_pix -= (pixels + 1) & ~1;
+    op->data = dl_pix;
+  }
+  return op;
+}
+
+/***************************************************************************************
+** Function name:           dlAddress
+** Description:             add an address op, the window cache follows what it sends
+***************************************************************************************/
+void TFT_eSPI::dlAddress(uint8_t cmds, int32_t xs, int32_t xe, int32_t ys, int32_t ye)
+{
+  dl_op_t *op = dlOp(0);
+  op->cmds = cmds;
+  op->xs = xs;
+  op->xe = xe;
+  op->ys = ys;
+  op->ye = ye;
+
+  if (cmds & DL_CASET) { win_xs = xs; win_xe = xe; }
+  if (cmds & DL_PASET) { win_ys = ys; win_ye = ye; }
+  addr_row = 0xFFFF;
+  addr_col = 0xFFFF;
+}
+
+/***************************************************************************************
+** Function name:           dlClear
+** Description:             empty the half being recorded
+***************************************************************************************/
+void TFT_eSPI::dlClear(void)
+{
+  uint8_t *half = dl_buf + dl_cur * dl_half;
+  dl_ops  = (dl_op_t *)half;
+  dl_nops = 0;
+  dl_pix  = (uint16_t *)(half + dl_half);
+}
+
+/***************************************************************************************
+** Function name:           dlSend
+** Description:             send the recorded block and continue in the other half
+***************************************************************************************/
+void TFT_eSPI::dlSend(void)
+{
+  begin_tft_write();
+
+#if defined (TFT_DL_DMA)
+  if (dl_dma) {
+    SPI_BUSY_CHECK; // Let the last CPU write finish before the driver takes the bus
+
+    dl_queued[dl_cur] = 0;
+    for (uint32_t i = 0; i < dl_nops; i++) {
+      dl_op_t *op = &dl_ops[i];
+      if (op->data) {
+        bool job = (op->cmds & DL_IMAGE) && op->job.done;
+        dlQueue(true, op->data, op->len * 2, job ? &op->job : nullptr);
+        continue;
+      }
+      uint8_t b[4];
+      if (op->cmds & DL_CASET) {
+        b[0] = TFT_CASET;
+        dlQueue(false, b, 1);
+        b[0] = op->xs >> 8; b[1] = op->xs; b[2] = op->xe >> 8; b[3] = op->xe;
+        dlQueue(true, b, 4);
+      }
+      if (op->cmds & DL_PASET) {
+        b[0] = TFT_PASET;
+        dlQueue(false, b, 1);
+        b[0] = op->ys >> 8; b[1] = op->ys; b[2] = op->ye >> 8; b[3] = op->ye;
+        dlQueue(true, b, 4);
+      }
+      if (op->cmds & DL_RAMWR) {
+        b[0] = TFT_RAMWR;
+        dlQueue(false, b, 1);
+      }
+    }
+
+    // Record into the other half once the transactions reading it are done. Results come
+    // back in order, so that is when only this block's transactions are left
+    uint32_t mine = dl_queued[dl_cur];
+    spi_transaction_t *rtrans;
+    while (spiBusyCheck > mine) {
+      spi_device_get_trans_result(dmaHAL, &rtrans, portMAX_DELAY);
+      spiBusyCheck--;
+    }
+    dl_cur ^= 1;
+    dlClear();
+
+    end_tft_write();
+    return;
+  }
+#endif
+
+  bool swap = _swapBytes;
+  _swapBytes = true; // Pixels were stored as colour values
+  for (uint32_t i = 0; i < dl_nops; i++) {
+    dl_op_t *op = &dl_ops[i];
+    if (op->cmds & DL_IMAGE) {
+      _swapBytes = swap;
+      pushPixels(op->data, op->len);
+      _swapBytes = true;
+      if (op->job.done) op->job.done(op->job.ctx);
+      continue;
+    }
+    if (op->data) {
+      pushPixels(op->data, op->len);
+      continue;
+    }
+    SPI_BUSY_CHECK;
+    if (op->cmds & DL_CASET) {
+      DC_C; tft_Write_8(TFT_CASET);
+      DC_D; tft_Write_32C(op->xs, op->xe);
+    }
+    if (op->cmds & DL_PASET) {
+      DC_C; tft_Write_8(TFT_PASET);
+      DC_D; tft_Write_32C(op->ys, op->ye);
+    }
+    if (op->cmds & DL_RAMWR) {
+      DC_C; tft_Write_8(TFT_RAMWR);
+      DC_D;
+    }
+  }
+  _swapBytes = swap;
+  dl_cur ^= 1;
+  dlClear();
+
+  end_tft_write();
+}
+
+#if defined (TFT_DL_DMA)
+/***************************************************************************************
+** Function name:           dlQueue
+** Description:             queue one transaction, DC set by dc_callback() from "data"
+***************************************************************************************/
+void TFT_eSPI::dlQueue(bool data, const void *tx, uint32_t bytes, const tft_dl_job_t *job)
+{
+  spi_transaction_t *rtrans;
+  if (spiBusyCheck >= TFT_DMA_QUEUE) { // Wait for the oldest, its slot is reused
+    spi_device_get_trans_result(dmaHAL, &rtrans, portMAX_DELAY);
+    spiBusyCheck--;
+  }
+
+  spi_transaction_t *t = &dl_trans[dl_next];
+  tft_dl_job_t *j = &dl_jobs[dl_next];
+  dl_next = (dl_next + 1) % TFT_DMA_QUEUE;
+
+  memset(t, 0, sizeof(spi_transaction_t));
+  t->user   = (void *)(uintptr_t)data;
+  if (job) {
+    *j = *job;
+    t->user = j; // Still data for dc_callback(), the job for dl_job_callback()
+  }
+  t->length = bytes * 8;
+  if (bytes <= 4) {
+    t->flags = SPI_TRANS_USE_TXDATA; // Commands and parameters are copied
+    memcpy(t->tx_data, tx, bytes);
+  }
+  else t->tx_buffer = tx;
+
+  esp_err_t ret = spi_device_queue_trans(dmaHAL, t, portMAX_DELAY);
+  assert(ret == ESP_OK);
+
+  spiBusyCheck++;
+  dl_queued[dl_cur]++;
+}
+#endif
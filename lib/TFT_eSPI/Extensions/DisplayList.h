@@ -0,0 +1,61 @@
+ // This is part of the TFT_eSPI class and is associated with the display list functions
+
+ public:
+           // A display list records the address windows and pixels drawn between dlBegin()
+           // and dlEnd() into a caller-provided buffer, and sends them a block at a time.
+           // With initDMA() on an ESP32 SPI bus (TFT_DL_DMA) each block is queued as chained
+           // DMA transactions, DC being set per transaction by dc_callback(), and the next
+           // block is recorded into the other half of the buffer while it streams out.
+           // Elsewhere blocks are sent with the normal SPI writes.
+           // Only the dl functions may write to the TFT between dlBegin() and dlEnd(), and
+           // the buffer must be in internal RAM (not flash or PSRAM) for DMA.
+           // Call dlBegin() after startWrite(), false if the interface is not supported
+  bool     dlBegin(void *buffer, uint32_t bytes);
+           // Same as setWindow(), only sends the parts the controller does not have
+  void     dlWindow(int32_t x0, int32_t y0, int32_t x1, int32_t y1);
+           // Same as pushPixels() and pushBlock() into the window, the pixels are copied
+  void     dlPixels(const uint16_t *data, uint32_t len);
+  void     dlFill(uint32_t color, uint32_t len);
+           // Same as dlPixels(), but the pixels are sent from data in place and the block
+           // goes out at once, so the transfer runs while the caller prepares the next one.
+           // data must be in DMA capable internal RAM and left alone until done(ctx) is
+           // called (done may be nullptr); with DMA its bytes are swapped in place when
+           // setSwapBytes(true), as pushImageDMA() does
+  void     dlImage(uint16_t *data, uint32_t len, tft_dl_done_t done, void *ctx);
+           // Same as drawSpans()
+  void     dlSpans(tft_span_t *spans, uint32_t n, uint32_t color);
+           // Send the last block, a DMA transfer may still be running: endWrite() or
+           // dmaWait() waits for it
+  void     dlEnd(void);
+  bool     dlRecording(void) { return dl_buf != nullptr; }
+
+ private:
+           // One op is an address (CASET / PASET / RAMWR) or a pixel run in the buffer
+           #define DL_CASET 0x01
+           #define DL_PASET 0x02
+           #define DL_RAMWR 0x04
+           #define DL_IMAGE 0x08 // Pixels of a dlImage(), outside the buffer
+  typedef struct {
+    uint16_t *data;    // Pixels, nullptr for an address
+    uint32_t  len;     // Pixel count
+    uint16_t  xs, xe, ys, ye;
+    uint8_t   cmds;    // DL_CASET | DL_PASET | DL_RAMWR, or DL_IMAGE for pixels
+    tft_dl_job_t job;  // Of a dlImage()
+  } dl_op_t;
+
+  dl_op_t* dlOp(uint32_t pixels);  // Room for an op and its pixels, sends the block if full
+  void     dlAddress(uint8_t cmds, int32_t xs, int32_t xe, int32_t ys, int32_t ye);
+  void     dlSend(void);           // Send the block, continue in the other half
+  void     dlClear(void);          // Empty the current half
+#if defined (TFT_DL_DMA)
+  void     dlQueue(bool data, const void *tx, uint32_t bytes, const tft_dl_job_t *job = nullptr);
+#endif
+
+  uint8_t  *dl_buf = nullptr;      // 4 byte aligned start of the buffer, nullptr when not recording
+  uint32_t  dl_half;               // Bytes in each half
+  uint8_t   dl_cur;                // Half being recorded
+  dl_op_t  *dl_ops;                // Ops of the current half, from the start
+  uint32_t  dl_nops;
+  uint16_t *dl_pix;                // Pixels of the current half, from the end down
+  uint32_t  dl_queued[2];          // DMA transactions queued from each half
+  bool      dl_dma;                // Blocks are queued as DMA transactions
@@ -298,6 +298,13 @@ void TFT_eSPI::unloadFont( void )
 
   gFont.gArray = nullptr;
 
+  glyphCacheEvict(0);
+  if (gc_index)
+  {
+    free(gc_index);
+    gc_index = nullptr;
+  }
+
 #ifdef FONT_FS_AVAILABLE
   if (fs_font && fontFile) fontFile.close();
 #endif
@@ -405,15 +412,20 @@ void TFT_eSPI::drawGlyph(uint16_t code)
     if (cursor_x == 0) cursor_x -= gdX[gNum];
 
     uint8_t* pbuffer = nullptr;
-    const uint8_t* gPtr = (const uint8_t*) gFont.gArray;
+    const uint8_t* gPtr = nullptr; // Whole bitmap in memory: FLASH array or glyph cache
 
 #ifdef FONT_FS_AVAILABLE
     if (fs_font)
     {
-      fontFile.seek(gBitmap[gNum], fs::SeekSet);
-      pbuffer =  (uint8_t*)malloc(gWidth[gNum]);
+      gPtr = glyphCacheGet(gNum); // Before startWrite(), the file may be on a shared SPI bus
+      if (!gPtr) {
+        fontFile.seek(gBitmap[gNum], fs::SeekSet);
+        pbuffer =  (uint8_t*)malloc(gWidth[gNum]);
+      }
     }
+    else
 #endif
+    gPtr = (const uint8_t*) gFont.gArray + gBitmap[gNum];
 
     int16_t cy = cursor_y + gFont.maxAscent - gdY[gNum];
     int16_t cx = cursor_x + gdX[gNum];
@@ -461,7 +473,7 @@ void TFT_eSPI::drawGlyph(uint16_t code)
     for (int32_t y = 0; y < gHeight[gNum]; y++)
     {
 #ifdef FONT_FS_AVAILABLE
-      if (fs_font) {
+      if (pbuffer) {
         if (spiffs)
         {
           fontFile.read(pbuffer, gWidth[gNum]);
@@ -480,10 +492,10 @@ void TFT_eSPI::drawGlyph(uint16_t code)
       for (int32_t x = 0; x < gWidth[gNum]; x++)
       {
 #ifdef FONT_FS_AVAILABLE
-        if (fs_font) pixel = pbuffer[x];
+        if (pbuffer) pixel = pbuffer[x];
         else
 #endif
-        pixel = pgm_read_byte(gPtr + gBitmap[gNum] + x + gWidth[gNum] * y);
+        pixel = pgm_read_byte(gPtr + x + gWidth[gNum] * y);
 
         if (pixel)
         {
@@ -541,6 +553,124 @@ void TFT_eSPI::drawGlyph(uint16_t code)
   last_cursor_x = cursor_x;
 }
 
+/***************************************************************************************
+** Function name:           setGlyphCache
+** Description:             Set the RAM budget of the glyph cache, 0 to turn it off
+*************************************************************************************x*/
+void TFT_eSPI::setGlyphCache(uint32_t bytes)
+{
+  gc_budget = bytes;
+  glyphCacheEvict(bytes);
+}
+
+/***************************************************************************************
+** Function name:           getGlyphCacheStats
+** Description:             Glyphs drawn from the cache and glyphs read from the file
+*************************************************************************************x*/
+void TFT_eSPI::getGlyphCacheStats(uint32_t *hits, uint32_t *misses)
+{
+  if (hits)   *hits   = gc_hits;
+  if (misses) *misses = gc_misses;
+}
+
+/***************************************************************************************
+** Function name:           resetGlyphCacheStats
+** Description:             Zero the glyph cache counters
+*************************************************************************************x*/
+void TFT_eSPI::resetGlyphCacheStats(void)
+{
+  gc_hits   = 0;
+  gc_misses = 0;
+}
+
+/***************************************************************************************
+** Function name:           glyphCacheGet
+** Description:             Bitmap of a file font glyph from the cache, read in on a miss
+*************************************************************************************x*/
+const uint8_t* TFT_eSPI::glyphCacheGet(uint16_t gNum)
+{
+#ifdef FONT_FS_AVAILABLE
+  if (!gc_budget || !fs_font) return nullptr;
+
+  if (!gc_index)
+  {
+    gc_index = (glyph_cache_t**)calloc(gFont.gCount, sizeof(glyph_cache_t*));
+    if (!gc_index) return nullptr;
+  }
+
+  glyph_cache_t* e = gc_index[gNum];
+  if (e)
+  {
+    gc_hits++;
+    if (e != gc_head)
+    {
+      // Move to the front
+      e->prev->next = e->next;
+      if (e->next) e->next->prev = e->prev;
+      else gc_tail = e->prev;
+      e->prev = nullptr;
+      e->next = gc_head;
+      gc_head->prev = e;
+      gc_head = e;
+    }
+    return (const uint8_t*)(e + 1);
+  }
+
+  gc_misses++;
+  uint32_t size  = gWidth[gNum] * gHeight[gNum];
+  uint32_t bytes = sizeof(glyph_cache_t) + size;
+  if (bytes > gc_budget) return nullptr;
+  glyphCacheEvict(gc_budget - bytes);
+
+  #if defined (ESP32) && defined (CONFIG_SPIRAM_SUPPORT)
+  if ( psramFound() ) e = (glyph_cache_t*)ps_malloc(bytes);
+  else
+  #endif
+  e = (glyph_cache_t*)malloc(bytes);
+  if (!e) return nullptr;
+
+  fontFile.seek(gBitmap[gNum], fs::SeekSet);
+  if (fontFile.read((uint8_t*)(e + 1), size) != size)
+  {
+    free(e);
+    return nullptr;
+  }
+
+  e->bytes = bytes;
+  e->gNum  = gNum;
+  e->prev  = nullptr;
+  e->next  = gc_head;
+  if (gc_head) gc_head->prev = e;
+  else gc_tail = e;
+  gc_head = e;
+  gc_index[gNum] = e;
+  gc_used += bytes;
+
+  return (const uint8_t*)(e + 1);
+#else
+  (void)gNum;
+  return nullptr;
+#endif
+}
+
+/***************************************************************************************
+** Function name:           glyphCacheEvict
+** Description:             Free the least recently drawn glyphs down to budget bytes
+*************************************************************************************x*/
+void TFT_eSPI::glyphCacheEvict(uint32_t budget)
+{
+  while (gc_tail && gc_used > budget)
+  {
+    glyph_cache_t* e = gc_tail;
+    gc_tail = e->prev;
+    if (gc_tail) gc_tail->next = nullptr;
+    else gc_head = nullptr;
+    if (gc_index) gc_index[e->gNum] = nullptr;
+    gc_used -= e->bytes;
+    free(e);
+  }
+}
+
 /***************************************************************************************
 ** Function name:           showFont
 ** Description:             Page through all characters in font, td ms between screens
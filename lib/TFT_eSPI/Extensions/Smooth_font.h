@@ -16,6 +16,14 @@
 
   void     showFont(uint32_t td);
 
+           // Glyph bitmaps of a font loaded from a file are kept in RAM (PSRAM if fitted) up
+           // to "bytes", the least recently drawn going first, so drawing them needs no file
+           // access. 0 (the default) turns the cache off. Array fonts are not cached, they
+           // are read from memory mapped FLASH
+  void     setGlyphCache(uint32_t bytes);
+  void     getGlyphCacheStats(uint32_t *hits, uint32_t *misses);
+  void     resetGlyphCacheStats(void);
+
  // This is for the whole font
   typedef struct
   {
@@ -59,3 +67,21 @@ fontMetrics gFont = { nullptr, 0, 0, 0, 0, 0, 0, 0 };
 
   uint8_t* fontPtr = nullptr;
 
+  protected:
+
+  // A cached glyph bitmap follows its entry; entries are listed most recently drawn first
+  typedef struct glyph_cache_t {
+    struct glyph_cache_t *prev, *next;
+    uint32_t bytes;                  // Entry and bitmap
+    uint16_t gNum;
+  } glyph_cache_t;
+
+  const uint8_t* glyphCacheGet(uint16_t gNum); // The bitmap, nullptr if not cached and it can't be
+  void     glyphCacheEvict(uint32_t budget);   // Drop the oldest until at most budget bytes are used
+
+  glyph_cache_t** gc_index = nullptr;          // Entry of each glyph, gCount of them
+  glyph_cache_t*  gc_head  = nullptr;
+  glyph_cache_t*  gc_tail  = nullptr;
+  uint32_t gc_budget = 0, gc_used = 0;
+  uint32_t gc_hits = 0, gc_misses = 0;
+
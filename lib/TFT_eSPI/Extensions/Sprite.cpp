@@ -26,6 +26,9 @@ TFT_eSprite::TFT_eSprite(TFT_eSPI *tft)
   _created = false;
   _vpOoB   = true;
 
+  _runs  = nullptr;
+  _nRuns = 0;
+
   _xs = 0;  // window bounds for pushColor
   _ys = 0;
   _xe = 0;
@@ -372,6 +375,8 @@ uint16_t TFT_eSprite::getPaletteColor(uint8_t index)
 ***************************************************************************************/
 void TFT_eSprite::deleteSprite(void)
 {
+  releaseRuns();
+
   if (_colorMap != nullptr)
   {
     free(_colorMap);
@@ -703,6 +708,98 @@ void TFT_eSprite::pushSprite(int32_t x, int32_t y, uint16_t transp)
 }
 
 
+/***************************************************************************************
+** Function name:           prepareRuns
+** Description:             Record the runs of pixels that are not the transparent colour
+***************************************************************************************/
+bool TFT_eSprite::prepareRuns(uint16_t transp)
+{
+  releaseRuns();
+  if (!_created || _bpp != 16) return false;
+
+  // Sprite pixels are stored with the bytes swapped, as in pushImage()
+  transp = transp >> 8 | transp << 8;
+
+  // Count the runs, then record them
+  for (uint8_t pass = 0; pass < 2; pass++) {
+    uint32_t n = 0;
+    for (int32_t y = 0; y < _dheight; y++) {
+      uint16_t *row = _img + y * _dwidth;
+      int32_t x = 0;
+      while (x < _dwidth) {
+        while (x < _dwidth && row[x] == transp) x++;
+        if (x == _dwidth) break;
+        int32_t sx = x;
+        while (x < _dwidth && row[x] != transp) x++;
+        if (pass) {
+          _runs[n].x = sx;
+          _runs[n].y = y;
+          _runs[n].w = x - sx;
+        }
+        n++;
+      }
+    }
+
+    if (!pass) {
+      if (!n) { _nRuns = 0; return true; } // Nothing to push
+      _runs = (tft_span_t*)malloc(n * sizeof(tft_span_t));
+      if (!_runs) return false;
+    }
+    _nRuns = n;
+  }
+
+  return true;
+}
+
+
+/***************************************************************************************
+** Function name:           pushPrepared
+** Description:             Push the opaque runs of a prepared sprite to the TFT at x, y
+***************************************************************************************/
+void TFT_eSprite::pushPrepared(int32_t x, int32_t y)
+{
+  if (!_created || !_runs || _tft->_vpOoB) return;
+
+  x += _tft->_xDatum;
+  y += _tft->_yDatum;
+
+  bool oldSwapBytes = _tft->getSwapBytes();
+  _tft->setSwapBytes(false);
+  _tft->startWrite();
+
+  for (uint32_t i = 0; i < _nRuns; i++) {
+    const tft_span_t &r = _runs[i];
+
+    int32_t ty = y + r.y;
+    if (ty < _tft->_vpY || ty >= _tft->_vpH) continue;
+
+    // Clip the run to the viewport
+    int32_t tx = x + r.x, sx = r.x, w = r.w;
+    if (tx < _tft->_vpX) { sx += _tft->_vpX - tx; w -= _tft->_vpX - tx; tx = _tft->_vpX; }
+    if (tx + w > _tft->_vpW) w = _tft->_vpW - tx;
+    if (w < 1) continue;
+
+    _tft->setWindow(tx, ty, tx + w - 1, ty);
+    _tft->pushPixels(_img + r.y * _dwidth + sx, w);
+  }
+
+  _tft->endWrite();
+  _tft->setSwapBytes(oldSwapBytes);
+}
+
+
+/***************************************************************************************
+** Function name:           releaseRuns
+** Description:             Free the runs of a prepared sprite
+***************************************************************************************/
+void TFT_eSprite::releaseRuns(void)
+{
+  if (_runs) free(_runs);
+  _runs  = nullptr;
+  _nRuns = 0;
+}
+
+
 /***************************************************************************************
 ** Function name:           pushToSprite
 ** Description:             Push the sprite to another sprite at x, y
@@ -1802,6 +1899,17 @@ void TFT_eSprite::drawFastVLine(int32_t x, int32_t y, int32_t h, uint32_t color)
 }
 
 
+/***************************************************************************************
+** Function name:           drawSpans
+** Description:             draw a batch of horizontal lines in one colour
+***************************************************************************************/
+void TFT_eSprite::drawSpans(tft_span_t *spans, uint32_t n, uint32_t color)
+{
+  // No bus to save commands on: same result as TFT_eSPI::drawSpans()
+  for (uint32_t i = 0; i < n; i++) drawFastHLine(spans[i].x, spans[i].y, spans[i].w, color);
+}
+
+
 /***************************************************************************************
 ** Function name:           drawFastHLine
 ** Description:             draw a horizontal line
@@ -2476,14 +2584,19 @@ void TFT_eSprite::drawGlyph(uint16_t code)
     }
 
     uint8_t* pbuffer = nullptr;
-    const uint8_t* gPtr = (const uint8_t*) gFont.gArray;
+    const uint8_t* gPtr = nullptr; // Whole bitmap in memory: FLASH array or glyph cache
 
 #ifdef FONT_FS_AVAILABLE
     if (fs_font) {
-      fontFile.seek(gBitmap[gNum], fs::SeekSet); // This is slow for a significant position shift!
-      pbuffer =  (uint8_t*)malloc(gWidth[gNum]);
+      gPtr = glyphCacheGet(gNum);
+      if (!gPtr) {
+        fontFile.seek(gBitmap[gNum], fs::SeekSet); // This is slow for a significant position shift!
+        pbuffer =  (uint8_t*)malloc(gWidth[gNum]);
+      }
     }
+    else
 #endif
+    gPtr = (const uint8_t*) gFont.gArray + gBitmap[gNum];
 
     int16_t cy = cursor_y + gFont.maxAscent - gdY[gNum];
     int16_t cx = cursor_x + gdX[gNum];
@@ -2528,7 +2641,7 @@ void TFT_eSprite::drawGlyph(uint16_t code)
     for (int32_t y = 0; y < gHeight[gNum]; y++)
     {
 #ifdef FONT_FS_AVAILABLE
-      if (fs_font) {
+      if (pbuffer) {
         fontFile.read(pbuffer, gWidth[gNum]);
       }
 #endif
@@ -2536,10 +2649,10 @@ void TFT_eSprite::drawGlyph(uint16_t code)
       for (int32_t x = 0; x < gWidth[gNum]; x++)
       {
 #ifdef FONT_FS_AVAILABLE
-        if (fs_font) pixel = pbuffer[x];
+        if (pbuffer) pixel = pbuffer[x];
         else
 #endif
-        pixel = pgm_read_byte(gPtr + gBitmap[gNum] + x + gWidth[gNum] * y);
+        pixel = pgm_read_byte(gPtr + x + gWidth[gNum] * y);
 
         if (pixel)
         {
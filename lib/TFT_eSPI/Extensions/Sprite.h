@@ -85,7 +85,10 @@ class TFT_eSprite : public TFT_eSPI {
            drawFastHLine(int32_t x, int32_t y, int32_t w, uint32_t color),
 
            // Fill a rectangular area with a color (aka draw a filled rectangle)
-           fillRect(int32_t x, int32_t y, int32_t w, int32_t h, uint32_t color);
+           fillRect(int32_t x, int32_t y, int32_t w, int32_t h, uint32_t color),
+
+           // Draw a batch of horizontal lines, one drawFastHLine() each (spans are not reordered)
+           drawSpans(tft_span_t *spans, uint32_t n, uint32_t color);
 
            // Set the coordinate rotation of the Sprite (for 1bpp Sprites only)
            // Note: this uses coordinate rotation and is primarily for ePaper which does not support
@@ -123,6 +126,16 @@ class TFT_eSprite : public TFT_eSPI {
   void     pushSprite(int32_t x, int32_t y);
   void     pushSprite(int32_t x, int32_t y, uint16_t transparent);
 
+           // Prepared sprites (16-bit only), for overlays pushed many times unchanged: prepareRuns()
+           // records the runs of pixels that are not the transparent colour, then pushPrepared()
+           // sends only those runs, without testing any pixel, same as pushSprite(x, y, transparent).
+           // Prepare again after drawing in the sprite. False if not 16-bit or out of memory
+  bool     prepareRuns(uint16_t transparent);
+  void     pushPrepared(int32_t x, int32_t y);
+  void     releaseRuns(void);
+           // Number of opaque runs, 0 if not prepared
+  uint32_t preparedRuns(void) { return _nRuns; }
+
            // Push a windowed area of the sprite to the TFT at tx, ty
   bool     pushSprite(int32_t tx, int32_t ty, int32_t sx, int32_t sy, int32_t sw, int32_t sh);
 
@@ -174,6 +187,8 @@ class TFT_eSprite : public TFT_eSPI {
   int32_t  _cosra;   // Cosine of rotation angle in fixed point
 
   bool     _created; // A Sprite has been created and memory reserved
+  tft_span_t *_runs; // Opaque runs of a prepared sprite, nullptr if not prepared
+  uint32_t _nRuns;
   bool     _gFont = false; 
 
   int32_t  _xs, _ys, _xe, _ye, _xptr, _yptr; // for setWindow
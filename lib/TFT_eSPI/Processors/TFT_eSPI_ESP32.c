@@ -778,6 +778,25 @@ void IRAM_ATTR dma_end_callback(spi_transaction_t *spi_tx)
   WRITE_PERI_REG(SPI_DMA_CONF_REG(spi_host), 0);
 }
 
+/***************************************************************************************
+** Function name:           dl_job_callback
+** Description:             Runs the completion of a display list dlImage() transaction
+***************************************************************************************/
+extern "C" void dl_job_callback();
+
+void IRAM_ATTR dl_job_callback(spi_transaction_t *spi_tx)
+{
+  #ifndef CONFIG_IDF_TARGET_ESP32
+    dma_end_callback(spi_tx);
+  #endif
+
+  // The user field is 0 for commands, 1 for data, else a dlImage() job
+  if ((uintptr_t)spi_tx->user > 1) {
+    tft_dl_job_t *job = (tft_dl_job_t *)spi_tx->user;
+    job->done(job->ctx);
+  }
+}
+
 /***************************************************************************************
 ** Function name:           initDMA
 ** Description:             Initialise the DMA engine - returns true if init OK
@@ -819,13 +838,9 @@ bool TFT_eSPI::initDMA(bool ctrl_cs)
     .input_delay_ns = 0,
     .spics_io_num = pin,
     .flags = SPI_DEVICE_NO_DUMMY, //0,
-    .queue_size = 1,
-    .pre_cb = 0, //dc_callback, //Callback to handle D/C line
-    #ifdef CONFIG_IDF_TARGET_ESP32
-      .post_cb = 0
-    #else
-      .post_cb = dma_end_callback
-    #endif
+    .queue_size = TFT_DMA_QUEUE, // Display lists queue several transactions
+    .pre_cb = dc_callback, //Callback to handle D/C line, data if the transaction user field is set
+    .post_cb = dl_job_callback
   };
   ret = spi_bus_initialize(spi_host, &buscfg, DMA_CHANNEL);
   ESP_ERROR_CHECK(ret);
@@ -121,6 +121,12 @@ SPI3_HOST = 2
   #define ESP32_DMA
   // Code to check if DMA is busy, used by SPI DMA + transaction + endWrite functions
   #define DMA_BUSY_CHECK  dmaWait()
+  // Display lists (Extensions/DisplayList.cpp) can be queued as DMA transactions
+  #define TFT_DL_DMA
+  // Transactions that can be queued at once, at most 255 (spiBusyCheck)
+  #ifndef TFT_DMA_QUEUE
+    #define TFT_DMA_QUEUE 32
+  #endif
 #else
   #define DMA_BUSY_CHECK
 #endif
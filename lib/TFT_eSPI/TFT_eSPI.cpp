@@ -482,6 +482,8 @@ TFT_eSPI::TFT_eSPI(int16_t w, int16_t h)
 
   addr_row = 0xFFFF;  // drawPixel command length optimiser
   addr_col = 0xFFFF;  // drawPixel command length optimiser
+  win_xs = win_xe = win_ys = win_ye = -1; // setWindow command length optimiser
+  win_sent = win_saved = 0;
 
   _xPivot = 0;
   _yPivot = 0;
@@ -876,8 +878,7 @@ void TFT_eSPI::setRotation(uint8_t m)
 
   end_tft_write();
 
-  addr_row = 0xFFFF;
-  addr_col = 0xFFFF;
+  invalidateWindow();
 
   // Reset the viewport to the whole screen
   resetViewport();
@@ -2173,6 +2174,86 @@ void TFT_eSPI::pushMaskedImage(int32_t x, int32_t y, int32_t w, int32_t h, uint1
 }
 
 
+/***************************************************************************************
+** Function name:           pushMask
+** Description:             Render a 1bpp mask in one colour over a background image
+***************************************************************************************/
+void TFT_eSPI::pushMask(int32_t x, int32_t y, int32_t w, int32_t h, const uint8_t *mask, int32_t stride,
+                        uint16_t fg, const uint16_t *bg, int32_t bgStride)
+{
+  maskBlit(x, y, w, h, mask, stride, fg, bg, bgStride, 0);
+}
+
+/***************************************************************************************
+** Function name:           pushMask
+** Description:             Render a 1bpp mask in one colour over a background colour
+***************************************************************************************/
+void TFT_eSPI::pushMask(int32_t x, int32_t y, int32_t w, int32_t h, const uint8_t *mask, int32_t stride,
+                        uint16_t fg, uint16_t bgColor)
+{
+  maskBlit(x, y, w, h, mask, stride, fg, nullptr, 0, bgColor);
+}
+
+/***************************************************************************************
+** Function name:           maskBlit
+** Description:             Expand a 1bpp mask into line buffers and push them in one window
+***************************************************************************************/
+void TFT_eSPI::maskBlit(int32_t x, int32_t y, int32_t w, int32_t h, const uint8_t *mask, int32_t stride,
+                        uint16_t fg, const uint16_t *bg, int32_t bgStride, uint16_t bgColor)
+{
+  PI_CLIP;
+
+  begin_tft_write();
+  inTransaction = true;
+
+  // Pixels are expanded in display byte order, two per 32-bit word, the first in the
+  // low half. Two mask bits (first pixel in bit 1) select the halves taken from fg
+  const uint32_t sel[4] = { 0x00000000, 0xFFFF0000, 0x0000FFFF, 0xFFFFFFFF };
+  uint32_t f = (uint16_t)(fg << 8 | fg >> 8);
+  uint32_t b = (uint16_t)(bgColor << 8 | bgColor >> 8);
+  f |= f << 16;
+  b |= b << 16;
+
+  uint32_t buffer[32]; // 64 pixels
+
+  setWindow(x, y, x + dw - 1, y + dh - 1);
+
+  bool swap = _swapBytes;
+  _swapBytes = false;
+
+  for (int32_t i = 0; i < dh; i++) {
+    const uint8_t  *mrow = mask + (dy + i) * stride;
+    const uint16_t *brow = bg ? bg + (dy + i) * bgStride + dx : nullptr;
+
+    for (int32_t j = 0; j < dw; j += 64) {
+      int32_t n = (dw - j < 64) ? dw - j : 64;
+
+      for (int32_t k = 0; k < n; k += 2) {
+        int32_t c = dx + j + k;
+        uint32_t bits = pgm_read_byte(mrow + (c >> 3));
+        if ((c & 7) != 7) bits = (bits >> (6 - (c & 7))) & 3;
+        else {
+          bits = (bits & 1) << 1;
+          if (k + 1 < n) bits |= pgm_read_byte(mrow + (c >> 3) + 1) >> 7;
+        }
+
+        uint32_t back = b;
+        if (brow) {
+          back = pgm_read_word(brow + j + k);
+          if (k + 1 < n) back |= (uint32_t)pgm_read_word(brow + j + k + 1) << 16;
+          if (swap) back = (back & 0xFF00FF00) >> 8 | (back & 0x00FF00FF) << 8;
+        }
+        buffer[k >> 1] = (f & sel[bits]) | (back & ~sel[bits]);
+      }
+      pushPixels(buffer, n);
+    }
+  }
+
+  _swapBytes = swap;
+  inTransaction = lockTransaction;
+  end_tft_write();
+}
+
 /***************************************************************************************
 ** Function name:           setSwapBytes
 ** Description:             Used by 16-bit pushImage() to swap byte order in colours
@@ -3204,6 +3285,9 @@ void TFT_eSPI::drawChar(int32_t x, int32_t y, uint16_t c, uint32_t color, uint32
   if (!_cp437 && c > 175) c++;
 
   bool fillbg = (bg != color);
+
+#if defined (SPI_18BIT_DRIVER)
+  // pushMask() is only checked against the 16-bit interface: one window per unclipped cell
   bool clip = xd < _vpX || xd + 6  * textsize >= _vpW || yd < _vpY || yd + 8 * textsize >= _vpH;
 
   if ((size==1) && fillbg && !clip) {
@@ -3227,6 +3311,19 @@ void TFT_eSPI::drawChar(int32_t x, int32_t y, uint16_t c, uint32_t color, uint32
 
     end_tft_write();
   }
+#else
+  if ((size==1) && fillbg) {
+    // The font is stored by columns, LSB at the top: turn the cell into a mask of rows
+    uint8_t rows[8] = { 0 };
+    for (int8_t i = 0; i < 5; i++ ) {
+      uint8_t line = pgm_read_byte(&font[0] + (c * 5) + i);
+      for (int8_t j = 0; j < 8; j++) {
+        if (line & (1 << j)) rows[j] |= 0x80 >> i;
+      }
+    }
+    pushMask(x, y, 6, 8, rows, 1, color, bg); // Clips to the viewport
+  }
+#endif
   else {
     //begin_tft_write();          // Sprite class can use this function, avoiding begin_tft_write()
     inTransaction = true;
@@ -3481,18 +3578,75 @@ void TFT_eSPI::setWindow(int32_t x0, int32_t y0, int32_t x1, int32_t y1)
       TX_FIFO = TFT_RAMWR;
     #endif
   #else
+    #if defined (MULTI_TFT_SUPPORT) || defined (GC9A01_DRIVER)
+      win_xs = win_ys = -1; // Always send the address, as drawPixel() does
+    #endif
+
     SPI_BUSY_CHECK;
-    DC_C; tft_Write_8(TFT_CASET);
-    DC_D; tft_Write_32C(x0, x1);
-    DC_C; tft_Write_8(TFT_PASET);
-    DC_D; tft_Write_32C(y0, y1);
+    // No need to send the columns or rows the controller already has.
+    // RAMWR alone restarts the write at the top left of the window
+    if (x0 != win_xs || x1 != win_xe) {
+      DC_C; tft_Write_8(TFT_CASET);
+      DC_D; tft_Write_32C(x0, x1);
+      win_xs = x0;
+      win_xe = x1;
+      win_sent += 5;
+    }
+    else win_saved += 5;
+
+    if (y0 != win_ys || y1 != win_ye) {
+      DC_C; tft_Write_8(TFT_PASET);
+      DC_D; tft_Write_32C(y0, y1);
+      win_ys = y0;
+      win_ye = y1;
+      win_sent += 5;
+    }
+    else win_saved += 5;
+
     DC_C; tft_Write_8(TFT_RAMWR);
     DC_D;
+
+    // A one pixel wide or high window is also drawPixel()'s cached address
+    if (x0 == x1) addr_col = x0;
+    if (y0 == y1) addr_row = y0;
   #endif // RP2040 SPI
 #endif
   //end_tft_write(); // Must be called after setWindow
 }
 
+/***************************************************************************************
+** Function name:           invalidateWindow
+** Description:             forget the window held by the controller, the next
+**                          setWindow() or drawPixel() sends the full address
+***************************************************************************************/
+void TFT_eSPI::invalidateWindow(void)
+{
+  win_xs = win_xe = win_ys = win_ye = -1;
+  addr_row = 0xFFFF;
+  addr_col = 0xFFFF;
+}
+
+
+/***************************************************************************************
+** Function name:           getWindowStats
+** Description:             CASET / PASET bytes sent and skipped by setWindow()
+***************************************************************************************/
+void TFT_eSPI::getWindowStats(uint32_t *sent, uint32_t *saved)
+{
+  if (sent)  *sent  = win_sent;
+  if (saved) *saved = win_saved;
+}
+
+
+/***************************************************************************************
+** Function name:           resetWindowStats
+** Description:             zero the setWindow() address byte counters
+***************************************************************************************/
+void TFT_eSPI::resetWindowStats(void)
+{
+  win_sent = win_saved = 0;
+}
+
 /***************************************************************************************
 ** Function name:           readAddrWindow
 ** Description:             define an area to read a stream of pixels
@@ -3504,8 +3658,7 @@ void TFT_eSPI::readAddrWindow(int32_t xs, int32_t ys, int32_t w, int32_t h)
   int32_t xe = xs + w - 1;
   int32_t ye = ys + h - 1;
 
-  addr_col = 0xFFFF;
-  addr_row = 0xFFFF;
+  invalidateWindow();
 
 #if defined (SSD1963_DRIVER)
   if ((rotation & 0x1) == 0) { transpose(xs, ys); transpose(xe, ye); }
@@ -3761,6 +3914,7 @@ void TFT_eSPI::drawPixel(int32_t x, int32_t y, uint32_t color)
       DC_C; tft_Write_8(TFT_CASET);
       DC_D; tft_Write_32D(x);
       addr_col = x;
+      win_xs = win_xe = x;
     }
 
     // No need to send y if it has not changed (speeds things up)
@@ -3768,6 +3922,7 @@ void TFT_eSPI::drawPixel(int32_t x, int32_t y, uint32_t color)
       DC_C; tft_Write_8(TFT_PASET);
       DC_D; tft_Write_32D(y);
       addr_row = y;
+      win_ys = win_ye = y;
     }
   #endif
 
@@ -4652,6 +4807,96 @@ void TFT_eSPI::drawFastHLine(int32_t x, int32_t y, int32_t w, uint32_t color)
 }
 
 
+/***************************************************************************************
+** Function name:           drawSpans
+** Description:             draw a batch of horizontal lines in one colour
+***************************************************************************************/
+void TFT_eSPI::drawSpans(tft_span_t *spans, uint32_t n, uint32_t color)
+{
+  if (_vpOoB || !n) return;
+
+  // Sort by row, then column (insertion sort: spans from masks and shapes arrive nearly sorted)
+  for (uint32_t i = 1; i < n; i++) {
+    tft_span_t s = spans[i];
+    uint32_t j = i;
+    while (j > 0 && (spans[j - 1].y > s.y || (spans[j - 1].y == s.y && spans[j - 1].x > s.x))) {
+      spans[j] = spans[j - 1];
+      j--;
+    }
+    spans[j] = s;
+  }
+
+  begin_tft_write();
+
+#if defined (ILI9225_DRIVER) || defined (SSD1351_DRIVER) || defined (SSD1963_DRIVER) || \
+    defined (ARDUINO_ARCH_RP2040) || defined (ARDUINO_ARCH_MBED)
+  // No command elision for these interfaces, just one transaction for the batch
+  for (uint32_t i = 0; i < n; i++) {
+    int32_t x = spans[i].x + _xDatum;
+    int32_t y = spans[i].y + _yDatum;
+    int32_t w = spans[i].w;
+    if ((y < _vpY) || (x >= _vpW) || (y >= _vpH)) continue;
+    if (x < _vpX) { w += x - _vpX; x = _vpX; }
+    if ((x + w) > _vpW) w = _vpW - x;
+    if (w < 1) continue;
+    setWindow(x, y, x + w - 1, y);
+    pushBlock(color, w);
+  }
+#else
+  // The page end is the last row, so after a span of the window width the
+  // panel continues on the next row with the same columns
+  int32_t lastX0 = -1, lastX1 = -1, lastY = -2;
+  int32_t pageY = -1; // first row of the current page window (RAMWR restarts there)
+
+  for (uint32_t i = 0; i < n; i++) {
+    int32_t x = spans[i].x + _xDatum;
+    int32_t y = spans[i].y + _yDatum;
+    int32_t w = spans[i].w;
+
+    // Clipping, as drawFastHLine()
+    if ((y < _vpY) || (x >= _vpW) || (y >= _vpH)) continue;
+    if (x < _vpX) { w += x - _vpX; x = _vpX; }
+    if ((x + w) > _vpW) w = _vpW - x;
+    if (w < 1) continue;
+
+    int32_t x1 = x + w - 1;
+    bool sameCols = (x == lastX0) && (x1 == lastX1);
+
+    if (!sameCols || y != lastY + 1) {
+      int32_t cx0 = x, cx1 = x1, cy0 = y, cy1 = _height - 1;
+      #ifdef CGRAM_OFFSET
+        cx0 += colstart; cx1 += colstart;
+        cy0 += rowstart; cy1 += rowstart;
+      #endif
+      SPI_BUSY_CHECK;
+      if (!sameCols) {
+        DC_C; tft_Write_8(TFT_CASET);
+        DC_D; tft_Write_32C(cx0, cx1);
+      }
+      if (y != pageY) {
+        DC_C; tft_Write_8(TFT_PASET);
+        DC_D; tft_Write_32C(cy0, cy1);
+        pageY = y;
+      }
+      DC_C; tft_Write_8(TFT_RAMWR);
+      DC_D;
+    }
+
+    pushBlock(color, w);
+
+    lastX0 = x;
+    lastX1 = x1;
+    lastY = y;
+  }
+
+  // Neither drawPixel() nor setWindow() can trust the cached address any more
+  invalidateWindow();
+#endif
+
+  end_tft_write();
+}
+
+
 /***************************************************************************************
 ** Function name:           fillRect
 ** Description:             draw a filled rectangle
@@ -6147,6 +6392,8 @@ void TFT_eSPI::getSetup(setup_t &tft_settings)
 
 #include "Extensions/Sprite.cpp"
 
+#include "Extensions/DisplayList.cpp"
+
 #ifdef SMOOTH_FONT
   #include "Extensions/Smooth_font.cpp"
 #endif
@@ -423,6 +423,21 @@ int16_t tch_spi_freq;// Touch controller read/write SPI frequency
 // Callback prototype for smooth font pixel colour read
 typedef uint16_t (*getColorCallback)(uint16_t x, uint16_t y);
 
+// A horizontal run of w pixels starting at x,y, for drawSpans()
+typedef struct {
+  int32_t x;
+  int32_t y;
+  int32_t w;
+} tft_span_t;
+
+// Completion of the pixels of a dlImage(): done(ctx) is called once they are sent,
+// from the SPI interrupt when they went out by DMA
+typedef void (*tft_dl_done_t)(void *ctx);
+typedef struct {
+  tft_dl_done_t done;
+  void         *ctx;
+} tft_dl_job_t;
+
 // Class functions and variables
 class TFT_eSPI : public Print { friend class TFT_eSprite; // Sprite class has access to protected members
 
@@ -443,6 +458,11 @@ class TFT_eSPI : public Print { friend class TFT_eSprite; // Sprite class has ac
                    drawFastHLine(int32_t x, int32_t y, int32_t w, uint32_t color),
                    fillRect(int32_t x, int32_t y, int32_t w, int32_t h, uint32_t color);
 
+                   // Draw n horizontal spans in one colour. The spans are sorted by row in place,
+                   // CS stays low for the whole batch and CASET/PASET are only sent when the
+                   // columns or row change (consecutive rows with the same columns need no command)
+  virtual void     drawSpans(tft_span_t *spans, uint32_t n, uint32_t color);
+
   virtual int16_t  drawChar(uint16_t uniCode, int32_t x, int32_t y, uint8_t font),
                    drawChar(uint16_t uniCode, int32_t x, int32_t y),
                    height(void),
@@ -453,6 +473,14 @@ class TFT_eSPI : public Print { friend class TFT_eSprite; // Sprite class has ac
 
   virtual void     setWindow(int32_t xs, int32_t ys, int32_t xe, int32_t ye);   // Note: start + end coordinates
 
+                   // setWindow() remembers the column and row range held by the controller and
+                   // only sends CASET / PASET when it changes. Call after writing commands that
+                   // may change it behind the library's back (writecommand(), panel reset...)
+  void             invalidateWindow(void);
+                   // Bytes (command + 4 parameters) of CASET / PASET sent and skipped by setWindow()
+  void             getWindowStats(uint32_t *sent, uint32_t *saved);
+  void             resetWindowStats(void);
+
                    // Push (aka write pixel) colours to the set window
   virtual void     pushColor(uint16_t color);
 
@@ -622,6 +650,14 @@ class TFT_eSPI : public Print { friend class TFT_eSprite; // Sprite class has ac
            // Render a 16-bit colour image with a 1bpp mask
   void     pushMaskedImage(int32_t x, int32_t y, int32_t w, int32_t h, uint16_t *img, uint8_t *mask);
 
+           // Render a 1bpp mask (MSB first, stride bytes per row, may be in FLASH) as one w x h
+           // block: colour fg where a bit is set, else the image bg (bgStride pixels per row,
+           // may be in FLASH, byte order as pushImage()) or the colour bgColor
+  void     pushMask(int32_t x, int32_t y, int32_t w, int32_t h, const uint8_t *mask, int32_t stride,
+                    uint16_t fg, const uint16_t *bg, int32_t bgStride);
+  void     pushMask(int32_t x, int32_t y, int32_t w, int32_t h, const uint8_t *mask, int32_t stride,
+                    uint16_t fg, uint16_t bgColor);
+
            // This next function has been used successfully to dump the TFT screen to a PC for documentation purposes
            // It reads a screen area and returns the 3 RGB 8-bit colour values of each pixel in the buffer
            // Set w and h to 1 to read 1 pixel's colour. The data buffer must be at least w * h * 3 bytes
@@ -861,6 +897,10 @@ class TFT_eSPI : public Print { friend class TFT_eSprite; // Sprite class has ac
            // Temporary  library development function  TODO: remove need for this
   void     pushSwapBytePixels(const void* data_in, uint32_t len);
 
+           // pushMask() with the image bg, or bgColor if bg is nullptr
+  void     maskBlit(int32_t x, int32_t y, int32_t w, int32_t h, const uint8_t *mask, int32_t stride,
+                    uint16_t fg, const uint16_t *bg, int32_t bgStride, uint16_t bgColor);
+
            // Same as setAddrWindow but exits with CGRAM in read mode
   void     readAddrWindow(int32_t xs, int32_t ys, int32_t w, int32_t h);
 
@@ -910,6 +950,8 @@ class TFT_eSPI : public Print { friend class TFT_eSprite; // Sprite class has ac
   int32_t  _init_width, _init_height; // Display w/h as input, used by setRotation()
   int32_t  _width, _height;           // Display w/h as modified by current rotation
   int32_t  addr_row, addr_col;        // Window position - used to minimise window commands
+  int32_t  win_xs, win_xe, win_ys, win_ye; // Controller window, win_xs < 0 if unknown - used by setWindow()
+  uint32_t win_sent, win_saved;       // setWindow() address bytes sent / skipped
 
   int16_t  _xPivot;   // TFT x pivot point coordinate for rotated Sprites
   int16_t  _yPivot;   // TFT x pivot point coordinate for rotated Sprites
@@ -979,6 +1021,9 @@ class TFT_eSPI : public Print { friend class TFT_eSprite; // Sprite class has ac
   #include "Extensions/Smooth_font.h"  // Loaded if SMOOTH_FONT is defined by user
 #endif
 
+// Load the display list extension
+#include "Extensions/DisplayList.h"
+
 }; // End of class TFT_eSPI
 
 // Swap any type
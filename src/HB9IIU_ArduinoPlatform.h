@@ -0,0 +1,261 @@
+#pragma once
+#include <Arduino.h>
+#include <HTTPClient.h>
+#include <Preferences.h>
+#include <TFT_eSPI.h>
+#include <WiFi.h>
+#include <HB9IIU_Platform.h>
+
+// The core's platform interfaces (lib/HB9IIU_Core) on the ESP32
+
+// ===================== Clock =====================
+class ArduinoClock : public Clock
+{
+public:
+  uint32_t millis() override { return ::millis(); }
+};
+
+// ===================== Display =====================
+// With a buffer, what is drawn between startWrite() and endWrite() is
+// recorded into a TFT_eSPI display list and sent a block at a time: as DMA
+// transactions once tft.initDMA() has been called, so the next block is
+// prepared while the last one streams out. Text is drawn directly.
+//
+// The renderer's bands are lent from `bands` (nBands x BAND_PIXELS, internal
+// RAM) and queued in place: a band is lent again once the SPI interrupt
+// reports its transfer done, so only endWrite() waits for the panel.
+class TftDisplay : public Display
+{
+public:
+  static const int MAX_BANDS = 4;
+  static const uint32_t BAND_WAIT_MS = 20; // longest wait for a band to be sent
+
+  explicit TftDisplay(TFT_eSPI &tft, void *listBuffer = nullptr, uint32_t listBytes = 0,
+                      uint16_t *bands = nullptr, int nBands = 0)
+      : tft_(tft), listBuffer_(listBuffer), listBytes_(listBytes), recording_(false),
+        bands_(bands), nBands_(nBands < MAX_BANDS ? nBands : MAX_BANDS), nextBand_(0),
+        busLock_(nullptr)
+  {
+    for (int i = 0; i < MAX_BANDS; i++)
+      bandBusy_[i] = false;
+  }
+
+  // Held from startWrite() to endWrite() when the bus is shared with
+  // another task (TouchTask)
+  void setBusLock(SemaphoreHandle_t lock) { busLock_ = lock; }
+
+  void startWrite() override
+  {
+    if (busLock_)
+      xSemaphoreTakeRecursive(busLock_, portMAX_DELAY);
+    tft_.startWrite();
+    recording_ = listBuffer_ && tft_.dlBegin(listBuffer_, listBytes_);
+  }
+
+  void endWrite() override
+  {
+    if (recording_)
+      tft_.dlEnd();
+    recording_ = false;
+    tft_.endWrite(); // waits for DMA
+    if (busLock_)
+      xSemaphoreGiveRecursive(busLock_);
+  }
+
+  void pushImage(int32_t x, int32_t y, int32_t w, int32_t h, const uint16_t *data) override
+  {
+    if (!recording_)
+    {
+      tft_.pushImage(x, y, w, h, data);
+      return;
+    }
+
+    // Clipped to the screen like pushImage()
+    int32_t dx = 0, dy = 0, dw = w, dh = h;
+    if (!clip(x, y, dw, dh, dx, dy))
+      return;
+    tft_.dlWindow(x, y, x + dw - 1, y + dh - 1);
+    for (int32_t row = 0; row < dh; row++)
+      tft_.dlPixels(data + (dy + row) * w + dx, dw);
+  }
+
+  void drawFastHLine(int32_t x, int32_t y, int32_t w, uint16_t color) override
+  {
+    if (recording_)
+      recordFill(x, y, w, 1, color);
+    else
+      tft_.drawFastHLine(x, y, w, color);
+  }
+
+  void fillRect(int32_t x, int32_t y, int32_t w, int32_t h, uint16_t color) override
+  {
+    if (recording_)
+      recordFill(x, y, w, h, color);
+    else
+      tft_.fillRect(x, y, w, h, color);
+  }
+
+  void drawRect(int32_t x, int32_t y, int32_t w, int32_t h, uint16_t color) override
+  {
+    if (!recording_)
+    {
+      tft_.drawRect(x, y, w, h, color);
+      return;
+    }
+
+    // Same lines as TFT_eSPI::drawRect()
+    recordFill(x, y, w, 1, color);
+    recordFill(x, y + h - 1, w, 1, color);
+    recordFill(x, y + 1, 1, h - 2, color);
+    recordFill(x + w - 1, y + 1, 1, h - 2, color);
+  }
+
+  uint16_t *bandBuffer() override
+  {
+    if (!recording_ || !nBands_)
+      return nullptr;
+
+    // Transfers complete in order: the next band in turn is the first free.
+    // A band takes well under a millisecond on the wire; if its completion
+    // never arrives, wait for the queue to drain and take the band anyway
+    // rather than hang the render task.
+    const int i = nextBand_;
+    const uint32_t t0 = ::millis();
+    while (bandBusy_[i])
+    {
+      if (::millis() - t0 > BAND_WAIT_MS)
+      {
+        tft_.dmaWait();
+        bandBusy_[i] = false;
+      }
+    }
+    nextBand_ = (i + 1) % nBands_;
+    bandBusy_[i] = true;
+    return bands_ + i * BAND_PIXELS;
+  }
+
+  void pushBand(int32_t x, int32_t y, int32_t w, int32_t h, uint16_t *band) override
+  {
+    const int i = bands_ && band >= bands_ ? (int)((band - bands_) / BAND_PIXELS) : -1;
+    if (i < 0 || i >= nBands_)
+    {
+      pushImage(x, y, w, h, band);
+      return;
+    }
+    if (!recording_)
+    {
+      tft_.pushImage(x, y, w, h, band);
+      bandBusy_[i] = false;
+      return;
+    }
+    tft_.dlWindow(x, y, x + w - 1, y + h - 1);
+    tft_.dlImage(band, (uint32_t)(w * h), bandDone, (void *)&bandBusy_[i]);
+  }
+
+  void drawString(const char *text, int32_t x, int32_t y, uint16_t fg, uint16_t bg) override
+  {
+    // The font renderer writes to the panel itself: send the list first
+    if (recording_)
+    {
+      tft_.dlEnd();
+      tft_.dmaWait();
+    }
+
+    tft_.setTextDatum(TL_DATUM);
+    tft_.setTextColor(fg, bg);
+    tft_.drawString(text, x, y);
+
+    if (recording_)
+      recording_ = tft_.dlBegin(listBuffer_, listBytes_);
+  }
+
+private:
+  // Runs in the SPI interrupt with DMA
+  static void IRAM_ATTR bandDone(void *busy) { *(volatile bool *)busy = false; }
+
+  // Clips x, y, w, h to the screen; dx, dy is the offset into the source
+  bool clip(int32_t &x, int32_t &y, int32_t &w, int32_t &h, int32_t &dx, int32_t &dy)
+  {
+    if (x < 0)
+    {
+      dx = -x;
+      w += x;
+      x = 0;
+    }
+    if (y < 0)
+    {
+      dy = -y;
+      h += y;
+      y = 0;
+    }
+    if (x + w > tft_.width())
+      w = tft_.width() - x;
+    if (y + h > tft_.height())
+      h = tft_.height() - y;
+    return w > 0 && h > 0;
+  }
+
+  void recordFill(int32_t x, int32_t y, int32_t w, int32_t h, uint16_t color)
+  {
+    int32_t dx = 0, dy = 0;
+    if (!clip(x, y, w, h, dx, dy))
+      return;
+    tft_.dlWindow(x, y, x + w - 1, y + h - 1);
+    tft_.dlFill(color, (uint32_t)w * h);
+  }
+
+  TFT_eSPI &tft_;
+  void *listBuffer_;
+  uint32_t listBytes_;
+  bool recording_;
+  uint16_t *bands_;
+  int nBands_;
+  int nextBand_;
+  volatile bool bandBusy_[MAX_BANDS];
+  SemaphoreHandle_t busLock_;
+};
+
+// ===================== Network =====================
+class HttpAircraftFeed : public Network
+{
+public:
+  explicit HttpAircraftFeed(const char *url) : url_(url) {}
+
+  bool connected() override { return WiFi.status() == WL_CONNECTED; }
+
+  int get() override
+  {
+    http_.setTimeout(3500);
+    http_.setReuse(false);
+    http_.begin(url_);
+    return http_.GET();
+  }
+
+  DeserializationError decode(double &now, AircraftSink &sink) override
+  {
+    // WiFiClient goes through lwIP on every read() call: pull the body in blocks
+    DeserializationOption::ReadBuffer rx(rxWindow_);
+    return decodeAircraftJson(*http_.getStreamPtr(), now, [&](const AircraftFields &a)
+                              { sink.onAircraft(a); }, rx);
+  }
+
+  void end() override { http_.end(); }
+
+private:
+  const char *url_;
+  HTTPClient http_;
+  char rxWindow_[1024];
+};
+
+// ===================== Storage =====================
+class PreferencesStorage : public Storage
+{
+public:
+  explicit PreferencesStorage(Preferences &prefs) : prefs_(prefs) {}
+
+  uint8_t getUChar(const char *key, uint8_t defaultValue) override { return prefs_.getUChar(key, defaultValue); }
+  void putUChar(const char *key, uint8_t value) override { prefs_.putUChar(key, value); }
+
+private:
+  Preferences &prefs_;
+};
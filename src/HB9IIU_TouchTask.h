@@ -0,0 +1,110 @@
+#pragma once
+#include <Arduino.h>
+#include <TFT_eSPI.h>
+#include <freertos/queue.h>
+#include <freertos/semphr.h>
+#include <HB9IIU_Touch.h>
+
+// XPT2046 touch on its own task, woken by the PENIRQ line (low while the
+// panel is pressed). Only then does it read the controller: TOUCH_SAMPLES
+// reads per axis, median filtered, every TOUCH_PERIOD_MS until the finger
+// lifts, and the gestures go to a queue for loop(). With no touch it never
+// uses the SPI bus. The bus is shared with the display, so the reads hold
+// the lock TftDisplay holds from startWrite() to endWrite().
+class TouchTask
+{
+public:
+  static const int TOUCH_SAMPLES = 5;
+  static const uint32_t TOUCH_PERIOD_MS = 15;
+  static const uint16_t TOUCH_Z_MIN = 600; // pressure of a finger (getTouch()'s default)
+  static const int QUEUE_EVENTS = 8;
+
+  TouchTask(TFT_eSPI &tft, int irqPin)
+      : tft_(tft), irqPin_(irqPin), busLock_(nullptr), queue_(nullptr), task_(nullptr) {}
+
+  bool begin(SemaphoreHandle_t busLock)
+  {
+    busLock_ = busLock;
+    queue_ = xQueueCreate(QUEUE_EVENTS, sizeof(TouchEvent));
+    if (!queue_ || xTaskCreate(taskMain, "touch", 3072, this, 2, &task_) != pdPASS)
+      return false;
+
+    pinMode(irqPin_, INPUT_PULLUP);
+    attachInterruptArg(digitalPinToInterrupt(irqPin_), onPenDown, this, FALLING);
+    if (digitalRead(irqPin_) == LOW)
+      xTaskNotifyGive(task_); // already pressed
+    return true;
+  }
+
+  // The next gesture, if any; never blocks
+  bool poll(TouchEvent &e) { return queue_ && xQueueReceive(queue_, &e, 0) == pdTRUE; }
+
+private:
+  static void IRAM_ATTR onPenDown(void *self)
+  {
+    BaseType_t woken = pdFALSE;
+    vTaskNotifyGiveFromISR(static_cast<TouchTask *>(self)->task_, &woken);
+    if (woken)
+      portYIELD_FROM_ISR();
+  }
+
+  static void taskMain(void *self) { static_cast<TouchTask *>(self)->run(); }
+
+  void run()
+  {
+    for (;;)
+    {
+      ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+
+      TouchEvent e;
+      int x, y;
+      while (sample(x, y))
+      {
+        if (gestures_.down(millis(), x, y, e))
+          xQueueSend(queue_, &e, 0);
+        vTaskDelay(pdMS_TO_TICKS(TOUCH_PERIOD_MS));
+      }
+      if (gestures_.up(e))
+        xQueueSend(queue_, &e, 0);
+
+      // PENIRQ also pulses during the conversions: drop those wake-ups, but
+      // not a finger that came down since the last sample
+      ulTaskNotifyTake(pdTRUE, 0);
+      if (digitalRead(irqPin_) == LOW)
+        xTaskNotifyGive(task_);
+    }
+  }
+
+  // Filtered screen position; false if the finger is up
+  bool sample(int &x, int &y)
+  {
+    uint16_t xs[TOUCH_SAMPLES], ys[TOUCH_SAMPLES];
+    uint16_t rx = 0, ry = 0;
+
+    xSemaphoreTakeRecursive(busLock_, portMAX_DELAY);
+    bool down = tft_.getTouchRawZ() > TOUCH_Z_MIN;
+    if (down)
+    {
+      for (int i = 0; i < TOUCH_SAMPLES; i++)
+        tft_.getTouchRaw(&xs[i], &ys[i]);
+      rx = touchMedian(xs, TOUCH_SAMPLES);
+      ry = touchMedian(ys, TOUCH_SAMPLES);
+      down = tft_.getTouchRawZ() > TOUCH_Z_MIN; // not lifted during the reads
+    }
+    xSemaphoreGiveRecursive(busLock_);
+
+    if (!down)
+      return false;
+    tft_.convertRawXY(&rx, &ry);
+    x = rx;
+    y = ry;
+    return true;
+  }
+
+  TFT_eSPI &tft_;
+  int irqPin_;
+  SemaphoreHandle_t busLock_;
+  QueueHandle_t queue_;
+  TaskHandle_t task_;
+  TouchGestures gestures_;
+};